@@ -3,7 +3,17 @@
 #include <limits.h>
 #include "flute.h"
 
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
 #include <algorithm>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
 using std::max;
 using std::min;
 using std::pair;
@@ -141,6 +151,160 @@ struct PointComparatorY {
 
 typedef POINT* POINTptr;
 
+// Modified - O(n log n) sorting ----------------------------------------------
+//
+// FLUTE uses selection sort to order points, which takes most of the runtime
+// for large nets. The selection sort is not stable, so a regular sorting
+// algorithm would break ties differently and change FLUTE results. Instead,
+// the functions below compute exactly the same ordering in O(n log n).
+//
+// At each step i, the selection sort picks the first point (in the current
+// ordering) with the minimum key and the point at position i takes its place.
+// Points with the same key do not move while they are being picked since the
+// point at position i is either picked itself or has a larger key. So points
+// with the same key are picked in the order of their positions at the moment
+// the first of them is picked. Therefore, the ordering can be computed by
+// sorting the points by key and then each group of points with the same key
+// by position while tracking the position changes.
+
+// Below this number of points, the original selection sort is used as it is
+// faster for small nets.
+#define FLUTE_SELECTION_SORT_THRESHOLD 32
+
+// From this number of points on, points are sorted using radix sort when the
+// coordinates are integers.
+#define FLUTE_RADIX_SORT_THRESHOLD 128
+
+struct PointComparatorXOnly {
+	bool operator()(const POINT *left, const POINT *right) const {
+		return left->x < right->x;
+	} // end operator
+}; // end struct
+
+struct PointComparatorYOnly {
+	bool operator()(const POINT *left, const POINT *right) const {
+		return left->y < right->y;
+	} // end operator
+}; // end struct
+
+// Maps coordinates to unsigned keys preserving the order.
+typedef std::uint64_t (*RadixKey)(const POINT *p);
+
+static const std::uint64_t RADIX_SIGN_BIT = std::uint64_t(1) << 63;
+
+inline std::uint64_t radixKeyX(const POINT *p) {
+	return ((std::uint64_t) (std::int64_t) p->x) ^ RADIX_SIGN_BIT;
+} // end function
+
+inline std::uint64_t radixKeyY(const POINT *p) {
+	return ((std::uint64_t) (std::int64_t) p->y) ^ RADIX_SIGN_BIT;
+} // end function
+
+inline std::uint64_t radixKeyYDescending(const POINT *p) {
+	return ~radixKeyY(p);
+} // end function
+
+// Stable LSD radix sort (8 bits per pass). Passes in which all points have the
+// same byte are skipped, which is the common case for the upper bytes.
+void radixSortPoints(const int d, POINTptr points[], POINTptr buffer[], RadixKey key) {
+	int count[8][256] = {{0}};
+	for (int i = 0; i < d; i++) {
+		const std::uint64_t k = key(points[i]);
+		for (int b = 0; b < 8; b++) {
+			count[b][(k >> (8 * b)) & 0xFF]++;
+		} // end for
+	} // end for
+
+	POINTptr *src = points;
+	POINTptr *dst = buffer;
+	for (int b = 0; b < 8; b++) {
+		int *bucket = count[b];
+		if (bucket[(key(src[0]) >> (8 * b)) & 0xFF] == d)
+			continue;
+
+		int offset = 0;
+		for (int c = 0; c < 256; c++) {
+			const int n = bucket[c];
+			bucket[c] = offset;
+			offset += n;
+		} // end for
+
+		for (int i = 0; i < d; i++) {
+			dst[bucket[(key(src[i]) >> (8 * b)) & 0xFF]++] = src[i];
+		} // end for
+		std::swap(src, dst);
+	} // end for
+
+	if (src != points) {
+		std::copy(src, src + d, points);
+	} // end if
+} // end function
+
+// Sorts the points by key. If secondary is not null, it is used by radix sort
+// as the tie break of the primary key. The comparator must match the keys.
+template<class Less>
+void sortPointsByKey(const int d, POINTptr points[], POINTptr buffer[],
+		Less less, RadixKey primary, RadixKey secondary) {
+	if (std::is_integral<FLUTE_DTYPE>::value && d >= FLUTE_RADIX_SORT_THRESHOLD) {
+		if (secondary) {
+			radixSortPoints(d, points, buffer, secondary);
+		} // end if
+		radixSortPoints(d, points, buffer, primary);
+	} else {
+		std::sort(points, points + d, less);
+	} // end else
+} // end function
+
+// Reorders ptp[] in the order the points are picked by the selection sort.
+// Requires ptp[i]->o == i. The o field is not changed.
+template<class Less>
+void selectionSortPoints(const int d, POINTptr ptp[], Less less,
+		RadixKey primary, RadixKey secondary) {
+	POINTptr *order = (POINTptr*) malloc(sizeof (POINTptr) * d);
+	POINTptr *buffer = (POINTptr*) malloc(sizeof (POINTptr) * d);
+	int *pos = (int*) malloc(sizeof (int) * d);
+
+	for (int i = 0; i < d; i++) {
+		order[i] = ptp[i];
+		pos[i] = i;
+	} // end for
+
+	sortPointsByKey(d, order, buffer, less, primary, secondary);
+
+	int i = 0;
+	int groupBegin = 0;
+	while (groupBegin < d) {
+		int groupEnd = groupBegin + 1;
+		while (groupEnd < d && !less(order[groupBegin], order[groupEnd])) {
+			groupEnd++;
+		} // end while
+
+		if (groupEnd - groupBegin > 1) {
+			std::sort(order + groupBegin, order + groupEnd,
+					[&](const POINT *left, const POINT *right) {
+				return pos[left->o] < pos[right->o];
+			});
+		} // end if
+
+		for (int k = groupBegin; k < groupEnd; k++) {
+			POINTptr picked = order[k];
+			POINTptr front = ptp[i];
+			const int p = pos[picked->o];
+			ptp[p] = front;
+			pos[front->o] = p;
+			ptp[i] = picked;
+			pos[picked->o] = i;
+			i++;
+		} // end for
+
+		groupBegin = groupEnd;
+	} // end while
+
+	free(order);
+	free(buffer);
+	free(pos);
+} // end function
+
 struct csoln {
 	unsigned char parent;
 	unsigned char seg[12]; // Add: 0..i, Sub: j..11; seg[i+1]=seg[j-1]=0
@@ -150,12 +314,16 @@ struct csoln {
 struct csoln *LUT[FLUTE_D + 1][MGROUP]; // storing 4 .. D
 int numsoln[FLUTE_D + 1][MGROUP];
 
-void readLUT();
+bool readLUT();
+static bool loadLUT();
+static bool mapLUT();
+static bool mapLUT(const std::string &path, const struct LUTSources *sources);
+static bool parseLUT();
 FLUTE_DTYPE flute_wl(int d, FLUTE_DTYPE x[], FLUTE_DTYPE y[], int acc);
 FLUTE_DTYPE flutes_wl_LD(int d, FLUTE_DTYPE xs[], FLUTE_DTYPE ys[], int s[]);
 FLUTE_DTYPE flutes_wl_MD(int d, FLUTE_DTYPE xs[], FLUTE_DTYPE ys[], int s[], int acc);
 FLUTE_DTYPE flutes_wl_RDP(int d, FLUTE_DTYPE xs[], FLUTE_DTYPE ys[], int s[], int acc);
-Tree flute(int d, FLUTE_DTYPE x[], FLUTE_DTYPE y[], int acc, int mapping[]);
+Tree flute(int d, FLUTE_DTYPE x[], FLUTE_DTYPE y[], int acc, int mapping[], SortingAlgorithm sorting);
 Tree flutes_LD(int d, FLUTE_DTYPE xs[], FLUTE_DTYPE ys[], int s[]);
 Tree flutes_MD(int id, int d, FLUTE_DTYPE xs[], FLUTE_DTYPE ys[], int s[], int acc);
 Tree flutes_RDP(int d, FLUTE_DTYPE xs[], FLUTE_DTYPE ys[], int s[], int acc);
@@ -165,11 +333,277 @@ Tree vmergetree(Tree t1, Tree t2);
 FLUTE_DTYPE wirelength(Tree t);
 void printtree(Tree t);
 
-void readLUT() {
-	static bool LUTread = false;
-	if (LUTread) return;
-	LUTread = true;
+// Modified - Look-up table loading ------------------------------------------
+//
+// The tables are loaded only once, even when readLUT() is called concurrently.
+// Errors are reported to the caller (see getLUTError()) instead of exiting.
+// The prebuilt binary file (FLUTE_LUTFILE), generated by writeLUT(), is
+// memory-mapped and used in place without any parsing. If it is not
+// available, the text files (FLUTE_POWVFILE and FLUTE_PORTFILE) are parsed.
+// Files are searched in the directory set by setLUTDirectory(), then in the
+// directory pointed by the FLUTE_LUT_DIR environment variable and finally in
+// the current working directory. The binary file records the size and 
+// modification time of the text files it was generated from and is ignored
+// if the text files that would be parsed instead do not match them.
+
+static const char LUT_MAGIC[8] = {'F', 'L', 'U', 'T', 'E', 'L', 'U', 'T'};
+static const std::int32_t LUT_VERSION = 2;
+
+// Size and modification time of the text files (POWV and PORT). A size of -1
+// means that the file was not found.
+struct LUTSources {
+	std::int64_t size[2];
+	std::int64_t mtime[2];
+}; // end struct
+
+struct LUTHeader {
+	char magic[8];
+	std::int32_t version;
+	std::int32_t maxDegree;
+	std::int32_t solutionSize;
+	std::int32_t numGroups;
+	std::int32_t numSolutions;
+	std::int32_t reserved;
+	LUTSources sources;
+}; // end struct
 
+static std::string lutDirectory;
+static std::string lutSourceDirectory;
+static LUTSources lutSources;
+static std::string lutError;
+static std::mutex lutMutex;
+static bool lutLoaded = false;
+static bool lutMapped = false;
+
+void setLUTDirectory(const char *dir) {
+	lutDirectory = dir ? dir : "";
+} // end function
+
+const char *getLUTSourceDirectory() {
+	return lutSourceDirectory.c_str();
+} // end function
+
+// Returns the paths where a look-up table file is searched, in order.
+static std::vector<std::string> getLUTSearchPaths(const char *filename) {
+	std::vector<std::string> dirs;
+	if (!lutDirectory.empty())
+		dirs.push_back(lutDirectory);
+	const char *env = getenv("FLUTE_LUT_DIR");
+	if (env && *env)
+		dirs.push_back(env);
+	dirs.push_back("");
+
+	std::vector<std::string> paths;
+	for (const std::string &dir : dirs)
+		paths.push_back(dir.empty() ? filename : dir + "/" + filename);
+	return paths;
+} // end function
+
+static FILE *openLUTFile(const char *filename, std::string &path) {
+	for (const std::string &candidate : getLUTSearchPaths(filename)) {
+		FILE *fp = fopen(candidate.c_str(), "rb");
+		if (fp) {
+			path = candidate;
+			return fp;
+		} // end if
+	} // end for
+	path = filename;
+	return NULL;
+} // end function
+
+// Gets the size and modification time of the text files that parseLUT() 
+// would read. Returns false if none of them is found.
+static bool getLUTSources(LUTSources &sources) {
+	const char *filenames[2] = {FLUTE_POWVFILE, FLUTE_PORTFILE};
+	bool found = false;
+	for (int i = 0; i < 2; i++) {
+		sources.size[i] = -1;
+		sources.mtime[i] = 0;
+		for (const std::string &path : getLUTSearchPaths(filenames[i])) {
+			struct stat info;
+			if (stat(path.c_str(), &info) == 0) {
+				sources.size[i] = (std::int64_t) info.st_size;
+				sources.mtime[i] = (std::int64_t) info.st_mtime;
+				found = true;
+				break;
+			} // end if
+		} // end for
+	} // end for
+	return found;
+} // end function
+
+bool readLUT() {
+	std::lock_guard<std::mutex> lock(lutMutex);
+	if (!lutLoaded)
+		lutLoaded = loadLUT();
+	return lutLoaded;
+} // end function
+
+const char *getLUTError() {
+	return lutError.c_str();
+} // end function
+
+bool isLUTMapped() {
+	return lutMapped;
+} // end function
+
+bool loadLUT() {
+	lutError.clear();
+	if (!mapLUT() && !parseLUT())
+		return false;
+
+	// Modified - Guilherme Flach - 21/Ago/2014 --------------------------------
+#if FLUTE_ENABLE_MULTITHREADING
+	// I read in the Internet that std::thread::hardware_concurrency() may 
+	// return zero if it is not supported. So, assumes at least 2 cores.
+	const unsigned int numCores = std::max(2u, std::thread::hardware_concurrency());
+	
+	// Stores a thread for each core. Adds 1 to skip the dummy thread at zero
+	// index.
+	flute_threads.resize(numCores + 1); 
+#endif
+	// -------------------------------------------------------------------------
+
+	return true;
+} // end function
+
+static std::int32_t countLUTGroups() {
+	std::int32_t numGroups = 0;
+	for (int d = 4; d <= FLUTE_D; d++)
+		numGroups += numgrp[d];
+	return numGroups;
+} // end function
+
+// Binary file layout: header, number of solutions of each group, offset (in
+// solutions) of each group and the solutions. Groups are stored for
+// d = 4..FLUTE_D. Groups sharing solutions share the same offset.
+//
+// Each binary file found is tried in the search order. A file is skipped if 
+// it is invalid or if it is stale, i.e. it was generated from text files 
+// other than the ones that would be parsed.
+bool mapLUT() {
+	LUTSources sources;
+	const bool hasSources = getLUTSources(sources);
+	for (const std::string &path : getLUTSearchPaths(FLUTE_LUTFILE)) {
+		if (mapLUT(path, hasSources ? &sources : NULL))
+			return true;
+	} // end for
+	return false;
+} // end function
+
+static bool mapLUT(const std::string &path, const LUTSources *sources) {
+	FILE *fp = fopen(path.c_str(), "rb");
+	if (fp == NULL)
+		return false;
+
+	const int fd = fileno(fp);
+	struct stat info;
+	if (fstat(fd, &info) != 0 || info.st_size < (off_t) sizeof (LUTHeader)) {
+		fclose(fp);
+		return false;
+	} // end if
+
+	const size_t size = (size_t) info.st_size;
+	void *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+	fclose(fp);
+	if (data == MAP_FAILED)
+		return false;
+
+	const LUTHeader *header = (const LUTHeader *) data;
+	const std::int32_t numGroups = countLUTGroups();
+	const size_t expectedSize = sizeof (LUTHeader) +
+			2 * sizeof (std::int32_t) * numGroups +
+			sizeof (struct csoln) * (size_t) std::max(0, header->numSolutions);
+
+	if (memcmp(header->magic, LUT_MAGIC, sizeof (LUT_MAGIC)) != 0 ||
+			header->version != LUT_VERSION ||
+			header->maxDegree != FLUTE_D ||
+			header->solutionSize != (std::int32_t) sizeof (struct csoln) ||
+			header->numGroups != numGroups ||
+			size != expectedSize) {
+		printf("Warning: Ignoring invalid FLUTE look-up table file %s.\n", path.c_str());
+		munmap(data, size);
+		return false;
+	} // end if
+
+	if (sources && memcmp(&header->sources, sources, sizeof (LUTSources)) != 0) {
+		printf("Warning: Ignoring FLUTE look-up table file %s as it is older "
+				"than %s or %s.\n", path.c_str(), FLUTE_POWVFILE, FLUTE_PORTFILE);
+		munmap(data, size);
+		return false;
+	} // end if
+	lutSources = header->sources;
+
+	const std::int32_t *ns = (const std::int32_t *) (header + 1);
+	const std::int32_t *offsets = ns + numGroups;
+	struct csoln *solutions = (struct csoln *) (offsets + numGroups);
+
+	for (int d = 4; d <= FLUTE_D; d++) {
+		for (int k = 0; k < numgrp[d]; k++) {
+			numsoln[d][k] = *(ns++);
+			LUT[d][k] = solutions + *(offsets++);
+		} // end for
+	} // end for
+
+	// The mapping is kept for the lifetime of the process.
+	lutMapped = true;
+	return true;
+} // end function
+
+bool writeLUT(const char *filename) {
+	if (!readLUT())
+		return false;
+
+	const std::int32_t numGroups = countLUTGroups();
+	std::vector<std::int32_t> ns;
+	std::vector<std::int32_t> offsets;
+	std::vector<std::pair<const struct csoln *, std::int32_t>> blocks;
+	std::map<const struct csoln *, std::int32_t> offsetOfBlock;
+	std::int32_t numSolutions = 0;
+
+	ns.reserve(numGroups);
+	offsets.reserve(numGroups);
+	for (int d = 4; d <= FLUTE_D; d++) {
+		for (int k = 0; k < numgrp[d]; k++) {
+			auto it = offsetOfBlock.find(LUT[d][k]);
+			if (it == offsetOfBlock.end()) {
+				it = offsetOfBlock.insert(std::make_pair(LUT[d][k], numSolutions)).first;
+				blocks.push_back(std::make_pair(LUT[d][k], numsoln[d][k]));
+				numSolutions += numsoln[d][k];
+			} // end if
+			ns.push_back(numsoln[d][k]);
+			offsets.push_back(it->second);
+		} // end for
+	} // end for
+
+	FILE *fp = fopen(filename, "wb");
+	if (fp == NULL)
+		return false;
+
+	LUTHeader header;
+	memset(&header, 0, sizeof (LUTHeader));
+	memcpy(header.magic, LUT_MAGIC, sizeof (LUT_MAGIC));
+	header.version = LUT_VERSION;
+	header.maxDegree = FLUTE_D;
+	header.solutionSize = (std::int32_t) sizeof (struct csoln);
+	header.numGroups = numGroups;
+	header.numSolutions = numSolutions;
+	header.sources = lutSources;
+
+	bool success = fwrite(&header, sizeof (LUTHeader), 1, fp) == 1;
+	success = success && fwrite(ns.data(), sizeof (std::int32_t), numGroups, fp) == (size_t) numGroups;
+	success = success && fwrite(offsets.data(), sizeof (std::int32_t), numGroups, fp) == (size_t) numGroups;
+
+	// Blocks are written in the order their offsets were assigned.
+	for (const auto &block : blocks) {
+		success = success && fwrite(block.first, sizeof (struct csoln), block.second, fp) == (size_t) block.second;
+	} // end for
+
+	success = (fclose(fp) == 0) && success;
+	return success;
+} // end function
+
+bool parseLUT() {
 	FILE *fpwv, *fprt;
 	struct csoln *p;
 	int d, i, j, k, kk, ns, nn, ne;
@@ -189,37 +623,61 @@ void readLUT() {
 		mod16[i] = i % 16;
 	}
 
-	fpwv = fopen(FLUTE_POWVFILE, "r");
+	// Record the text files being parsed, so that a binary file written from
+	// these tables can be checked against them.
+	getLUTSources(lutSources);
+
+	std::string path;
+	fpwv = openLUTFile(FLUTE_POWVFILE, path);
 	if (fpwv == NULL) {
-		printf("Error in opening %s\n", FLUTE_POWVFILE);
-		printf("Please make sure %s and %s\n"
-				"are in the current working directory.\n", FLUTE_POWVFILE, FLUTE_PORTFILE);
-		exit(1);
+		lutError = "Error in opening " + path + ". Please make sure " +
+				FLUTE_LUTFILE + " (or " + FLUTE_POWVFILE + " and " +
+				FLUTE_PORTFILE + ") are in the current working directory or "
+				"in FLUTE_LUT_DIR.";
+		return false;
 	}
+	const std::string powvPath = path;
 
 #if FLUTE_FLUTEROUTING==1    
-	fprt = fopen(FLUTE_PORTFILE, "r");
+	fprt = openLUTFile(FLUTE_PORTFILE, path);
 	if (fprt == NULL) {
-		printf("Error in opening %s\n", FLUTE_PORTFILE);
-		printf("Please make sure %s and %s\n(found in the Flute directory of UMpack)\n"
-				"are in the current working directory.\n", FLUTE_POWVFILE, FLUTE_PORTFILE);
-		exit(1);
+		lutError = "Error in opening " + path + ". Please make sure " +
+				FLUTE_LUTFILE + " (or " + FLUTE_POWVFILE + " and " +
+				FLUTE_PORTFILE + ", found in the Flute directory of UMpack) "
+				"are in the current working directory or in FLUTE_LUT_DIR.";
+		fclose(fpwv);
+		return false;
 	}
 #endif
 
-	for (d = 4; d <= FLUTE_D; d++) {
+	bool success = true;
+
+	for (d = 4; success && d <= FLUTE_D; d++) {
 		for (i = 0; i <= 255; i++) {
 			divd[i] = i / d;
 			modd[i] = i % d;
 		}
 		dsq = d*d;
 
-		fscanf(fpwv, "d=%d\n", &d);
+		// Modified - Checks that the files have the expected degree sections.
+		int degree = -1;
+		if (fscanf(fpwv, "d=%d\n", &degree) != 1 || degree != d) {
+			success = false;
+			break;
+		}
 #if FLUTE_FLUTEROUTING==1    
-		fscanf(fprt, "d=%d\n", &d);
+		if (fscanf(fprt, "d=%d\n", &degree) != 1 || degree != d) {
+			success = false;
+			break;
+		}
 #endif
-		for (k = 0; k < numgrp[d]; k++) {
-			ns = (int) charnum[fgetc(fpwv)];
+		for (k = 0; success && k < numgrp[d]; k++) {
+			const int ch = fgetc(fpwv);
+			if (ch == EOF) {
+				success = false;
+				break;
+			}
+			ns = (int) charnum[ch];
 
 			if (ns == 0) { // same as some previous group
 				fscanf(fpwv, "%d\n", &kk);
@@ -232,6 +690,10 @@ void readLUT() {
 				LUT[d][k] = p;
 				for (i = 1; i <= ns; i++) {
 					linep = (unsigned char*) fgets((char*) line, 99, fpwv);
+					if (linep == NULL) {
+						success = false;
+						break;
+					}
 					p->parent = charnum[*(linep++)];
 					j = 0;
 					while ((p->seg[j++] = charnum[*(linep++)]) != 0);
@@ -240,7 +702,10 @@ void readLUT() {
 #if FLUTE_FLUTEROUTING==1    
 					nn = 2 * d - 2;
 					ne = 2 * d - 3;
-					fread(line, 1, d - 2, fprt);
+					if (fread(line, 1, d - 2, fprt) != (size_t) (d - 2)) {
+						success = false;
+						break;
+					}
 					linep = line;
 					for (j = d; j < nn; j++) {
 						c = *(linep++);
@@ -253,7 +718,10 @@ void readLUT() {
 						p->col[j - d] = modd[c];
 						p->neighbor[j] = j; // initialized
 					}
-					fread(line, 1, ne + 1, fprt);
+					if (fread(line, 1, ne + 1, fprt) != (size_t) (ne + 1)) {
+						success = false;
+						break;
+					}
 					linep = line; // last char = \n
 					for (j = 0; j < ne; j++) {
 						c = *(linep++);
@@ -265,18 +733,21 @@ void readLUT() {
 			}
 		}
 	}
-	
-	// Modified - Guilherme Flach - 21/Ago/2014 --------------------------------
-#if FLUTE_ENABLE_MULTITHREADING
-	// I read in the Internet that std::thread::hardware_concurrency() may 
-	// return zero if it is not supported. So, assumes at least 2 cores.
-	const unsigned int numCores = std::max(2u, std::thread::hardware_concurrency());
-	
-	// Stores a thread for each core. Adds 1 to skip the dummy thread at zero
-	// index.
-	flute_threads.resize(numCores + 1); 
+
+	fclose(fpwv);
+#if FLUTE_FLUTEROUTING==1
+	fclose(fprt);
 #endif
-	// -------------------------------------------------------------------------
+
+	if (!success) {
+		lutError = std::string("Invalid FLUTE look-up table files (") +
+				FLUTE_POWVFILE + ", " + FLUTE_PORTFILE + ").";
+	} else {
+		const size_t separator = powvPath.rfind('/');
+		lutSourceDirectory = separator == std::string::npos ?
+				"." : powvPath.substr(0, separator);
+	}
+	return success;
 }
 
 FLUTE_DTYPE flute_wl(int d, FLUTE_DTYPE x[], FLUTE_DTYPE y[], int acc) {
@@ -321,21 +792,26 @@ FLUTE_DTYPE flute_wl(int d, FLUTE_DTYPE x[], FLUTE_DTYPE y[], int acc) {
 			pt[i].x = x[i];
 			pt[i].y = y[i];
 			ptp[i] = &pt[i];
+			ptp[i]->o = i;
 		}
 
 		// sort x
-		for (i = 0; i < d - 1; i++) {
-			minval = ptp[i]->x;
-			minidx = i;
-			for (j = i + 1; j < d; j++) {
-				if (minval > ptp[j]->x) {
-					minval = ptp[j]->x;
-					minidx = j;
+		if (d < FLUTE_SELECTION_SORT_THRESHOLD) {
+			for (i = 0; i < d - 1; i++) {
+				minval = ptp[i]->x;
+				minidx = i;
+				for (j = i + 1; j < d; j++) {
+					if (minval > ptp[j]->x) {
+						minval = ptp[j]->x;
+						minidx = j;
+					}
 				}
+				tmpp = ptp[i];
+				ptp[i] = ptp[minidx];
+				ptp[minidx] = tmpp;
 			}
-			tmpp = ptp[i];
-			ptp[i] = ptp[minidx];
-			ptp[minidx] = tmpp;
+		} else {
+			selectionSortPoints(d, ptp, PointComparatorXOnly(), radixKeyX, nullptr);
 		}
 
 #if FLUTE_REMOVE_DUPLICATE_PIN==1
@@ -358,21 +834,29 @@ FLUTE_DTYPE flute_wl(int d, FLUTE_DTYPE x[], FLUTE_DTYPE y[], int acc) {
 		}
 
 		// sort y to find s[]
-		for (i = 0; i < d - 1; i++) {
-			minval = ptp[i]->y;
-			minidx = i;
-			for (j = i + 1; j < d; j++) {
-				if (minval > ptp[j]->y) {
-					minval = ptp[j]->y;
-					minidx = j;
+		if (d < FLUTE_SELECTION_SORT_THRESHOLD) {
+			for (i = 0; i < d - 1; i++) {
+				minval = ptp[i]->y;
+				minidx = i;
+				for (j = i + 1; j < d; j++) {
+					if (minval > ptp[j]->y) {
+						minval = ptp[j]->y;
+						minidx = j;
+					}
 				}
+				ys[i] = ptp[minidx]->y;
+				s[i] = ptp[minidx]->o;
+				ptp[minidx] = ptp[i];
+			}
+			ys[d - 1] = ptp[d - 1]->y;
+			s[d - 1] = ptp[d - 1]->o;
+		} else {
+			selectionSortPoints(d, ptp, PointComparatorYOnly(), radixKeyY, nullptr);
+			for (i = 0; i < d; i++) {
+				ys[i] = ptp[i]->y;
+				s[i] = ptp[i]->o;
 			}
-			ys[i] = ptp[minidx]->y;
-			s[i] = ptp[minidx]->o;
-			ptp[minidx] = ptp[i];
 		}
-		ys[d - 1] = ptp[d - 1]->y;
-		s[d - 1] = ptp[d - 1]->o;
 
 		l = flutes_wl(d, xs, ys, s, acc);
 	}
@@ -767,7 +1251,7 @@ FLUTE_DTYPE flutes_wl_MD(int d, FLUTE_DTYPE xs[], FLUTE_DTYPE ys[], int s[], int
 // indexes and the tree node indexes.
 // mapping[original point index] -> tree point index
 
-Tree flute(int d, FLUTE_DTYPE x[], FLUTE_DTYPE y[], int acc, int mapping[]) {
+Tree flute(int d, FLUTE_DTYPE x[], FLUTE_DTYPE y[], int acc, int mapping[], SortingAlgorithm sorting) {
 	unsigned allocateSize = FLUTE_MAXD;
 	if (d > FLUTE_MAXD) {
 		allocateSize = d + 1;
@@ -807,26 +1291,33 @@ Tree flute(int d, FLUTE_DTYPE x[], FLUTE_DTYPE y[], int acc, int mapping[]) {
 			ptp[i]->o = i; // [NOTE] Added - Guilherme Flach - 17/Jun/2014
 		}
 
+		const bool legacy = sorting == FLUTE_SORT_LEGACY ||
+				d < FLUTE_SELECTION_SORT_THRESHOLD;
+
 		// sort x
 #if FLUTE_FAST_SORT_X		
 		if (d < FLUTE_SORTING_THRESHOLD) {
 #endif
-			for (i = 0; i < d - 1; i++) {
-				minval = ptp[i]->x;
-				minidx = i;
-				for (j = i + 1; j < d; j++) {
-					// Modified - Guilherme Flach - 28/Jul/2014
-					// Using y as tie break so that FLUTE result becomes independent of 
-					// input point ordering for large degree nets where it is heuristic.
-					if (minval > ptp[j]->x || (minval == ptp[j]->x && ptp[minidx]->y < ptp[j]->y)) {
-						minval = ptp[j]->x;
-						minidx = j;
+			if (!legacy) {
+				selectionSortPoints(d, ptp, PointComparatorX(), radixKeyX, radixKeyYDescending);
+			} else {
+				for (i = 0; i < d - 1; i++) {
+					minval = ptp[i]->x;
+					minidx = i;
+					for (j = i + 1; j < d; j++) {
+						// Modified - Guilherme Flach - 28/Jul/2014
+						// Using y as tie break so that FLUTE result becomes independent of 
+						// input point ordering for large degree nets where it is heuristic.
+						if (minval > ptp[j]->x || (minval == ptp[j]->x && ptp[minidx]->y < ptp[j]->y)) {
+							minval = ptp[j]->x;
+							minidx = j;
+						}
 					}
+					tmpp = ptp[i];
+					ptp[i] = ptp[minidx];
+					ptp[minidx] = tmpp;
 				}
-				tmpp = ptp[i];
-				ptp[i] = ptp[minidx];
-				ptp[minidx] = tmpp;
-			}
+			} // end else
 #if FLUTE_FAST_SORT_X			
 		} else {
 			std::sort(ptp, ptp + d, PointComparatorX());
@@ -857,21 +1348,29 @@ Tree flute(int d, FLUTE_DTYPE x[], FLUTE_DTYPE y[], int acc, int mapping[]) {
 #if FLUTE_FAST_SORT_Y		
 		if (d < FLUTE_SORTING_THRESHOLD) {
 #endif		
-			for (i = 0; i < d - 1; i++) {
-				minval = ptp[i]->y;
-				minidx = i;
-				for (j = i + 1; j < d; j++) {
-					if (minval > ptp[j]->y) {
-						minval = ptp[j]->y;
-						minidx = j;
+			if (!legacy) {
+				selectionSortPoints(d, ptp, PointComparatorYOnly(), radixKeyY, nullptr);
+				for (i = 0; i < d; i++) {
+					ys[i] = ptp[i]->y;
+					s[i] = ptp[i]->o;
+				}
+			} else {
+				for (i = 0; i < d - 1; i++) {
+					minval = ptp[i]->y;
+					minidx = i;
+					for (j = i + 1; j < d; j++) {
+						if (minval > ptp[j]->y) {
+							minval = ptp[j]->y;
+							minidx = j;
+						}
 					}
+					ys[i] = ptp[minidx]->y;
+					s[i] = ptp[minidx]->o;
+					ptp[minidx] = ptp[i];
 				}
-				ys[i] = ptp[minidx]->y;
-				s[i] = ptp[minidx]->o;
-				ptp[minidx] = ptp[i];
-			}
-			ys[d - 1] = ptp[d - 1]->y;
-			s[d - 1] = ptp[d - 1]->o;
+				ys[d - 1] = ptp[d - 1]->y;
+				s[d - 1] = ptp[d - 1]->o;
+			} // end else
 #if FLUTE_FAST_SORT_Y			
 		} else {
 			// Enabling this makes Flute to be faster, but the results differ
@@ -13,6 +13,7 @@ using namespace std;
 
 #define FLUTE_POWVFILE "POWV9.dat"    // LUT for POWV (Wirelength Vector)
 #define FLUTE_PORTFILE "PORT9.dat"    // LUT for PORT (Routing Tree)
+#define FLUTE_LUTFILE "FLUTE9.lut"    // Prebuilt binary LUT (POWV + PORT)
 #define FLUTE_D 9        // LUT is used for d <= D, D <= 9
 #define FLUTE_FLUTEROUTING 1   // 1 to construct routing, 0 to estimate WL only
 #define FLUTE_REMOVE_DUPLICATE_PIN 0  // Remove dup. pin for flute_wl() & flute()
@@ -39,11 +40,42 @@ typedef struct
 } Tree;
 
 
+// Point sorting used by flute(). Both algorithms produce the same results,
+// the legacy one (selection sort, O(n^2)) is kept for reference.
+enum SortingAlgorithm {
+	FLUTE_SORT_DEFAULT,
+	FLUTE_SORT_LEGACY
+}; // end enum
+
 // Major functions
-extern void readLUT();
+
+// readLUT() must be called, and succeed, before flute() and flute_wl(). It is
+// thread-safe and loads the tables only once. It returns false if the tables
+// could not be loaded, in which case getLUTError() describes the problem and
+// a later call tries again. After the tables are loaded, flute() and
+// flute_wl() are reentrant and can be called concurrently.
+extern bool readLUT();
+extern const char *getLUTError();
+
+// Returns true if the tables were loaded from the binary file (FLUTE_LUTFILE)
+// rather than parsed from the text files.
+extern bool isLUTMapped();
+
+// Sets the directory where the tables are searched first. Must be called
+// before the tables are loaded.
+extern void setLUTDirectory(const char *dir);
+
+// Returns the directory from which the text files were parsed, or an empty
+// string if the tables were loaded from the binary file.
+extern const char *getLUTSourceDirectory();
+
+// Writes the loaded tables to a binary file (FLUTE_LUTFILE), which is
+// memory-mapped instead of parsing the text files in later runs. The file is
+// ignored if the text files it was generated from change.
+extern bool writeLUT(const char *filename);
 extern FLUTE_DTYPE flute_wl(int d, FLUTE_DTYPE x[], FLUTE_DTYPE y[], int acc);
 //Macro: DTYPE flutes_wl(int d, DTYPE xs[], DTYPE ys[], int s[], int acc);
-extern Tree flute(int d, FLUTE_DTYPE x[], FLUTE_DTYPE y[], int acc, int mapping[]);
+extern Tree flute(int d, FLUTE_DTYPE x[], FLUTE_DTYPE y[], int acc, int mapping[], SortingAlgorithm sorting = FLUTE_SORT_DEFAULT);
 //Macro: Tree flutes(int d, DTYPE xs[], DTYPE ys[], int s[], int acc);
 extern FLUTE_DTYPE wirelength(Tree t);
 extern void printtree(Tree t);
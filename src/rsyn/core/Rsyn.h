@@ -23,6 +23,7 @@
 #include <list>
 #include <queue>
 #include <vector>
+#include <tuple>
 #include <bitset>
 #include <memory>
 #include <string>
@@ -84,6 +85,8 @@ class AttributeInitializer;
 template<typename DefaultValueType> class AttributeInitializerWithDefaultValue;
 
 class Observer;
+class NetlistSnapshot;
+class DesignChangeSet;
 
 template<class Object, class Reference, unsigned int CHUNK_SIZE> class GenericListCollection;
 template<class Reference, unsigned int CHUNK_SIZE> class GenericReferenceListCollection;
@@ -259,6 +262,7 @@ enum EventType {
 	EVENT_POST_CELL_REMAP,
 	EVENT_POST_PIN_CONNECT,
 	EVENT_PRE_PIN_DISCONNECT,
+	EVENT_POST_DESIGN_EDIT,
 
 	NUM_EVENTS
 }; // end enum
@@ -361,6 +365,9 @@ public:
 #include "rsyn/core/obj/decl/LibraryModule.h"
 #include "rsyn/core/obj/decl/Design.h"
 
+// Edit Transactions
+#include "rsyn/core/infra/DesignChangeSet.h"
+
 // Object's Data
 #include "rsyn/core/obj/data/Object.h"
 #include "rsyn/core/obj/data/Net.h"
@@ -379,6 +386,7 @@ public:
 // Infra
 #include "rsyn/core/infra/Attribute.h"
 #include "rsyn/core/infra/Observer.h"
+#include "rsyn/core/infra/NetlistSnapshot.h"
 
 // Object's Implementations
 #include "rsyn/core/obj/impl/Object.h"
@@ -16,7 +16,10 @@
 #ifndef RSYN_ATTRIBUTE_H
 #define RSYN_ATTRIBUTE_H
 
-#include <deque>
+#include <vector>
+#include <memory>
+#include <new>
+#include <type_traits>
 
 namespace Rsyn {
 
@@ -70,24 +73,70 @@ public:
 
 // -----------------------------------------------------------------------------
 
-template<typename _Object, typename _ObjectReference, typename _ObjectExtension>
+template<typename _Object, typename _ObjectReference, typename _ObjectExtension, 
+	typename _List = List<_Object>>
 class AttributeBase {
 private:
 	// [TODO] Make design and list const.
 	
 	Design clsDesign;
-	List<_Object> *clsListPtr;
+	_List *clsListPtr;
 	_ObjectExtension clsDefaultValue;
 	
-	typename List<_Object>::CreateElementCallbackHandler clsHandlerOnCreate;
-	typename List<_Object>::DestructorCallbackHandler clsListDestructorCallbackHandler;
+	typename _List::CreateElementCallbackHandler clsHandlerOnCreate;
+	typename _List::DestructorCallbackHandler clsListDestructorCallbackHandler;
 	
-	std::deque<_ObjectExtension> clsData;
+	// Data is stored in fixed-size chunks matching the chunks of the list
+	// storing the objects, so that the i-th attribute chunk holds the
+	// extensions of the objects in the i-th list chunk. Chunks are never 
+	// reallocated, so references to extensions remain valid as the attribute
+	// grows (as with the former std::deque storage). Chunks are allocated 
+	// uninitialized and extensions are copy constructed from the default 
+	// value only up to the largest id in the list.
+	static const unsigned int CHUNK_SIZE = _List::CHUNK_SIZE;
+	
+	typedef typename std::aligned_storage<sizeof(_ObjectExtension), 
+		alignof(_ObjectExtension)>::type Slot;
+	
+	std::vector<std::unique_ptr<Slot[]>> clsChunks;
+	Index clsNumSlots = 0; // number of constructed extensions
+	
+	_ObjectExtension *getSlot(const Index id) const {
+		return reinterpret_cast<_ObjectExtension *>(
+				&clsChunks[id / CHUNK_SIZE][id % CHUNK_SIZE]);
+	} // end method
+	
+	void addChunk() {
+		clsChunks.push_back(std::unique_ptr<Slot[]>(new Slot[CHUNK_SIZE]));
+	} // end method
 	
 	void accommodate(const Index index) {
-		if (index >= clsData.size()) {
-			clsData.resize(index + 1, clsDefaultValue);
-		} // end if
+		while (clsNumSlots <= index) {
+			if (clsNumSlots == getCapacity()) {
+				addChunk();
+			} // end if
+			new (getSlot(clsNumSlots)) _ObjectExtension(clsDefaultValue);
+			clsNumSlots++;
+		} // end while
+	} // end method
+	
+	void copySlots(const AttributeBase<_Object, _ObjectReference, _ObjectExtension, _List> &other) {
+		clsChunks.reserve(other.clsChunks.size());
+		while (clsChunks.size() < other.clsChunks.size()) {
+			addChunk();
+		} // end while
+		for (; clsNumSlots < other.clsNumSlots; clsNumSlots++) {
+			new (getSlot(clsNumSlots)) _ObjectExtension(*other.getSlot(clsNumSlots));
+		} // end for
+	} // end method
+	
+	void clearSlots() {
+		for (Index i = 0; i < clsNumSlots; i++) {
+			getSlot(i)->~_ObjectExtension();
+		} // end for
+		clsNumSlots = 0;
+		clsChunks.clear();
+		clsChunks.shrink_to_fit();
 	} // end method
 	
 protected:
@@ -103,7 +152,7 @@ protected:
 		
 	} // end method
 	
-	void load(Design design, List<_Object> &list, _ObjectExtension defaultValue = _ObjectExtension()) {
+	void load(Design design, _List &list, _ObjectExtension defaultValue = _ObjectExtension()) {
 		clsDesign = design;
 		clsListPtr = &list;
 		clsDefaultValue = defaultValue;
@@ -116,21 +165,23 @@ public:
 	AttributeBase() : clsDesign(nullptr), clsListPtr(nullptr) {
 	} // end constructor
 	
-	AttributeBase(const AttributeBase<_Object, _ObjectReference, _ObjectExtension> &other) {
+	AttributeBase(const AttributeBase<_Object, _ObjectReference, _ObjectExtension, _List> &other) 
+		: clsDesign(nullptr), clsListPtr(nullptr) {
 		operator=(other);
 	} // end constructor
 	
-	AttributeBase(Design design, List<_Object> &list) {
+	AttributeBase(Design design, _List &list) {
 		load(design, list);
 	} // end constructor
 
-	AttributeBase<_Object, _ObjectReference, _ObjectExtension> &
-	operator=(const AttributeBase<_Object, _ObjectReference, _ObjectExtension> &other) {
+	AttributeBase<_Object, _ObjectReference, _ObjectExtension, _List> &
+	operator=(const AttributeBase<_Object, _ObjectReference, _ObjectExtension, _List> &other) {
 		unload();
 		
 		clsDesign = other.clsDesign;
 		clsListPtr = other.clsListPtr;
-		clsData = other.clsData;
+		clsDefaultValue = other.clsDefaultValue;
+		copySlots(other);
 						
 		// When a layer gets copied, we need to setup new callbacks.
 		setupCallbacks();
@@ -153,12 +204,32 @@ public:
 			clsListPtr = nullptr;
 		} // end if
 
-		clsData.clear();
-		clsData.shrink_to_fit();
+		clearSlots();
 	} // end method	
 
-	inline _ObjectExtension &operator[](_ObjectReference obj) { return clsData[clsDesign.getId(obj)]; }
-	inline const _ObjectExtension &operator[](_ObjectReference obj) const { return clsData[clsDesign.getId(obj)]; }
+	//! @brief Pre-allocates storage for objects with id smaller than 
+	//!        numObjects. Useful before creating many objects at once.
+	void reserve(const Index numObjects) {
+		while (getCapacity() < numObjects) {
+			addChunk();
+		} // end while
+	} // end method
+	
+	//! @brief Returns the number of objects that can be stored without
+	//!        allocating more memory.
+	Index getCapacity() const { return (Index) (clsChunks.size() * CHUNK_SIZE); }
+
+	//! @brief Returns the number of objects with an extension, that is, ids
+	//!        of the objects in the list are smaller than this value.
+	Index getNumObjects() const { return clsNumSlots; }
+
+	inline _ObjectExtension &operator[](_ObjectReference obj) { 
+		return *getSlot(clsDesign.getId(obj));
+	} // end method
+	
+	inline const _ObjectExtension &operator[](_ObjectReference obj) const { 
+		return *getSlot(clsDesign.getId(obj));
+	} // end method
 
 }; // end class	
 
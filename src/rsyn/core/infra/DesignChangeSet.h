@@ -0,0 +1,88 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_DESIGN_CHANGE_SET_H
+#define RSYN_DESIGN_CHANGE_SET_H
+
+namespace Rsyn {
+
+// Summary of the netlist changes performed inside an edit transaction (see
+// Design::beginEdit()). Each object appears at most once, in the order it was
+// first touched.
+
+class DesignChangeSet {
+public:
+	// Instances created during the transaction.
+	std::vector<Instance> createdInstances;
+
+	// Nets created during the transaction.
+	std::vector<Net> createdNets;
+
+	// Pins that were connected and/or disconnected. Use Pin::getNet() to get
+	// the net the pin ended up connected to, if any.
+	std::vector<Pin> reconnectedPins;
+
+	// Nets that gained or lost pins (including the nets that pins were
+	// disconnected from).
+	std::vector<Net> modifiedNets;
+
+	// Remapped cells and the library cell they had when they were first
+	// remapped in the transaction.
+	std::vector<std::tuple<Cell, LibraryCell>> remappedCells;
+
+	bool empty() const {
+		return createdInstances.empty() && createdNets.empty() &&
+				reconnectedPins.empty() && modifiedNets.empty() &&
+				remappedCells.empty();
+	} // end method
+
+	void clear() {
+		createdInstances.clear();
+		createdNets.clear();
+		reconnectedPins.clear();
+		modifiedNets.clear();
+		remappedCells.clear();
+	} // end method
+}; // end struct
+
+// -----------------------------------------------------------------------------
+
+// Opens an edit transaction on construction and commits it on destruction.
+//
+//     {
+//         Rsyn::DesignEditGuard edit(design);
+//         ... (many connectPin(), remap(), etc.)
+//     } // topological ordering repaired and observers notified once here
+
+class DesignEditGuard {
+public:
+	DesignEditGuard(Design design) : clsDesign(design) {
+		clsDesign.beginEdit();
+	} // end constructor
+
+	~DesignEditGuard() {
+		clsDesign.commitEdit();
+	} // end destructor
+
+	DesignEditGuard(const DesignEditGuard &) = delete;
+	DesignEditGuard &operator=(const DesignEditGuard &) = delete;
+
+private:
+	Design clsDesign;
+}; // end class
+
+} // end namespace
+
+#endif
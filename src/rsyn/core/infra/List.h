@@ -17,12 +17,20 @@
 #define RSYN_LIST_H
 
 #include <cmath>
-#include <deque>
+#include <cstddef>
+#include <cstdlib>
 #include <list>
+#include <new>
 #include <vector>
+#include <utility>
+#include <algorithm>
 #include <functional>
 #include <iostream>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
 namespace Rsyn {
 
 template<typename T> 
@@ -81,6 +89,147 @@ struct Chunk {
 
 //--------------------------------------------------------------------------
 
+// Memory for the chunks of a list. Chunks are carved out of large blocks
+// (slabs) instead of being allocated one by one. Slabs grow geometrically, so
+// small lists stay small, and reserving n elements allocates a single slab
+// with exactly the missing chunks. Memory is only released when the arena is
+// destroyed.
+//
+// Optionally, large slabs are backed by transparent huge pages (Linux only),
+// which reduces TLB misses when traversing large netlists. Huge pages are
+// disabled by default since they may increase the memory footprint.
+
+class ListArena {
+public:
+
+	ListArena() : clsCurrent(nullptr), clsRemaining(0), 
+			clsNextSlabSize(MIN_SLAB_SIZE) {
+	} // end constructor
+
+	~ListArena() {
+		for (const Slab &slab : clsSlabs) {
+			freeSlab(slab);
+		} // end for
+	} // end destructor
+
+	ListArena(const ListArena &) = delete;
+	ListArena &operator=(const ListArena &) = delete;
+
+	// Returns memory for an object of the given size.
+	void *allocate(const std::size_t size) {
+		const std::size_t alignedSize = align(size);
+		if (alignedSize > clsRemaining) {
+			createSlab(std::max(alignedSize, clsNextSlabSize));
+			clsNextSlabSize = std::min(2 * clsNextSlabSize, MAX_SLAB_SIZE);
+		} // end if
+
+		void *ptr = clsCurrent;
+		clsCurrent += alignedSize;
+		clsRemaining -= alignedSize;
+		return ptr;
+	} // end method
+
+	// Makes sure that the next allocations summing up to size bytes are served
+	// from a single slab.
+	void reserve(const std::size_t size) {
+		const std::size_t alignedSize = align(size);
+		if (alignedSize > clsRemaining) {
+			createSlab(alignedSize);
+		} // end if
+	} // end method
+
+	// Returns the number of bytes allocated from the system.
+	std::size_t getMemoryUsage() const {
+		std::size_t memoryUsage = 0;
+		for (const Slab &slab : clsSlabs) {
+			memoryUsage += slab.propSize;
+		} // end for
+		return memoryUsage;
+	} // end method
+
+	// Enables or disables huge pages for the slabs allocated from now on by
+	// any arena.
+	static void setHugePagesEnabled(const bool enabled) {
+		hugePagesEnabled() = enabled;
+	} // end method
+
+	static bool isHugePagesEnabled() {
+		return hugePagesEnabled();
+	} // end method
+
+private:
+
+	static const std::size_t ALIGNMENT = alignof(std::max_align_t);
+	static const std::size_t MIN_SLAB_SIZE = 64 * 1024;
+	static const std::size_t MAX_SLAB_SIZE = 64 * 1024 * 1024;
+	static const std::size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+	struct Slab {
+		char *propData;
+		std::size_t propSize;
+		bool propMapped;
+	}; // end struct
+
+	std::vector<Slab> clsSlabs;
+	char *clsCurrent;
+	std::size_t clsRemaining;
+	std::size_t clsNextSlabSize;
+
+	static bool &hugePagesEnabled() {
+		static bool enabled = false;
+		return enabled;
+	} // end method
+
+	static std::size_t align(const std::size_t size) {
+		return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	} // end method
+
+	void createSlab(std::size_t size) {
+		Slab slab;
+		slab.propData = nullptr;
+		slab.propMapped = false;
+
+#ifdef __linux__
+		if (isHugePagesEnabled() && size >= HUGE_PAGE_SIZE) {
+			size = (size + HUGE_PAGE_SIZE - 1) & ~(HUGE_PAGE_SIZE - 1);
+			void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+					MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (ptr != MAP_FAILED) {
+				// The advice is just a hint, so failures are ignored.
+				madvise(ptr, size, MADV_HUGEPAGE);
+				slab.propData = static_cast<char *>(ptr);
+				slab.propMapped = true;
+			} // end if
+		} // end if
+#endif
+
+		if (!slab.propData) {
+			slab.propData = static_cast<char *>(std::malloc(size));
+			if (!slab.propData) {
+				throw std::bad_alloc();
+			} // end if
+		} // end if
+
+		slab.propSize = size;
+		clsSlabs.push_back(slab);
+
+		clsCurrent = slab.propData;
+		clsRemaining = size;
+	} // end method
+
+	static void freeSlab(const Slab &slab) {
+#ifdef __linux__
+		if (slab.propMapped) {
+			munmap(slab.propData, slab.propSize);
+			return;
+		} // end if
+#endif
+		std::free(slab.propData);
+	} // end method
+}; // end class
+
+//--------------------------------------------------------------------------
+
 //
 // DEFAULT CHUNCK SIZE
 // 
@@ -102,6 +251,8 @@ struct Chunk {
 template<typename T, unsigned int DEFAULT_CHUNK_SIZE = 1000>
 class List {
 public:	
+	static const unsigned int CHUNK_SIZE = DEFAULT_CHUNK_SIZE;
+	
 	
 	typedef std::function<void(const int index)> CreateElementCallback;
 	typedef std::function<void(const int index)> RemoveElementCallback;
@@ -112,17 +263,16 @@ public:
 	typedef std::list<DestructorCallback>::iterator DestructorCallbackHandler;
 	
 private:	
-	// Iterator validity (std::deque)
-	// ------------------------------
-	// In case the container shrinks, all iterators, pointers and references to 
-	// elements that have not been removed remain valid after the resize and refer
-	// to the same elements they were referring to before the call.
-	// If the container expands, all iterators are invalidated, but existing
-	// pointers and references remain valid, referring to the same elements they 
-	// were referring to before.
+	// Pointer validity
+	// ----------------
+	// Chunks are allocated from the arena and never move, so pointers and
+	// references to elements remain valid as the list grows.
 	
-	std::deque<Chunk<T, DEFAULT_CHUNK_SIZE>> chunks;
-	std::list<int> available;
+	ListArena arena;
+	std::vector<Chunk<T, DEFAULT_CHUNK_SIZE> *> chunks;
+
+	// Ids of removed elements to be recycled (LIFO).
+	std::vector<int> available;
 	std::list<CreateElementCallback> callbackOnCreate;
 	std::list<RemoveElementCallback> callbackOnRemove;
 	std::list<DestructorCallback> callbackOnDestructor;
@@ -151,14 +301,14 @@ private:
 			   // element.
 
 			   currentChunk++;
-			   if (currentChunk >= chunks.size()) {
-				   chunks.resize(chunks.size()+1);
+			   if (currentChunk >= (int) chunks.size()) {
+				   chunks.push_back(createChunk());
 			   } // end if
 
 			   currentChunkFreeSpace = DEFAULT_CHUNK_SIZE;
 		   } // end else
 			
-			auto &c = chunks[currentChunk];
+			auto &c = *chunks[currentChunk];
 			e = &(c.elements[DEFAULT_CHUNK_SIZE - currentChunkFreeSpace]);
 			lastInsertedElementId = (currentChunk+1)*DEFAULT_CHUNK_SIZE - 
 				currentChunkFreeSpace;
@@ -171,6 +321,11 @@ private:
 
 		return e;
 	} // end method	
+
+	Chunk<T, DEFAULT_CHUNK_SIZE> *createChunk() {
+		void *ptr = arena.allocate(sizeof(Chunk<T, DEFAULT_CHUNK_SIZE>));
+		return new (ptr) Chunk<T, DEFAULT_CHUNK_SIZE>();
+	} // end method
 	
 public:	
 	
@@ -185,7 +340,15 @@ public:
 		for (DestructorCallback &callback : callbackOnDestructor) {
 			callback();
 		} // end for		
+
+		// Memory is released by the arena.
+		for (Chunk<T, DEFAULT_CHUNK_SIZE> *chunk : chunks) {
+			chunk->~Chunk<T, DEFAULT_CHUNK_SIZE>();
+		} // end for
 	} // end destructor
+
+	List(const List &) = delete;
+	List &operator=(const List &) = delete;
 	
 	bool isEmpty() const { return !numElements; };
 
@@ -195,26 +358,33 @@ public:
 		- currentChunkFreeSpace; }
 
 	int recycleId() const {
-		return available.empty()? -1 : available.front();
+		return available.empty()? -1 : available.back();
 	} // end method
 	
 	int capacity() const {
-		// It can be optimized, but for now its just for debug purpose.
-		int capacity = 0;
-
-		for (auto &c : chunks )
-			capacity += DEFAULT_CHUNK_SIZE;
-
-		return capacity;
+		return (int) chunks.size() * DEFAULT_CHUNK_SIZE;
 	} // end method
 
+	// Makes room for n elements in total. The missing chunks are allocated
+	// at once from a single block of memory.
 	void reserve(const int n) {
 		const int numChunks = (int) std::ceil(n / double(DEFAULT_CHUNK_SIZE));
-		if (numChunks > chunks.size()) {
-			chunks.resize(numChunks);
+		const int numMissingChunks = numChunks - (int) chunks.size();
+		if (numMissingChunks > 0) {
+			arena.reserve(numMissingChunks * 
+					sizeof(Chunk<T, DEFAULT_CHUNK_SIZE>));
+			chunks.reserve(numChunks);
+			while ((int) chunks.size() < numChunks) {
+				chunks.push_back(createChunk());
+			} // end while
 		} // end if
 	}; // end method
 
+	// Returns the number of bytes used by the chunks.
+	std::size_t getMemoryUsage() const {
+		return arena.getMemoryUsage();
+	} // end method
+
 	Element<T> *create() {
 		Element<T> *e = create_internal();
 		for (CreateElementCallback &callback : callbackOnCreate) {
@@ -223,6 +393,40 @@ public:
 		return e;
 	} // end method
 	
+	// Creates n elements at once, which get consecutive ids (removed ids are
+	// not recycled). Returns the id of the first element. The create 
+	// callbacks are still called for each element.
+	int createMany(const int n) {
+		if (n <= 0) {
+			return -1;
+		} // end if
+
+		reserve(largestId() + n);
+
+		const int first = largestId();
+		for (int i = 0; i < n; i++) {
+			if (currentChunkFreeSpace == 0) {
+				currentChunk++;
+				currentChunkFreeSpace = DEFAULT_CHUNK_SIZE;
+			} // end if
+
+			Element<T> *e = &(chunks[currentChunk]->elements[
+					DEFAULT_CHUNK_SIZE - currentChunkFreeSpace]);
+			e->deleted = false;
+			currentChunkFreeSpace--;
+		} // end for
+
+		numElements += n;
+		lastInsertedElementId = first + n - 1;
+
+		for (int id = first; id < first + n; id++) {
+			for (CreateElementCallback &callback : callbackOnCreate) {
+				callback(id);
+			} // end for
+		} // end for
+		return first;
+	} // end method
+	
 	Element<T> *add(const T &value) {
 		Element<T> *e = create_internal();
 		e->value = value;
@@ -233,11 +437,11 @@ public:
 	} // end method
 
 	Element<T> *get(const int index) {
-		return &chunks[index/DEFAULT_CHUNK_SIZE].elements[index%DEFAULT_CHUNK_SIZE];
+		return &chunks[index/DEFAULT_CHUNK_SIZE]->elements[index%DEFAULT_CHUNK_SIZE];
 	} // end method
 	
 	const Element<T> *get(const int index) const {
-		return &chunks[index/DEFAULT_CHUNK_SIZE].elements[index%DEFAULT_CHUNK_SIZE];
+		return &chunks[index/DEFAULT_CHUNK_SIZE]->elements[index%DEFAULT_CHUNK_SIZE];
 	} // end method	
 	
 	void remove(const int index) {
@@ -297,12 +501,12 @@ public:
 					currElementInChunk = 0;
 					currChunk++;
 					
-					if (currChunk == l->chunks.size()) {
+					if (currChunk == (int) l->chunks.size()) {
 						stop = true;
 						break;
 					} // end if
 					
-					auto &chunk = l->chunks[currChunk];
+					auto &chunk = *l->chunks[currChunk];
 					e = &(chunk.elements[0]);	
 					
 				} else {
@@ -351,7 +555,7 @@ public:
 		end.l = this;
 		end.currChunk = chunks.size() - 1;
 		end.currElementInChunk = DEFAULT_CHUNK_SIZE - 1;
-		end.e = &(chunks[ end.currChunk ].elements[ end.currElementInChunk ]);
+		end.e = &(chunks[ end.currChunk ]->elements[ end.currElementInChunk ]);
 		
 		return end;
 	}	
@@ -363,8 +567,8 @@ public:
 		std::cout << "> Number of elements: " << numElements << std::endl;
 		std::cout << "> Current chunk free elements: " << currentChunkFreeSpace << std::endl;
 		std::cout << "> Number of chunks: " << chunks.size() << std::endl;
-		for( auto c: chunks ) 
-			std::cout << ">> Chunk size: " << c.size << std:: endl;
+		std::cout << "> Chunk size: " << DEFAULT_CHUNK_SIZE << std::endl;
+		std::cout << "> Memory usage: " << getMemoryUsage() << " bytes" << std::endl;
 		
 		std::cout << " -----------------" << std::endl;
 	} // end method
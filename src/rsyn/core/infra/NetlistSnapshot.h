@@ -0,0 +1,184 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_NETLIST_SNAPSHOT_H
+#define RSYN_NETLIST_SNAPSHOT_H
+
+namespace Rsyn {
+
+// An immutable copy of the netlist connectivity stored in compressed sparse
+// row (CSR) format: pins -> arcs -> pins and nets -> pins. Rows are indexed
+// by the internal object indexes, so the snapshot can be traversed with
+// plain integer arithmetic over a few contiguous arrays instead of chasing
+// pointers through the object data.
+//
+// Snapshots are created by Design::getNetlistSnapshot() and are discarded by
+// the design whenever an event changing the connectivity is issued to its
+// observers (e.g. pin connection). A snapshot held by a client remains valid
+// (i.e. safe to read), but it may be outdated, which can be checked via
+// Design::isNetlistSnapshotUpToDate().
+
+class NetlistSnapshot {
+friend class Design;
+public:
+
+	//! @brief Index used to represent null objects (e.g. the net of an
+	//!        unconnected pin).
+	static const Index INVALID_INDEX = std::numeric_limits<Index>::max();
+
+	//! @brief A contiguous range of elements in the snapshot.
+	template<typename T>
+	class Span {
+	public:
+		Span(const T * begin, const T * end) : clsBegin(begin), clsEnd(end) {}
+		const T *begin() const { return clsBegin; }
+		const T *end() const { return clsEnd; }
+		int size() const { return (int) (clsEnd - clsBegin); }
+		bool empty() const { return clsBegin == clsEnd; }
+		const T &operator[](const int i) const { return clsBegin[i]; }
+	private:
+		const T * clsBegin;
+		const T * clsEnd;
+	}; // end class
+
+	//! @brief Returns the netlist version from which this snapshot was built.
+	int getVersion() const { return clsVersion; }
+
+	//! @brief Returns the number of pin rows. Pin indexes are in the range
+	//!        [0, getNumPinRows()). Rows of removed pins are empty.
+	Index getNumPinRows() const { return (Index) clsPins.size(); }
+
+	//! @brief Returns the number of net rows. Net indexes are in the range
+	//!        [0, getNumNetRows()). Rows of removed nets are empty.
+	Index getNumNetRows() const { return (Index) clsNets.size(); }
+
+	//! @brief Returns the index of a pin in this snapshot.
+	Index getPinIndex(Pin pin) const { return clsDesign.getId(pin); }
+
+	//! @brief Returns the index of a net in this snapshot.
+	Index getNetIndex(Net net) const { return clsDesign.getId(net); }
+
+	//! @brief Returns the pin at a given index.
+	Pin getPin(const Index pin) const { return clsPins[pin]; }
+
+	//! @brief Returns the net at a given index.
+	Net getNet(const Index net) const { return clsNets[net]; }
+
+	//! @brief Returns the index of the net connected to a pin or
+	//!        INVALID_INDEX if the pin is unconnected.
+	Index getPinNet(const Index pin) const { return clsPinNet[pin]; }
+
+	//! @brief Returns the index of the (any) driver of a net or INVALID_INDEX
+	//!        if the net has no driver.
+	Index getNetDriver(const Index net) const { return clsNetDriver[net]; }
+
+	//! @brief Returns the indexes of the pins connected to a net.
+	Span<Index> getNetPins(const Index net) const {
+		return span(clsNetPins, clsNetPinOffsets, net);
+	} // end method
+
+	//! @brief Returns the arcs leaving a pin.
+	Span<Arc> getFanoutArcs(const Index pin) const {
+		return span(clsFanoutArcs, clsFanoutOffsets, pin);
+	} // end method
+
+	//! @brief Returns the indexes of the "to" pins of the arcs leaving a pin.
+	//!        The i-th pin corresponds to the i-th arc in getFanoutArcs().
+	Span<Index> getFanoutPins(const Index pin) const {
+		return span(clsFanoutPins, clsFanoutOffsets, pin);
+	} // end method
+
+	//! @brief Returns the arcs reaching a pin.
+	Span<Arc> getFaninArcs(const Index pin) const {
+		return span(clsFaninArcs, clsFaninOffsets, pin);
+	} // end method
+
+	//! @brief Returns the indexes of the "from" pins of the arcs reaching a
+	//!        pin. The i-th pin corresponds to the i-th arc in getFaninArcs().
+	Span<Index> getFaninPins(const Index pin) const {
+		return span(clsFaninPins, clsFaninOffsets, pin);
+	} // end method
+
+	//! @brief Returns the nets of the top module sorted in topological order.
+	//!        The order is the same as Module::allNetsInTopologicalOrder().
+	const std::vector<Net> &allNetsInTopologicalOrder() const {
+		return clsNetsInTopologicalOrder;
+	} // end method
+
+	//! @brief Returns the nets of the top module sorted in reverse topological
+	//!        order. The order is the same as
+	//!        Module::allNetsInReverseTopologicalOrder().
+	const std::vector<Net> &allNetsInReverseTopologicalOrder() const {
+		return clsNetsInReverseTopologicalOrder;
+	} // end method
+
+	//! @brief Returns the memory used by this snapshot in bytes.
+	std::size_t getMemoryUsage() const {
+		return
+			clsPins.size() * sizeof(Pin) +
+			clsNets.size() * sizeof(Net) +
+			clsPinNet.size() * sizeof(Index) +
+			clsNetDriver.size() * sizeof(Index) +
+			clsNetPinOffsets.size() * sizeof(Index) +
+			clsNetPins.size() * sizeof(Index) +
+			clsFanoutOffsets.size() * sizeof(Index) +
+			clsFanoutPins.size() * sizeof(Index) +
+			clsFanoutArcs.size() * sizeof(Arc) +
+			clsFaninOffsets.size() * sizeof(Index) +
+			clsFaninPins.size() * sizeof(Index) +
+			clsFaninArcs.size() * sizeof(Arc) +
+			clsNetsInTopologicalOrder.size() * sizeof(Net) +
+			clsNetsInReverseTopologicalOrder.size() * sizeof(Net);
+	} // end method
+
+private:
+
+	Design clsDesign;
+	int clsVersion = -1;
+
+	std::vector<Pin> clsPins;
+	std::vector<Net> clsNets;
+
+	std::vector<Index> clsPinNet;
+	std::vector<Index> clsNetDriver;
+
+	// Nets -> pins.
+	std::vector<Index> clsNetPinOffsets;
+	std::vector<Index> clsNetPins;
+
+	// Pins -> arcs -> pins.
+	std::vector<Index> clsFanoutOffsets;
+	std::vector<Index> clsFanoutPins;
+	std::vector<Arc> clsFanoutArcs;
+
+	std::vector<Index> clsFaninOffsets;
+	std::vector<Index> clsFaninPins;
+	std::vector<Arc> clsFaninArcs;
+
+	std::vector<Net> clsNetsInTopologicalOrder;
+	std::vector<Net> clsNetsInReverseTopologicalOrder;
+
+	template<typename T>
+	static Span<T> span(const std::vector<T> &values,
+			const std::vector<Index> &offsets, const Index row) {
+		const T * data = values.data();
+		return Span<T>(data + offsets[row], data + offsets[row + 1]);
+	} // end method
+
+}; // end class
+
+} // end namespace
+
+#endif
@@ -24,6 +24,9 @@ private:
 
 	Design observedDesign;
 
+	// Set when the observer overwrites onPostDesignEdit().
+	bool observesDesignEdits = false;
+
 public:
 	
 	// Note: The observer will not be registered to receive notifications for
@@ -54,6 +57,15 @@ public:
 	virtual void
 	onPrePinDisconnect(Rsyn::Pin pin) {}
 
+	// Called once when an edit transaction is committed (see
+	// Design::beginEdit()). Observers that overwrite this method do not
+	// receive the per-object notifications (e.g. onPostPinConnect()) of the
+	// edits performed inside a transaction, only the coalesced change set.
+	// Observers that do not overwrite it keep receiving the per-object
+	// notifications as the edits happen.
+	virtual void
+	onPostDesignEdit(const Rsyn::DesignChangeSet &changes) {}
+
 	virtual
 	~Observer() {
 		if (observedDesign)
@@ -57,6 +57,27 @@ struct DesignData {
 	////////////////////////////////////////////////////////////////////////////
 
 	std::array<std::list<Observer *>, NUM_EVENTS> observers;
+
+	////////////////////////////////////////////////////////////////////////////
+	// Netlist Snapshot
+	////////////////////////////////////////////////////////////////////////////
+
+	// Incremented whenever the netlist connectivity changes.
+	int netlistVersion;
+
+	// Cached snapshot, rebuilt on demand when outdated.
+	std::shared_ptr<const NetlistSnapshot> netlistSnapshot;
+
+	////////////////////////////////////////////////////////////////////////////
+	// Edit Transactions
+	////////////////////////////////////////////////////////////////////////////
+
+	// Number of nested edit transactions currently open.
+	int editDepth;
+
+	// Changes performed in the open transaction. Objects may be repeated
+	// until the transaction is committed.
+	DesignChangeSet pendingChanges;
 	
 	////////////////////////////////////////////////////////////////////////////
 	// Constructor
@@ -68,7 +89,9 @@ struct DesignData {
 		anonymousInstanceId(0),
 		anonymousNetId(0),
 		instanceCount({0, 0, 0}),
-		sign(0) {
+		sign(0),
+		netlistVersion(0),
+		editDepth(0) {
 	} // end constructor
 }; // end class
 
@@ -37,8 +37,20 @@ struct ModuleData {
 	// Used for some netlist traversing...
 	int sign;	
 	
+	// Nets sorted in topological order and their topological indexes. Built
+	// on the first query and then repaired incrementally by re-inserting only
+	// the nets whose topological index may have changed since the last query.
+	std::vector<Net> netsInTopologicalOrder;
+	std::vector<TopologicalIndex> netsTopologicalIndex;
+	std::vector<Net> netsInReverseTopologicalOrder;
+	std::vector<Net> netsWithDirtyTopologicalIndex;
+	bool topologicalOrderInitialized;
+	bool reverseTopologicalOrderDirty;
+
 	ModuleData() :
-		sign(0) {}
+		sign(0),
+		topologicalOrderInitialized(false),
+		reverseTopologicalOrderDirty(true) {}
 	
 }; // end struct
 
@@ -47,12 +47,17 @@ struct NetData : ObjectData {
 	// Helper used for netlist traversals.
 	int sign;
 	
+	// Indicates that the net is pending to be repositioned in the cached
+	// topological ordering of its parent module.
+	bool dirtyTopologicalIndex;
+	
 	NetData() : 
 		mid(-1),
 		sign(-1),
 		driver(nullptr), 
 		numPinsOfType({0, 0, 0, 0}), 
-		parent(nullptr) {
+		parent(nullptr),
+		dirtyTopologicalIndex(false) {
 	} // end constructor	
 }; // end struct
 
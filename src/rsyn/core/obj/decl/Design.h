@@ -27,12 +27,13 @@ friend class Cell;
 friend class Pin;
 friend class Instance;
 friend class Module;
+friend class NetlistSnapshot;
 
 friend class Sandbox;
 friend class SandboxNet;
 friend class SandboxInstance;
 
-template<typename _Object, typename _ObjectReference, typename _ObjectExtension> friend class AttributeBase;
+template<typename _Object, typename _ObjectReference, typename _ObjectExtension, typename _List> friend class AttributeBase;
 template<typename _Object, typename _ObjectExtension> friend class AttributeImplementation;
 
 private:
@@ -179,6 +180,11 @@ public:
 
 	//! @brief Gets the current number of pins in the design.
 	int getNumPins() const;
+
+	//! @brief Reserves memory for the given number of new objects. Readers
+	//!        knowing the size of the netlist in advance should call this
+	//!        before creating the netlist objects.
+	void reserve(const int numInstances, const int numPins, const int numNets, const int numArcs);
 	
 	////////////////////////////////////////////////////////////////////////////
 	// Topological Ordering
@@ -188,7 +194,90 @@ private:
 	//! @brief Updates incrementally the topological ordering given a change in
 	//!        a pin (e.g. pin gets connected).
 	void updateTopologicalIndex(Pin pin);
+
+	//! @brief Marks that the topological index of a net may have changed so
+	//!        that the net gets repositioned in the cached topological
+	//!        ordering of its parent module.
+	void invalidateTopologicalIndex(Net net);
 	
+	////////////////////////////////////////////////////////////////////////////
+	// Netlist Snapshot
+	////////////////////////////////////////////////////////////////////////////
+public:
+
+	//! @brief Returns an immutable compressed (CSR) snapshot of the netlist
+	//!        connectivity. The snapshot is built on demand and cached until
+	//!        the netlist changes.
+	//! @note  Cell remapping does not invalidate the snapshot as pins and arcs
+	//!        are kept.
+	std::shared_ptr<const NetlistSnapshot>
+	getNetlistSnapshot();
+
+	//! @brief Returns the cached snapshot if it reflects the current netlist
+	//!        or nullptr otherwise. Unlike getNetlistSnapshot(), this never
+	//!        builds a snapshot, so it is cheap to call after netlist edits.
+	std::shared_ptr<const NetlistSnapshot>
+	getCachedNetlistSnapshot() const;
+
+	//! @brief Returns true if the snapshot reflects the current netlist.
+	bool
+	isNetlistSnapshotUpToDate(const NetlistSnapshot &snapshot) const;
+
+	//! @brief Returns a number that changes whenever the netlist connectivity
+	//!        changes.
+	int
+	getNetlistVersion() const;
+
+private:
+
+	//! @brief Marks the current netlist snapshot as outdated.
+	void
+	invalidateNetlistSnapshot();
+
+	//! @brief Fills in the snapshot with the current netlist connectivity.
+	void
+	buildNetlistSnapshot(NetlistSnapshot &snapshot);
+
+	////////////////////////////////////////////////////////////////////////////
+	// Edit Transactions
+	////////////////////////////////////////////////////////////////////////////
+public:
+
+	//! @brief Opens an edit transaction. Until the transaction is committed,
+	//!        netlist edits (e.g. connectPin(), remap()) do not repair the
+	//!        topological ordering and observers overwriting
+	//!        Observer::onPostDesignEdit() are not notified. Transactions may
+	//!        be nested, only the outermost commit takes effect.
+	//! @note  The topological ordering (and anything derived from it) is not
+	//!        reliable while a transaction is open.
+	void
+	beginEdit();
+
+	//! @brief Commits the current edit transaction. The topological ordering
+	//!        is repaired once for all edits and a single coalesced change
+	//!        set is delivered to the observers.
+	void
+	commitEdit();
+
+	//! @brief Returns true if there is an open edit transaction.
+	bool
+	isEditing() const;
+
+private:
+
+	//! @brief Returns true if the per-object notification of the observer
+	//!        must be skipped as it will receive the coalesced change set.
+	bool
+	isNotificationDeferred(const Observer *observer) const;
+
+	//! @brief Removes repeated objects keeping the first occurrence.
+	void
+	coalesceChangeSet(DesignChangeSet &changes);
+
+	//! @brief Recomputes the topological index of all pins from scratch.
+	void
+	rebuildTopologicalIndex();
+
 	////////////////////////////////////////////////////////////////////////////
 	// Events
 	////////////////////////////////////////////////////////////////////////////	
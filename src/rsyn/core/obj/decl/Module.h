@@ -50,6 +50,10 @@ private:
 	Range<CollectionOfArcs>
 	allArcs() const;
 
+	//! @brief Brings the cached topological ordering of nets up to date.
+	void
+	updateNetsInTopologicalOrder();
+
 public:
 
 	//! @brief Default constructor.
@@ -162,14 +166,20 @@ public:
 	//!        module in topological order (from inputs to outputs).
 	//! @note  See Net::getTopologicalIndex() description to check how
 	//!        the topological index of nets is defined.
-	std::vector<TupleElement<1, TopologicalIndex, Net>>
+	//! @note  The ordering is cached and repaired incrementally as the
+	//!        netlist changes. The returned collection remains valid until
+	//!        the next call after a netlist change.
+	const std::vector<Net> &
 	allNetsInTopologicalOrder();	
 
 	//! @brief Returns an iterable collection of all nets instantiated in this
 	//!        module in reverse topological order (from outputs to inputs).
 	//! @note  See Net::getTopologicalIndex() description to check how
 	//!        the topological index of nets is defined.
-	std::vector<TupleElement<1, TopologicalIndex, Net>>
+	//! @note  The ordering is cached and repaired incrementally as the
+	//!        netlist changes. The returned collection remains valid until
+	//!        the next call after a netlist change.
+	const std::vector<Net> &
 	allNetsInReverseTopologicalOrder();	
 
 	//! @brief Returns an iterable collection of all instances instantiated in
@@ -300,11 +300,13 @@ Design::createCell(const Module parent, const LibraryCell libraryCell, const std
 	instance->pins.resize(numPins);
 	instance->arcs.resize(numArcs);
 
-	// Initializes instance's pins.
+	// Initializes instance's pins. Pins (and arcs) of a cell are allocated at
+	// once and get consecutive ids.
+	const int firstPinId = data->pins.createMany(numPins);
 	for (int i = 0; i < numPins; i++) {
-		PinData * pin = &(data->pins.create()->value); // TODO: awful
+		PinData * pin = &(data->pins.get(firstPinId + i)->value);
 		LibraryPin lpin = lcell->pins[i];
-		pin->id = data->pins.lastId();
+		pin->id = firstPinId + i;
 		pin->instance = cell;
 		pin->direction = lpin.data->direction;
 		pin->type = Rsyn::CELL;
@@ -327,10 +329,11 @@ Design::createCell(const Module parent, const LibraryCell libraryCell, const std
 	} // end for
 	
 	// Initializes cell's arcs.
+	const int firstArcId = data->arcs.createMany(numArcs);
 	for (int i = 0; i < numArcs; i++) {
-		ArcData * arc = &(data->arcs.create()->value); // TODO: awful
+		ArcData * arc = &(data->arcs.get(firstArcId + i)->value);
 		LibraryArc larc = lcell->arcs[i];
-		arc->id = data->arcs.lastId();
+		arc->id = firstArcId + i;
 		arc->type = INSTANCE_ARC;
 		arc->libraryArcData = larc.data;
 		arc->from = cell.getPinByLibraryPin(larc.data->from);
@@ -359,10 +362,15 @@ Design::createCell(const Module parent, const LibraryCell libraryCell, const std
 	
 	// Mark as dirty.
 	data->dirty = true;
+	invalidateNetlistSnapshot();
 	
 	// Notify observers.
-	for (auto f : data->observers[EVENT_POST_INSTANCE_CREATE])
-		f->onPostInstanceCreate(cell);
+	if (data->editDepth > 0)
+		data->pendingChanges.createdInstances.push_back(cell);
+	for (auto f : data->observers[EVENT_POST_INSTANCE_CREATE]) {
+		if (!isNotificationDeferred(f))
+			f->onPostInstanceCreate(cell);
+	} // end for
 	
 	// Return
 	return cell;
@@ -445,10 +453,15 @@ Design::createPort(Module parent, const Direction direction, const std::string &
 	
 	// Mark as dirty.
 	data->dirty = true;	
+	invalidateNetlistSnapshot();
 	
 	// Notify observers.
-	for (auto f : data->observers[EVENT_POST_INSTANCE_CREATE])
-		f->onPostInstanceCreate(port);
+	if (data->editDepth > 0)
+		data->pendingChanges.createdInstances.push_back(port);
+	for (auto f : data->observers[EVENT_POST_INSTANCE_CREATE]) {
+		if (!isNotificationDeferred(f))
+			f->onPostInstanceCreate(port);
+	} // end for
 
 	// Return
 	return port;
@@ -482,10 +495,15 @@ Design::createModule(const LibraryModule lmoudle, const std::string &name) {
 	
 	// Mark as dirty.
 	data->dirty = true;
+	invalidateNetlistSnapshot();
 	
 	// Notify observers.
-	for (auto f : data->observers[EVENT_POST_INSTANCE_CREATE])
-		f->onPostInstanceCreate(instance);
+	if (data->editDepth > 0)
+		data->pendingChanges.createdInstances.push_back(Instance(instance));
+	for (auto f : data->observers[EVENT_POST_INSTANCE_CREATE]) {
+		if (!isNotificationDeferred(f))
+			f->onPostInstanceCreate(instance);
+	} // end for
 	
 	// Return
 	return Module(instance);
@@ -519,12 +537,18 @@ Design::createNet(const Module parent, const std::string &name) {
 	parent->moduleData->nets.add(net);
 	net->mid = parent->moduleData->nets.lastId();
 	
-	// Notify observers.
-	for (auto f : data->observers[EVENT_POST_NET_CREATE])
-		f->onPostNetCreate(net);
-	
 	// Mark as dirty.
 	data->dirty = true;	
+	invalidateNetlistSnapshot();
+	invalidateTopologicalIndex(net);
+
+	// Notify observers.
+	if (data->editDepth > 0)
+		data->pendingChanges.createdNets.push_back(net);
+	for (auto f : data->observers[EVENT_POST_NET_CREATE]) {
+		if (!isNotificationDeferred(f))
+			f->onPostNetCreate(net);
+	} // end for
 	
 	// Return.
 	return net;
@@ -585,13 +609,22 @@ Design::connectPin(Pin pin, Net net) {
 	
 	// Mark as dirty.
 	data->dirty = true;	
+	invalidateNetlistSnapshot();
 		
-	// Update topological sorting.
-	updateTopologicalIndex(pin);
+	// Update topological sorting. Inside an edit transaction, the sorting is
+	// repaired once when the transaction is committed.
+	if (data->editDepth > 0) {
+		data->pendingChanges.reconnectedPins.push_back(pin);
+		data->pendingChanges.modifiedNets.push_back(net);
+	} else {
+		updateTopologicalIndex(pin);
+	} // end if-else
 	
 	// Notify observers.
-	for (auto f : data->observers[EVENT_POST_PIN_CONNECT])
-		f->onPostPinConnect(pin);
+	for (auto f : data->observers[EVENT_POST_PIN_CONNECT]) {
+		if (!isNotificationDeferred(f))
+			f->onPostPinConnect(pin);
+	} // end for
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -600,8 +633,10 @@ inline
 void
 Design::disconnectPin(Pin pin) {
 	// Notify observers.
-	for (auto f : data->observers[EVENT_PRE_PIN_DISCONNECT])
-		f->onPrePinDisconnect(pin);
+	for (auto f : data->observers[EVENT_PRE_PIN_DISCONNECT]) {
+		if (!isNotificationDeferred(f))
+			f->onPrePinDisconnect(pin);
+	} // end for
 	
 	if (pin->net) {
 		// Remove the pin from the net.
@@ -645,6 +680,14 @@ Design::disconnectPin(Pin pin) {
 
 		// Mark as dirty.
 		data->dirty = true;
+		invalidateNetlistSnapshot();
+		invalidateTopologicalIndex(net);
+
+		// Record the change if inside an edit transaction.
+		if (data->editDepth > 0) {
+			data->pendingChanges.reconnectedPins.push_back(pin);
+			data->pendingChanges.modifiedNets.push_back(net);
+		} // end if
 	} // end if
 } // end method
 
@@ -717,8 +760,12 @@ Design::remap(Cell cell, LibraryCell newLibraryCell) {
 	} // end for
 	
 	// Notify observers.
-	for (auto f : data->observers[EVENT_POST_CELL_REMAP])
-		f->onPostCellRemap(cell, oldLibraryCell);
+	if (data->editDepth > 0)
+		data->pendingChanges.remappedCells.push_back(std::make_tuple(cell, oldLibraryCell));
+	for (auto f : data->observers[EVENT_POST_CELL_REMAP]) {
+		if (!isNotificationDeferred(f))
+			f->onPostCellRemap(cell, oldLibraryCell);
+	} // end for
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -765,6 +812,22 @@ Design::getNumPins() const {
 	return data->pins.size();
 } // end method
 
+// -----------------------------------------------------------------------------
+
+inline
+void
+Design::reserve(const int numInstances, const int numPins, const int numNets, const int numArcs) {
+	data->instances.reserve(data->instances.largestId() + numInstances);
+	data->pins.reserve(data->pins.largestId() + numPins);
+	data->nets.reserve(data->nets.largestId() + numNets);
+	data->arcs.reserve(data->arcs.largestId() + numArcs);
+
+	data->instanceNames.reserve(data->instances.largestId() + numInstances);
+	data->netNames.reserve(data->nets.largestId() + numNets);
+	data->instanceMapping.reserve(data->instanceMapping.size() + numInstances);
+	data->netMapping.reserve(data->netMapping.size() + numNets);
+} // end method
+
 ////////////////////////////////////////////////////////////////////////////////
 // Topological Ordering
 ////////////////////////////////////////////////////////////////////////////////
@@ -802,6 +865,10 @@ Design::updateTopologicalIndex(Pin pin) {
 		hasUpper = true;
 	} // end for
 	
+	// Nets containing pins whose topological index changes need to be
+	// repositioned in the cached net ordering.
+	invalidateTopologicalIndex(pin->net);
+
 	// Set pin's topological ordering.
 	if (!hasLower && !hasUpper) {
 		pin->order = 0;
@@ -867,6 +934,7 @@ Design::updateTopologicalIndex(Pin pin) {
 				} // end else
 				
 				current->order = order;
+				invalidateTopologicalIndex(current->net);
 				
 				for (Rsyn::Pin successor : current.allSucessorPins(true)) {
 					if (successor->order <= order) {
@@ -878,6 +946,23 @@ Design::updateTopologicalIndex(Pin pin) {
 	} // end else
 } // end method
 
+// -----------------------------------------------------------------------------
+
+inline
+void
+Design::invalidateTopologicalIndex(Net net) {
+	if (!net || net->dirtyTopologicalIndex)
+		return;
+
+	// Nothing to repair if the ordering was not built yet.
+	ModuleData * moduleData = net->parent->moduleData;
+	if (!moduleData->topologicalOrderInitialized)
+		return;
+
+	net->dirtyTopologicalIndex = true;
+	moduleData->netsWithDirtyTopologicalIndex.push_back(net);
+} // end method
+
 ////////////////////////////////////////////////////////////////////////////////
 // Unique Identifiers for Rsyn Objects
 ////////////////////////////////////////////////////////////////////////////////
@@ -890,6 +975,312 @@ inline Index Design::getId(LibraryCell lcell) const { return lcell->id; }
 inline Index Design::getId(LibraryPin lpin) const { return lpin->id; }
 inline Index Design::getId(LibraryArc larc) const { return larc->id; }
 
+////////////////////////////////////////////////////////////////////////////////
+// Netlist Snapshot
+////////////////////////////////////////////////////////////////////////////////
+
+inline
+std::shared_ptr<const NetlistSnapshot>
+Design::getNetlistSnapshot() {
+	if (!data->netlistSnapshot || !isNetlistSnapshotUpToDate(*data->netlistSnapshot)) {
+		std::shared_ptr<NetlistSnapshot> snapshot =
+				std::make_shared<NetlistSnapshot>();
+		buildNetlistSnapshot(*snapshot);
+		data->netlistSnapshot = snapshot;
+	} // end if
+	return data->netlistSnapshot;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+std::shared_ptr<const NetlistSnapshot>
+Design::getCachedNetlistSnapshot() const {
+	if (data->netlistSnapshot && isNetlistSnapshotUpToDate(*data->netlistSnapshot)) {
+		return data->netlistSnapshot;
+	} // end if
+	return nullptr;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+bool
+Design::isNetlistSnapshotUpToDate(const NetlistSnapshot &snapshot) const {
+	return snapshot.clsDesign == *this &&
+			snapshot.getVersion() == data->netlistVersion;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+int
+Design::getNetlistVersion() const {
+	return data->netlistVersion;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+void
+Design::invalidateNetlistSnapshot() {
+	data->netlistVersion++;
+	data->netlistSnapshot = nullptr;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+void
+Design::buildNetlistSnapshot(NetlistSnapshot &snapshot) {
+	const Index invalid = NetlistSnapshot::INVALID_INDEX;
+	const Index numPins = (Index) data->pins.largestId();
+	const Index numNets = (Index) data->nets.largestId();
+	const Index numArcs = (Index) data->arcs.size();
+
+	snapshot.clsDesign = *this;
+	snapshot.clsVersion = data->netlistVersion;
+
+	// Pins -> arcs -> pins. Arcs are stored in the same order as they are
+	// stored in the pins, so traversals visit them in the same order.
+	snapshot.clsPins.assign(numPins, nullptr);
+	snapshot.clsPinNet.assign(numPins, invalid);
+	snapshot.clsFanoutOffsets.assign(numPins + 1, 0);
+	snapshot.clsFaninOffsets.assign(numPins + 1, 0);
+	snapshot.clsFanoutPins.reserve(numArcs);
+	snapshot.clsFanoutArcs.reserve(numArcs);
+	snapshot.clsFaninPins.reserve(numArcs);
+	snapshot.clsFaninArcs.reserve(numArcs);
+
+	for (Index id = 0; id < numPins; id++) {
+		Element<PinData> * element = data->pins.get(id);
+		if (!element->deleted) {
+			Pin pin = &element->value;
+			snapshot.clsPins[id] = pin;
+			if (pin->net) {
+				snapshot.clsPinNet[id] = pin->net->id;
+			} // end if
+
+			for (Arc arc : pin->arcs[FORWARD]) {
+				snapshot.clsFanoutArcs.push_back(arc);
+				snapshot.clsFanoutPins.push_back(arc->to->id);
+			} // end for
+
+			for (Arc arc : pin->arcs[BACKWARD]) {
+				snapshot.clsFaninArcs.push_back(arc);
+				snapshot.clsFaninPins.push_back(arc->from->id);
+			} // end for
+		} // end if
+
+		snapshot.clsFanoutOffsets[id + 1] = (Index) snapshot.clsFanoutArcs.size();
+		snapshot.clsFaninOffsets[id + 1] = (Index) snapshot.clsFaninArcs.size();
+	} // end for
+
+	// Nets -> pins.
+	snapshot.clsNets.assign(numNets, nullptr);
+	snapshot.clsNetDriver.assign(numNets, invalid);
+	snapshot.clsNetPinOffsets.assign(numNets + 1, 0);
+	snapshot.clsNetPins.clear();
+	snapshot.clsNetPins.reserve(numPins);
+
+	for (Index id = 0; id < numNets; id++) {
+		Element<NetData> * element = data->nets.get(id);
+		if (!element->deleted) {
+			Net net = &element->value;
+			snapshot.clsNets[id] = net;
+			if (net->driver) {
+				snapshot.clsNetDriver[id] = net->driver->id;
+			} // end if
+
+			for (Pin pin : net->pins) {
+				snapshot.clsNetPins.push_back(pin->id);
+			} // end for
+		} // end if
+
+		snapshot.clsNetPinOffsets[id + 1] = (Index) snapshot.clsNetPins.size();
+	} // end for
+
+	// Topological ordering.
+	Module top = getTopModule();
+
+	snapshot.clsNetsInTopologicalOrder.clear();
+	snapshot.clsNetsInTopologicalOrder.reserve(numNets);
+	for (Net net : top.allNetsInTopologicalOrder()) {
+		snapshot.clsNetsInTopologicalOrder.push_back(net);
+	} // end for
+
+	snapshot.clsNetsInReverseTopologicalOrder.clear();
+	snapshot.clsNetsInReverseTopologicalOrder.reserve(numNets);
+	for (Net net : top.allNetsInReverseTopologicalOrder()) {
+		snapshot.clsNetsInReverseTopologicalOrder.push_back(net);
+	} // end for
+} // end method
+
+////////////////////////////////////////////////////////////////////////////////
+// Edit Transactions
+////////////////////////////////////////////////////////////////////////////////
+
+inline
+void
+Design::beginEdit() {
+	data->editDepth++;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+void
+Design::commitEdit() {
+	if (data->editDepth <= 0) {
+		throw Exception("There is no open edit transaction to commit.");
+	} // end if
+
+	if (--data->editDepth > 0) {
+		// Nested transaction, wait for the outermost one.
+		return;
+	} // end if
+
+	// Move the changes out so that observers may edit the design when
+	// notified.
+	DesignChangeSet changes;
+	std::swap(changes, data->pendingChanges);
+	if (changes.empty())
+		return;
+
+	coalesceChangeSet(changes);
+
+	// Repair the topological ordering. If a large portion of the netlist was
+	// touched, recomputing the ordering from scratch is cheaper than repairing
+	// it pin by pin.
+	const int numReconnectedPins = (int) changes.reconnectedPins.size();
+	if (numReconnectedPins > 0) {
+		const int rebuildRatio = 8;
+		if (numReconnectedPins * rebuildRatio >= getNumPins()) {
+			rebuildTopologicalIndex();
+		} else {
+			for (Pin pin : changes.reconnectedPins) {
+				if (pin->net) {
+					updateTopologicalIndex(pin);
+				} // end if
+			} // end for
+		} // end if-else
+	} // end if
+
+	// Notify observers.
+	for (auto f : data->observers[EVENT_POST_DESIGN_EDIT])
+		f->onPostDesignEdit(changes);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+bool
+Design::isEditing() const {
+	return data->editDepth > 0;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+bool
+Design::isNotificationDeferred(const Observer *observer) const {
+	return data->editDepth > 0 && observer->Observer::observesDesignEdits;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+void
+Design::coalesceChangeSet(DesignChangeSet &changes) {
+	const int sign = generateNextSign();
+
+	int numPins = 0;
+	for (Pin pin : changes.reconnectedPins) {
+		if (pin->sign != sign) {
+			pin->sign = sign;
+			changes.reconnectedPins[numPins++] = pin;
+		} // end if
+	} // end for
+	changes.reconnectedPins.resize(numPins);
+
+	int numNets = 0;
+	for (Net net : changes.modifiedNets) {
+		if (net->sign != sign) {
+			net->sign = sign;
+			changes.modifiedNets[numNets++] = net;
+		} // end if
+	} // end for
+	changes.modifiedNets.resize(numNets);
+
+	// Keep the library cell the cell had before its first remapping.
+	std::set<Cell> remapped;
+	int numCells = 0;
+	for (int i = 0; i < (int) changes.remappedCells.size(); i++) {
+		if (remapped.insert(std::get<0>(changes.remappedCells[i])).second) {
+			changes.remappedCells[numCells++] = changes.remappedCells[i];
+		} // end if
+	} // end for
+	changes.remappedCells.resize(numCells);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+void
+Design::rebuildTopologicalIndex() {
+	const Index numPins = (Index) data->pins.largestId();
+	const TopologicalIndex gap = TOPOLOGICAL_SORTING_SMALL_GAP;
+
+	// Count the predecessors of each pin.
+	std::vector<int> numPendingPredecessors(numPins, 0);
+	for (Index id = 0; id < numPins; id++) {
+		Element<PinData> * element = data->pins.get(id);
+		if (!element->deleted) {
+			Pin pin = &element->value;
+			pin->order = 0;
+			for (Rsyn::Pin successor : pin.allSucessorPins(true)) {
+				numPendingPredecessors[successor->id]++;
+			} // end for
+		} // end if
+	} // end for
+
+	// Visit the pins in topological order, each pin is placed right after its
+	// latest predecessor.
+	std::vector<Pin> open;
+	open.reserve(numPins);
+	for (Index id = 0; id < numPins; id++) {
+		Element<PinData> * element = data->pins.get(id);
+		if (!element->deleted && numPendingPredecessors[id] == 0) {
+			open.push_back(&element->value);
+		} // end if
+	} // end for
+
+	for (int i = 0; i < (int) open.size(); i++) {
+		Rsyn::Pin current = open[i];
+		for (Rsyn::Pin successor : current.allSucessorPins(true)) {
+			successor->order = std::max(successor->order, current->order + gap);
+			if (--numPendingPredecessors[successor->id] == 0) {
+				open.push_back(successor);
+			} // end if
+		} // end for
+	} // end for
+
+	if ((int) open.size() != getNumPins()) {
+		// Pins in a loop are never visited. They keep the index given by
+		// their visited predecessors.
+		std::cout << "WARNING: Loop detected.\n";
+	} // end if
+
+	// All nets need to be repositioned in the cached net orderings.
+	const Index numNets = (Index) data->nets.largestId();
+	for (Index id = 0; id < numNets; id++) {
+		Element<NetData> * element = data->nets.get(id);
+		if (!element->deleted) {
+			invalidateTopologicalIndex(&element->value);
+		} // end if
+	} // end for
+} // end method
+
 ////////////////////////////////////////////////////////////////////////////////
 // Events
 ////////////////////////////////////////////////////////////////////////////////
@@ -938,6 +1329,11 @@ Design::registerObserver(T *observer) {
 	if (typeid(&Observer::onPrePinDisconnect) != typeid(&T::onPrePinDisconnect)) {
 		data->observers[EVENT_PRE_PIN_DISCONNECT].push_back(observer);
 	} // end if	
+
+	if (typeid(&Observer::onPostDesignEdit) != typeid(&T::onPostDesignEdit)) {
+		data->observers[EVENT_POST_DESIGN_EDIT].push_back(observer);
+		observer->Observer::observesDesignEdits = true;
+	} // end if
 	
 } // end method
 
@@ -949,6 +1345,7 @@ Design::unregisterObserver(Observer *observer) {
 	for (int i = 0; i < NUM_EVENTS; i++) {
 		data->observers[i].remove(observer);
 	} // end for
+	observer->Observer::observesDesignEdits = false;
 	observer->Observer::observedDesign = nullptr;
 } // end method
 
@@ -322,41 +322,128 @@ Module::allPinsInReverseTopologicalOrder() {
 // -----------------------------------------------------------------------------
 
 inline
-std::vector<TupleElement<1, TopologicalIndex, Net>>
-Module::allNetsInTopologicalOrder() {
-	const int numNets = data->moduleData->nets.size();
-	
-	std::vector<TupleElement<1, TopologicalIndex, Net>> sortedNets;
-	sortedNets.resize(numNets);
-	
-	int i = 0;
-	for (Rsyn::Net net : allNets()) {
-		sortedNets[i++] = std::make_tuple(net.getTopologicalIndex(), net);
+void
+Module::updateNetsInTopologicalOrder() {
+	ModuleData * moduleData = data->moduleData;
+	std::vector<Net> &sortedNets = moduleData->netsInTopologicalOrder;
+	std::vector<TopologicalIndex> &sortedIndexes = moduleData->netsTopologicalIndex;
+	std::vector<Net> &dirtyNets = moduleData->netsWithDirtyTopologicalIndex;
+
+	if (!moduleData->topologicalOrderInitialized) {
+		// Full build.
+		std::vector<std::tuple<TopologicalIndex, Net>> sorted;
+		sorted.reserve(moduleData->nets.size());
+		for (Rsyn::Net net : allNets()) {
+			sorted.push_back(std::make_tuple(net.getTopologicalIndex(), net));
+		} // end for
+		std::sort(sorted.begin(), sorted.end());
+
+		sortedNets.resize(sorted.size());
+		sortedIndexes.resize(sorted.size());
+		for (int i = 0; i < (int) sorted.size(); i++) {
+			sortedIndexes[i] = std::get<0>(sorted[i]);
+			sortedNets[i] = std::get<1>(sorted[i]);
+		} // end for
+
+		moduleData->topologicalOrderInitialized = true;
+		moduleData->reverseTopologicalOrderDirty = true;
+		return;
+	} // end if
+
+	if (dirtyNets.empty())
+		return;
+
+	// Incremental repair: the nets whose index may have changed are sorted
+	// and merged with the remaining (still sorted) nets.
+	std::vector<std::tuple<TopologicalIndex, Net>> updated;
+	updated.reserve(dirtyNets.size());
+	for (Rsyn::Net net : dirtyNets) {
+		updated.push_back(std::make_tuple(net.getTopologicalIndex(), net));
 	} // end for
-	sortedNets.resize(i);
-	std::sort(sortedNets.begin(), sortedNets.end());
-		
-	return sortedNets;
+	std::sort(updated.begin(), updated.end());
+
+	const int numNets = (int) sortedNets.size();
+	const int numUpdated = (int) updated.size();
+
+	std::vector<Net> mergedNets;
+	std::vector<TopologicalIndex> mergedIndexes;
+	mergedNets.reserve(numNets + numUpdated);
+	mergedIndexes.reserve(numNets + numUpdated);
+
+	int k = 0;
+	for (int i = 0; i < numNets; i++) {
+		const Net net = sortedNets[i];
+		if (net->dirtyTopologicalIndex)
+			continue;
+
+		const std::tuple<TopologicalIndex, Net> current =
+				std::make_tuple(sortedIndexes[i], net);
+		while (k < numUpdated && updated[k] < current) {
+			mergedIndexes.push_back(std::get<0>(updated[k]));
+			mergedNets.push_back(std::get<1>(updated[k]));
+			k++;
+		} // end while
+		mergedIndexes.push_back(sortedIndexes[i]);
+		mergedNets.push_back(net);
+	} // end for
+
+	for (; k < numUpdated; k++) {
+		mergedIndexes.push_back(std::get<0>(updated[k]));
+		mergedNets.push_back(std::get<1>(updated[k]));
+	} // end for
+
+	for (Rsyn::Net net : dirtyNets) {
+		net->dirtyTopologicalIndex = false;
+	} // end for
+	dirtyNets.clear();
+
+	sortedNets.swap(mergedNets);
+	sortedIndexes.swap(mergedIndexes);
+	moduleData->reverseTopologicalOrderDirty = true;
 } // end method
 
 // -----------------------------------------------------------------------------
 
 inline
-std::vector<TupleElement<1, TopologicalIndex, Net>>
+const std::vector<Net> &
+Module::allNetsInTopologicalOrder() {
+	updateNetsInTopologicalOrder();
+	return data->moduleData->netsInTopologicalOrder;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+inline
+const std::vector<Net> &
 Module::allNetsInReverseTopologicalOrder() {
-	const int numNets = data->moduleData->nets.size();
-	
-	std::vector<TupleElement<1, TopologicalIndex, Net>> sortedNets;
-	sortedNets.resize(numNets);
-	
-	int i = 0;
-	for (Rsyn::Net net : allNets()) {
-		sortedNets[i++] = std::make_tuple(-net.getTopologicalIndex(), net);
-	} // end for
-	sortedNets.resize(i);
-	std::sort(sortedNets.begin(), sortedNets.end());
-		
-	return sortedNets;
+	updateNetsInTopologicalOrder();
+
+	ModuleData * moduleData = data->moduleData;
+	if (moduleData->reverseTopologicalOrderDirty) {
+		const std::vector<Net> &sortedNets = moduleData->netsInTopologicalOrder;
+		const std::vector<TopologicalIndex> &sortedIndexes = moduleData->netsTopologicalIndex;
+		std::vector<Net> &reverseNets = moduleData->netsInReverseTopologicalOrder;
+
+		// Reverse the order of the groups of nets with the same topological
+		// index, but keep the order of the nets inside each group.
+		reverseNets.clear();
+		reverseNets.reserve(sortedNets.size());
+
+		int end = (int) sortedNets.size();
+		while (end > 0) {
+			int begin = end - 1;
+			while (begin > 0 && sortedIndexes[begin - 1] == sortedIndexes[end - 1]) {
+				begin--;
+			} // end while
+			reverseNets.insert(reverseNets.end(),
+					sortedNets.begin() + begin, sortedNets.begin() + end);
+			end = begin;
+		} // end while
+
+		moduleData->reverseTopologicalOrderDirty = false;
+	} // end if
+
+	return moduleData->netsInReverseTopologicalOrder;
 } // end method
 
 // -----------------------------------------------------------------------------
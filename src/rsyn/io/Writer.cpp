@@ -25,8 +25,12 @@
 #include "rsyn/phy/PhysicalService.h"
 #include "rsyn/model/timing/Timer.h"
 #include "rsyn/model/routing/RoutingEstimator.h"
+#include "rsyn/model/routing/DefaultRoutingExtractionModel.h"
+#include "rsyn/model/scenario/Scenario.h"
 
 #include "rsyn/io/parser/lef_def/DEFControlParser.h"
+#include "rsyn/io/parser/snapshot/SnapshotParser.h"
+#include "rsyn/util/Stepwatch.h"
 namespace Rsyn {
 
 void Writer::start(const Json &params) {
@@ -64,6 +68,24 @@ void Writer::start(const Json &params) {
 		}); // end command 
 	} // end block
 
+	{ // writeSnapshot
+		ScriptParsing::CommandDescriptor dscp;
+		dscp.setName("writeSnapshot");
+		dscp.setDescription("Write a binary snapshot of the design. It can be "
+				"loaded back with: open snapshot {\"file\": \"<fileName>\"}");
+
+		dscp.addPositionalParam("fileName",
+			ScriptParsing::PARAM_TYPE_STRING,
+			ScriptParsing::PARAM_SPEC_OPTIONAL,
+			"Snapshot file name.",
+			"");
+
+		session.registerCommand(dscp, [&](const ScriptParsing::Command & command) {
+			const std::string fileName = command.getParam("fileName");
+			writeSnapshot(fileName != "" ? fileName : clsDesign.getName() + ".snapshot");
+		}); // end command 
+	} // end block
+
 	{ // writeVerilog
 		ScriptParsing::CommandDescriptor dscp;
 		dscp.setName("writeVerilog");
@@ -167,16 +189,28 @@ void Writer::writeFullDEF(string filename) {
 	def.clsDatabaseUnits = clsPhysicalDesign.getDatabaseUnits(Rsyn::DESIGN_DBU);
 	def.clsDesignName = clsDesign.getName();
 
+	buildDefComponents(def.clsComps);
+	buildDefNets(def.clsNets);
+	buildDefPorts(def.clsPorts);
+	buildDefRows(def.clsRows);
+	buildDefTracks(def.clsTracks);
+
+	defParser.writeFullDEF(filename, def);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Writer::buildDefComponents(std::vector<DefComponentDscp> &components) {
 	int numCells = clsDesign.getNumInstances(Rsyn::CELL);
-	def.clsComps.reserve(numCells);
+	components.reserve(numCells);
 	for (Rsyn::Instance instance : clsModule.allInstances()) {
 		if(instance.getType() != Rsyn::CELL)
 			continue;
 
 		Rsyn::Cell cell = instance.asCell(); // TODO: hack, assuming that the instance is a cell
 		PhysicalCell ph = clsPhysicalDesign.getPhysicalCell(cell);
-		def.clsComps.push_back(DefComponentDscp());
-		DefComponentDscp &defComp = def.clsComps.back();
+		components.push_back(DefComponentDscp());
+		DefComponentDscp &defComp = components.back();
 		defComp.clsName = cell.getName();
 		defComp.clsMacroName = cell.getLibraryCellName();
 		defComp.clsPos = ph.getPosition();
@@ -184,40 +218,17 @@ void Writer::writeFullDEF(string filename) {
 		defComp.clsOrientation = Rsyn::getPhysicalOrientation(ph.getOrientation());
 		defComp.clsIsPlaced = ph.isPlaced();
 	} // end for 
+} // end method
 
+// -----------------------------------------------------------------------------
 
-	int numNets = clsDesign.getNumNets();
-	def.clsNets.reserve(numNets);
-	for (Rsyn::Net net : clsModule.allNets()) {
-		def.clsNets.push_back(DefNetDscp());
-		DefNetDscp & defNet = def.clsNets.back();
-		defNet.clsName = net.getName();
-		defNet.clsConnections.reserve(net.getNumPins());
-		for (Rsyn::Pin pin : net.allPins()) {
-			if (!pin.isPort())
-				continue;
-			defNet.clsConnections.push_back(DefNetConnection());
-			DefNetConnection & netConnection = defNet.clsConnections.back();
-			netConnection.clsComponentName = "PIN";
-			netConnection.clsPinName = pin.getInstanceName();
-		} // end for 
-		for (Rsyn::Pin pin : net.allPins()) {
-			if (pin.isPort())
-				continue;
-			defNet.clsConnections.push_back(DefNetConnection());
-			DefNetConnection & netConnection = defNet.clsConnections.back();
-			netConnection.clsComponentName = pin.getInstanceName();
-			netConnection.clsPinName = pin.getName();
-		} // end for
-	} // end for
-
-
+void Writer::buildDefPorts(std::vector<DefPortDscp> &ports) {
 	int numPorts = clsModule.getNumPorts(Rsyn::IN) + clsModule.getNumPorts(Rsyn::OUT);
-	def.clsPorts.reserve(numPorts);
+	ports.reserve(numPorts);
 	for (Rsyn::Port port : clsModule.allPorts()) {
 		Rsyn::PhysicalPort phPort = clsPhysicalDesign.getPhysicalPort(port);
-		def.clsPorts.push_back(DefPortDscp());
-		DefPortDscp & defPort = def.clsPorts.back();
+		ports.push_back(DefPortDscp());
+		DefPortDscp & defPort = ports.back();
 		defPort.clsName = port.getName();
 		defPort.clsNetName = port.getName();
 		if (port.getDirection() == Rsyn::IN)
@@ -225,19 +236,27 @@ void Writer::writeFullDEF(string filename) {
 		else if (port.getDirection() == Rsyn::OUT)
 			defPort.clsDirection = "OUTPUT";
 
+		// Ports created after the design was loaded have no physical data.
+		Rsyn::PhysicalLayer phLayer = phPort.getLayer();
+		if (!phLayer)
+			continue;
+
 		defPort.clsLocationType = "FIXED";
 		defPort.clsOrientation = Rsyn::getPhysicalOrientation(phPort.getOrientation());
-		defPort.clsLayerName = phPort.getLayer().getName();
+		defPort.clsLayerName = phLayer.getName();
 		defPort.clsLayerBounds = phPort.getBounds();
 		defPort.clsPos = phPort.getPosition();
-
 	} // end for 
- 
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Writer::buildDefRows(std::vector<DefRowDscp> &rows) {
 	int numRows = clsPhysicalDesign.getNumRows();
-	def.clsRows.reserve(numRows);
+	rows.reserve(numRows);
 	for (Rsyn::PhysicalRow phRow : clsPhysicalDesign.allPhysicalRows()) {
-		def.clsRows.push_back(DefRowDscp());
-		DefRowDscp & defRow = def.clsRows.back();
+		rows.push_back(DefRowDscp());
+		DefRowDscp & defRow = rows.back();
 		defRow.clsName = phRow.getName();
 		defRow.clsSite = phRow.getSiteName();
 		defRow.clsOrigin = phRow.getOrigin();
@@ -247,24 +266,168 @@ void Writer::writeFullDEF(string filename) {
 		defRow.clsNumY = phRow.getNumSites(Y);
 		defRow.clsOrientation = Rsyn::getPhysicalOrientation(phRow.getSiteOrientation());
 	} // end for 
-	
-	// write def tracks 
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Writer::buildDefTracks(std::vector<DefTrackDscp> &tracks) {
 	int numTracks = clsPhysicalDesign.getNumPhysicalTracks();
-	def.clsTracks.reserve(numTracks);
-	for(Rsyn::PhysicalTrack phTrack : clsPhysicalDesign.allPhysicalTracks()){
-		def.clsTracks.push_back(DefTrackDscp());
-		DefTrackDscp & defTrack = def.clsTracks.back();
+	tracks.reserve(numTracks);
+	for (Rsyn::PhysicalTrack phTrack : clsPhysicalDesign.allPhysicalTracks()) {
+		tracks.push_back(DefTrackDscp());
+		DefTrackDscp & defTrack = tracks.back();
 		defTrack.clsDirection = getDimension(phTrack.getDirection());
 		defTrack.clsLocation = phTrack.getLocation();
 		defTrack.clsSpace = phTrack.getSpace();
 		int numLayers = phTrack.getNumberOfLayers();
 		defTrack.clsLayers.reserve(numLayers);
-		for(Rsyn::PhysicalLayer phLayer : phTrack.allLayers())
+		for (Rsyn::PhysicalLayer phLayer : phTrack.allLayers())
 			defTrack.clsLayers.push_back(phLayer.getName());
 		defTrack.clsNumTracks = phTrack.getNumberOfTracks();
 	} // end for 
-	
-	defParser.writeFullDEF(filename, def);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Writer::buildDefWires(Rsyn::Net net, std::vector<DefWireDscp> &wires) {
+	Rsyn::PhysicalNet phNet = clsPhysicalDesign.getPhysicalNet(net);
+	wires.reserve(phNet.allWires().size());
+	for (Rsyn::PhysicalWire phWire : phNet.allWires()) {
+		wires.push_back(DefWireDscp());
+		DefWireDscp & defWire = wires.back();
+		defWire.clsWireSegments.reserve(phWire.allSegments().size());
+		for (Rsyn::PhysicalWireSegment phSegment : phWire.allSegments()) {
+			defWire.clsWireSegments.push_back(DefWireSegmentDscp());
+			DefWireSegmentDscp & defSegment = defWire.clsWireSegments.back();
+			defSegment.clsLayerName = phSegment.getLayer().getName();
+			defSegment.clsNew = phSegment.isNew();
+			defSegment.clsRoutingPoints.reserve(phSegment.getNumRoutingPoints());
+			for (Rsyn::PhysicalRoutingPoint phPoint : phSegment.allRoutingPoints()) {
+				defSegment.clsRoutingPoints.push_back(DefRoutingPointDscp());
+				DefRoutingPointDscp & defPoint = defSegment.clsRoutingPoints.back();
+				defPoint.clsPos = phPoint.getPosition();
+				defPoint.clsExtension = phPoint.getExtension();
+				defPoint.clsOrientation = Rsyn::getPhysicalOrientation(phPoint.getOrientation());
+				if (phPoint.hasVia()) {
+					defPoint.clsHasVia = true;
+					defPoint.clsViaName = phPoint.getVia().getName();
+				} // end if
+				if (phPoint.hasRectangle()) {
+					defPoint.clsHasRectangle = true;
+					defPoint.clsRect = phPoint.getRectangle();
+				} // end if
+			} // end for
+		} // end for
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Writer::buildDefNets(std::vector<DefNetDscp> &nets, const bool includeWires) {
+	int numNets = clsDesign.getNumNets();
+	nets.reserve(numNets);
+	for (Rsyn::Net net : clsModule.allNets()) {
+		nets.push_back(DefNetDscp());
+		DefNetDscp & defNet = nets.back();
+		defNet.clsName = net.getName();
+		defNet.clsConnections.reserve(net.getNumPins());
+		for (Rsyn::Pin pin : net.allPins()) {
+			if (!pin.isPort())
+				continue;
+			defNet.clsConnections.push_back(DefNetConnection());
+			DefNetConnection & netConnection = defNet.clsConnections.back();
+			netConnection.clsComponentName = "PIN";
+			netConnection.clsPinName = pin.getInstanceName();
+		} // end for 
+		for (Rsyn::Pin pin : net.allPins()) {
+			if (pin.isPort())
+				continue;
+			defNet.clsConnections.push_back(DefNetConnection());
+			DefNetConnection & netConnection = defNet.clsConnections.back();
+			netConnection.clsComponentName = pin.getInstanceName();
+			netConnection.clsPinName = pin.getName();
+		} // end for
+		if (includeWires)
+			buildDefWires(net, defNet.clsWires);
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Writer::writeSnapshot(const std::string &filename) {
+	Stepwatch watch("Writing snapshot");
+
+	SnapshotDscp snapshot;
+	snapshot.clsDesignName = clsDesign.getName();
+
+	// Library cells are stored as in Rsyn (i.e. including the timing arcs
+	// when they were loaded from Liberty).
+	for (Rsyn::LibraryCell lcell : clsDesign.allLibraryCells()) {
+		snapshot.clsLibraryCells.push_back(SnapshotLibraryCellDscp());
+		SnapshotLibraryCellDscp &cellDscp = snapshot.clsLibraryCells.back();
+		cellDscp.clsName = lcell.getName();
+		cellDscp.clsPins.resize(lcell.getNumPins());
+		for (int i = 0; i < lcell.getNumPins(); i++) {
+			Rsyn::LibraryPin lpin = lcell.getLibraryPinByIndex(i);
+			cellDscp.clsPins[i].clsName = lpin.getName();
+			cellDscp.clsPins[i].clsDirection = lpin.getDirection();
+		} // end for
+		for (Rsyn::LibraryArc larc : lcell.allLibraryArcs()) {
+			cellDscp.clsArcs.push_back(SnapshotLibraryArcDscp());
+			SnapshotLibraryArcDscp &arcDscp = cellDscp.clsArcs.back();
+			arcDscp.clsFromPinName = larc.getFromName();
+			arcDscp.clsToPinName = larc.getToName();
+		} // end for
+	} // end for
+
+	// The library and a few design sections (e.g. vias, special nets) are only
+	// kept by the physical design when snapshots are enabled. Everything else
+	// is rebuilt from the current state of the design.
+	if (!clsPhysicalDesign.isEnableSnapshots()) {
+		throw Exception("Snapshots are not enabled. Run \"set enableSnapshots "
+				"true\" before loading the design.");
+	} // end if
+
+	snapshot.clsHasPhysicalDesign = true;
+	snapshot.clsEnablePhysicalPins = clsPhysicalDesign.isEnablePhysicalPins();
+	snapshot.clsEnableMergeRectangles = clsPhysicalDesign.isEnableMergeRectangles();
+	snapshot.clsEnableNetPinBoundaries = clsPhysicalDesign.isEnableNetPinBoundaries();
+	if (clsPhysicalDesign.getClockNet())
+		snapshot.clsClockNetName = clsPhysicalDesign.getClockNet().getName();
+	snapshot.clsLefDscps = clsPhysicalDesign.getLibraryDescriptors();
+
+	DefDscp &def = snapshot.clsDefDscp;
+	def = clsPhysicalDesign.getStaticDesignDescriptor();
+	def.clsDesignName = clsDesign.getName();
+	def.clsDieBounds = clsPhysicalDesign.getPhysicalDie().getBounds();
+	def.clsDatabaseUnits = clsPhysicalDesign.getDatabaseUnits(Rsyn::DESIGN_DBU);
+	buildDefComponents(def.clsComps);
+	buildDefNets(def.clsNets, true);
+	buildDefPorts(def.clsPorts);
+	buildDefRows(def.clsRows);
+	buildDefTracks(def.clsTracks);
+
+	// Timing inputs. The timer itself is not stored: it is rebuilt from them
+	// when the snapshot is loaded.
+	Rsyn::Session session;
+	Rsyn::Scenario *scenario = session.getService("rsyn.scenario", Rsyn::SERVICE_OPTIONAL);
+	if (scenario && clsRoutingEstimator && scenario->hasDescriptors()) {
+		DefaultRoutingExtractionModel *extractionModel =
+				session.getService("rsyn.defaultRoutingExtractionModel", Rsyn::SERVICE_OPTIONAL);
+		if (extractionModel) {
+			snapshot.clsHasTiming = true;
+			snapshot.clsEnableRSTT = session.isServiceRunning("rsyn.RSTTroutingEstimationModel");
+			snapshot.clsWireResistancePerDBU = extractionModel->getLocalWireResPerUnitLength();
+			snapshot.clsWireCapacitancePerDBU = extractionModel->getLocalWireCapPerUnitLength();
+			snapshot.clsMaxWireSegmentLength = extractionModel->getMaxWireSegmentLength();
+			snapshot.clsLibInfoEarly = scenario->getLibraryDescriptor(Rsyn::EARLY);
+			snapshot.clsLibInfoLate = scenario->getLibraryDescriptor(Rsyn::LATE);
+			snapshot.clsSdcInfo = scenario->getConstraintDescriptor();
+		} // end if
+	} // end if
+
+	SnapshotParser parser;
+	parser.write(filename, snapshot);
 } // end method
 
 // -----------------------------------------------------------------------------
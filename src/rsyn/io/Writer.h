@@ -64,10 +64,19 @@ public:
 	void writeBookshelf2(const std::string &path = ".");
 	void writePlacedBookshelf(const std::string & path = ".");
 	void writeSPEFFile(ostream &out, const bool onlyFixed = false);
+	void writeSnapshot(const std::string &filename);
 
 	// Debug function. Should be rethought...
 	void printTimingPropagation(ostream &out, bool newLine = false);
 
+private:
+	void buildDefComponents(std::vector<DefComponentDscp> &components);
+	void buildDefNets(std::vector<DefNetDscp> &nets, const bool includeWires = false);
+	void buildDefWires(Rsyn::Net net, std::vector<DefWireDscp> &wires);
+	void buildDefPorts(std::vector<DefPortDscp> &ports);
+	void buildDefRows(std::vector<DefRowDscp> &rows);
+	void buildDefTracks(std::vector<DefTrackDscp> &tracks);
+
 }; // end class
 
 } // end namespace
@@ -105,12 +105,12 @@ bool BookshelfParser::tryReadString( std::string &value ) {
 // -----------------------------------------------------------------------------
 
 bool BookshelfParser::tryReadKeyword( const std::string &keyword ) {
-	std::string token;
+	Rsyn::StringRef token;
 	if ( !tryNextToken( token ) )
 		return false;
 
 	if ( token != keyword )
-		parsingError( "Expecting '" + keyword + "' got '" + token + "'." );
+		parsingError( "Expecting '" + keyword + "' got '" + token.str() + "'." );
 
 	return true;
 } // end method
@@ -124,11 +124,9 @@ bool BookshelfParser::tryReadColon() {
 // -----------------------------------------------------------------------------
 
 bool BookshelfParser::tryReadInteger( int &value ) {
-	std::string token;
+	Rsyn::StringRef token;
 	if ( tryNextToken( token ) ) {
-		std::istringstream iss( token );
-		iss >> value;
-		return !iss.fail();
+		return Rsyn::TextTokenizer::toInt( token, value );
 	} else {
 		return false;
 	} // end else
@@ -137,11 +135,9 @@ bool BookshelfParser::tryReadInteger( int &value ) {
 // -----------------------------------------------------------------------------
 
 bool BookshelfParser::tryReadDouble( double &value ) {
-	std::string token;
+	Rsyn::StringRef token;
 	if ( tryNextToken( token ) ) {
-		std::istringstream iss( token );
-		iss >> value;
-		return !iss.fail();
+		return Rsyn::TextTokenizer::toDouble( token, value );
 	} else {
 		return false;
 	} // end else
@@ -153,11 +149,7 @@ bool BookshelfParser::openFile( const std::string &filename ) {
 	clsCurrentFilename = filename;
 	clsCurrentLine = 0;
 
-	if ( clsCurrentFile.is_open() )
-		clsCurrentFile.close();
-
-	clsCurrentFile.open( filename.c_str() );
-	if ( !clsCurrentFile )
+	if ( !clsCurrentFile.open( filename ) )
 		throw std::string( "File could not be opened!" );
 
 	return tryNextLine(false,true);
@@ -166,7 +158,17 @@ bool BookshelfParser::openFile( const std::string &filename ) {
 // -----------------------------------------------------------------------------
 
 bool BookshelfParser::tryNextToken( std::string &token ) {
-	if ( clsCurrentToken >= clsTokens.size() )
+	Rsyn::StringRef ref;
+	if ( !tryNextToken( ref ) )
+		return false;
+	token.assign( ref.data(), ref.size() );
+	return true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+bool BookshelfParser::tryNextToken( Rsyn::StringRef &token ) {
+	if ( clsCurrentToken >= (int) clsTokens.size() )
 		return false;
 	token = clsTokens[clsCurrentToken++];
 	return true;
@@ -175,7 +177,7 @@ bool BookshelfParser::tryNextToken( std::string &token ) {
 // -----------------------------------------------------------------------------
 
 bool BookshelfParser::tryNextLine( const bool skipDummyLines, const bool tokenize ) {
-	std::string line;
+	Rsyn::StringRef line;
 	bool retry;
 
 	clsTokens.clear();
@@ -184,38 +186,30 @@ bool BookshelfParser::tryNextLine( const bool skipDummyLines, const bool tokeniz
 	do {
 		retry = false;
 
-		getline( clsCurrentFile, line );
-
-		if ( clsCurrentFile.bad() )
-			parsingError( "Can't read from the file." );
-
-		if ( clsCurrentFile.fail() )
+		if ( !clsCurrentFile.nextLine( line ) )
 			return false;
 
 		if ( skipDummyLines ) {
 			// Skip empty lines.
-			if ( line.size() == 0 )
+			if ( line.empty() )
 				retry = true;
 
 			// Skip comment lines.
-			if ( line[0] == '#' )
+			else if ( line[0] == '#' )
 				retry = true;
 
 			// Skip blank lines.
-			if ( line.find_first_not_of( ' ' ) == std::string::npos )
+			else if ( std::find_if( line.begin(), line.end(),
+					[]( const char c ) { return c != ' '; } ) == line.end() )
 				retry = true;
 		} // end if
-
-		clsCurrentLine++;
 	} while ( retry );
 
+	clsCurrentLine = clsCurrentFile.getLineNumber();
+
 	// Tokenize
 	if ( tokenize ) {
-		std::istringstream iss( line );
-
-		std::string token;
-		while ( iss >> token )
-			clsTokens.push_back(token);
+		clsCurrentFile.split( line, clsTokens );
 	} else {
 		clsTokens.push_back( line );
 	} // end else
@@ -17,6 +17,7 @@
 #define	BOOKSHELF_PARSER_H
 
 #include "rsyn/phy/util/BookshelfDscp.h"
+#include "rsyn/util/TextTokenizer.h"
 
 #include <string>
 #include <fstream>
@@ -30,11 +31,11 @@ private:
 	std::string clsBaseFilename; // obtained from aux filename
 	std::string clsPath; // path to aux file (without filename)	
 	
-	std::ifstream      clsCurrentFile;
+	Rsyn::TextTokenizer clsCurrentFile;
 	std::string        clsCurrentFilename; // the file currently being parsed
 	int           clsCurrentLine;
 	
-	std::vector<std::string> clsTokens;
+	std::vector<Rsyn::StringRef> clsTokens;
 	int clsCurrentToken;
 
 	std::string clsFilenameNodes;
@@ -58,6 +59,7 @@ private:
 	void nextLine( const bool skipDummyLines = true, const bool tokenize = true ); // dummy lines = comment lines, blank lines
 	bool tryNextLine( const bool skipDummyLines = true, const bool tokenize = true ); // dummy lines = comment lines, blank lines
 	bool tryNextToken( std::string &token );
+	bool tryNextToken( Rsyn::StringRef &token );
 
 	void readSign( const std::string &sign );
 	void readString( std::string &value );
@@ -18,13 +18,12 @@
 #include "rsyn/io/parser/guide-ispd18/GuideParser.h"
 
 void GuideParser::parse(std::string& guidePath, GuideDscp& guideDscp) {
-	clsIS.open(guidePath.c_str());
-	if (!clsIS.is_open()) {
+	if (!clsIS.open(guidePath)) {
 		std::cout << "[ERROR] File '" << guidePath << "' could not be opened.\n";
 		exit(1);
 	} // end if
 
-	while (!clsIS.eof()) {
+	while (!clsIS.atEnd()) {
 		std::string netName;
 		if(!readNet(netName))
 			continue;
@@ -39,58 +38,39 @@ void GuideParser::parse(std::string& guidePath, GuideDscp& guideDscp) {
 
 // -----------------------------------------------------------------------------
 
-bool GuideParser::readLine(std::vector<std::string>& tokens) {
-	tokens.clear();
-	std::string line;
-	std::getline(clsIS, line);
-	std::string token = "";
-
-	for (unsigned i = 0; i < line.size(); ++i) {
-		char current = line[i];
-		if (std::isspace(current)) {
-			if (!token.empty()) {
-				tokens.push_back(token);
-				token.clear();
-			} // end if 
-		} else {
-			token.push_back(current);
-		} //vend if-else 
-	} // end for 
-	if (!token.empty())
-		tokens.push_back(token);
-
-	return !clsIS.eof();
+bool GuideParser::readLine(std::vector<Rsyn::StringRef>& tokens) {
+	return clsIS.nextLine(tokens);
 } // end method 
 
 // -----------------------------------------------------------------------------
 
 bool GuideParser::readNet(std::string & net) {
-	std::vector<std::string> tokens;
-	readLine(tokens);
-	if (tokens.empty())
+	readLine(clsTokens);
+	if (clsTokens.empty())
 		return false;
-	net = tokens.front();
+	net = clsTokens.front().str();
 	return true;
 } // end method 
 
 // -----------------------------------------------------------------------------
 
-bool GuideParser::isStartLayer(std::string & token) {
-	return token.compare("(") == 0;
+bool GuideParser::isStartLayer(const Rsyn::StringRef & token) {
+	return token == "(";
 } // end method 
 
 // -----------------------------------------------------------------------------
 
-bool GuideParser::isEndLayer(std::string & token) {
-	return token.compare(")") == 0;
+bool GuideParser::isEndLayer(const Rsyn::StringRef & token) {
+	return token == ")";
 } // end method 
 
 // -----------------------------------------------------------------------------
 
 bool GuideParser::readLayerGuide(GuideNetDscp & dscp) {
-	while (true) {
-		std::vector<std::string> tokens;
-		readLine(tokens);
+	std::vector<Rsyn::StringRef> & tokens = clsTokens;
+	while (readLine(tokens)) {
+		if (tokens.empty())
+			continue;
 		if (isStartLayer(tokens.front()))
 			continue;
 		if (isEndLayer(tokens.front()))
@@ -100,17 +80,28 @@ bool GuideParser::readLayerGuide(GuideNetDscp & dscp) {
 				<<". The guide definition has less then four points or it do not has defined the layer name.\n";
 			continue;
 		} // end if 
+
+		int coordinates[4];
+		bool valid = true;
+		for (int i = 0; i < 4; i++) {
+			valid &= Rsyn::TextTokenizer::toInt(tokens[i], coordinates[i]);
+		} // end for
+		if (!valid) {
+			std::cout<<"WARNING: skipping parsing a layer guide of net "<<dscp.clsNetName
+				<<". The guide definition has invalid coordinates.\n";
+			continue;
+		} // end if
 			
 		dscp.clsLayerDscps.push_back(GuideLayerDscp());
 		GuideLayerDscp & layer = dscp.clsLayerDscps.back();
 		Bounds & bds = layer.clsLayerGuide;
-		bds[LOWER][X] = std::stoi(tokens[0]);
-		bds[LOWER][Y] = std::stoi(tokens[1]);
-		bds[UPPER][X] = std::stoi(tokens[2]);
-		bds[UPPER][Y] = std::stoi(tokens[3]);
-		layer.clsLayer = tokens[4];
+		bds[LOWER][X] = coordinates[0];
+		bds[LOWER][Y] = coordinates[1];
+		bds[UPPER][X] = coordinates[2];
+		bds[UPPER][Y] = coordinates[3];
+		layer.clsLayer = tokens[4].str();
 	} // end while 
 	return false;
 } // end method 
 
-// -----------------------------------------------------------------------------
\ No newline at end of file
+// -----------------------------------------------------------------------------
@@ -16,10 +16,10 @@
 
 #ifndef ISPD18GUIDEPARSER_H
 #define	ISPD18GUIDEPARSER_H
-#include <fstream>
 #include <vector>
 #include "GuideDescriptor.h"
 #include "rsyn/util/Bounds.h"
+#include "rsyn/util/TextTokenizer.h"
 /*net1230
 (
 95010 71819 100710 91201 Metal2
@@ -34,16 +34,17 @@
 
 class GuideParser {
 protected:
-	 std::ifstream clsIS;
+	 Rsyn::TextTokenizer clsIS;
+	 std::vector<Rsyn::StringRef> clsTokens;
 public:
 	GuideParser() = default;
 	void parse(std::string & guidePath, GuideDscp & guideDscp);
 	
 protected:
-	bool readLine(std::vector<std::string>& tokens);
+	bool readLine(std::vector<Rsyn::StringRef>& tokens);
 	bool readNet(std::string & net);
-	bool isStartLayer(std::string & token);
-	bool isEndLayer(std::string & token);
+	bool isStartLayer(const Rsyn::StringRef & token);
+	bool isEndLayer(const Rsyn::StringRef & token);
 	bool readLayerGuide(GuideNetDscp & dscp);
 	
 };
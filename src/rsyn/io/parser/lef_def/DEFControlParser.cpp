@@ -14,6 +14,7 @@
  */
 
 #include "DEFControlParser.h"
+#include <algorithm>
 
 #ifndef WIN32
 #include <unistd.h>
@@ -60,10 +61,12 @@ char* defAddress(const char* in);
 void defCheckType(defrCallbackType_e c);
 int defCompf(defrCallbackType_e c, defiComponent* co, defiUserData ud);
 int defComponentStart(defrCallbackType_e c, int num, defiUserData ud);
+int defComponentEnd(defrCallbackType_e c, void* dummy, defiUserData ud);
 int defDesignName(defrCallbackType_e c, const char* string, defiUserData ud);
 int defEndFunc(defrCallbackType_e c, void* dummy, defiUserData ud);
 int defExt(defrCallbackType_e t, const char* c, defiUserData ud);
 int defNetStart(defrCallbackType_e c, int num, defiUserData ud);
+int defNetEnd(defrCallbackType_e c, void* dummy, defiUserData ud);
 int defNet(defrCallbackType_e c, defiNet* net, defiUserData ud);
 int defNetWire(defrCallbackType_e c, defiNet* net, defiUserData ud);
 int defUnits(defrCallbackType_e c, double d, defiUserData ud);
@@ -87,8 +90,48 @@ int defSpecialNet(defrCallbackType_e c, defiNet* net, defiUserData ud);
 int defViaStart(defrCallbackType_e, int number, defiUserData);
 int defVia(defrCallbackType_e, defiVia *, defiUserData);
 
+// Data passed to the callbacks. When a stream handler is set, components and
+// nets are handed over to it every batchSize entries.
+struct DefParserContext {
+	DefDscp *propDefDscp = nullptr;
+	DefStreamHandler *propHandler = nullptr;
+	int propBatchSize = 0;
+}; // end struct
+
+DefParserContext &getContextFromUserData(defiUserData userData) {
+	return *((DefParserContext *) userData);
+} // end function
+
 DefDscp &getDesignFromUserData(defiUserData userData) {
-	return *((DefDscp *) userData);
+	return *getContextFromUserData(userData).propDefDscp;
+} // end function
+
+// Returns the number of entries to reserve for a section with num entries.
+int getReserveSize(defiUserData userData, const int num) {
+	const DefParserContext &context = getContextFromUserData(userData);
+	return context.propHandler? std::min(num, context.propBatchSize) : num;
+} // end function
+
+void flushComponents(defiUserData userData, const bool force) {
+	DefParserContext &context = getContextFromUserData(userData);
+	DefDscp &defDscp = *context.propDefDscp;
+	if (!context.propHandler || defDscp.clsComps.empty())
+		return;
+	if (force || (int) defDscp.clsComps.size() >= context.propBatchSize) {
+		context.propHandler->onComponents(defDscp);
+		defDscp.clsComps.clear();
+	} // end if
+} // end function
+
+void flushNets(defiUserData userData, const bool force) {
+	DefParserContext &context = getContextFromUserData(userData);
+	DefDscp &defDscp = *context.propDefDscp;
+	if (!context.propHandler || defDscp.clsNets.empty())
+		return;
+	if (force || (int) defDscp.clsNets.size() >= context.propBatchSize) {
+		context.propHandler->onNets(defDscp);
+		defDscp.clsNets.clear();
+	} // end if
 } // end function
 
 // =============================================================================
@@ -96,6 +139,18 @@ DefDscp &getDesignFromUserData(defiUserData userData) {
 // =============================================================================
 
 void DEFControlParser::parseDEF(const std::string &filename, DefDscp &defDscp) {
+	parseDEF(filename, defDscp, nullptr);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void DEFControlParser::parseDEF(const std::string &filename, DefDscp &defDscp,
+	DefStreamHandler *handler, const int batchSize) {
+	DefParserContext context;
+	context.propDefDscp = &defDscp;
+	context.propHandler = handler;
+	context.propBatchSize = std::max(1, batchSize);
+
 	defrInit();
 	defrReset();
 
@@ -107,12 +162,14 @@ void DEFControlParser::parseDEF(const std::string &filename, DefDscp &defDscp) {
 	defrSetVersionCbk(defVersion);
 	defrSetRowCbk(defRow);
 	defrSetComponentStartCbk(defComponentStart);
+	defrSetComponentEndCbk(defComponentEnd);
 	defrSetDieAreaCbk(defDieArea);
 	defrSetMallocFunction(mallocCB);
 	defrSetReallocFunction(reallocCB);
 	defrSetFreeFunction(freeCB);
 	defrSetNetStartCbk(defNetStart);
 	defrSetNetCbk(defNet);
+	defrSetNetEndCbk(defNetEnd);
 
 
 	//defrSetSNetWireCbk();
@@ -154,7 +211,7 @@ void DEFControlParser::parseDEF(const std::string &filename, DefDscp &defDscp) {
 	}
 	// Set case sensitive to 0 to start with, in History & PropertyDefinition
 	// reset it to 1.
-	res = defrRead(f, filename.c_str(), (void*) &defDscp, 1);
+	res = defrRead(f, filename.c_str(), (void*) &context, 1);
 
 	if (res)
 		printf("Reader returns bad status. %s\n", filename.c_str());
@@ -256,6 +313,7 @@ int defCompf(defrCallbackType_e c, defiComponent* co, defiUserData ud) {
 	defComp.clsPos[Y] = co->placementY();
 	defComp.clsOrientation = co->placementOrientStr();
 
+	flushComponents(ud, false);
 	return 0;
 } // end method
 
@@ -263,7 +321,14 @@ int defCompf(defrCallbackType_e c, defiComponent* co, defiUserData ud) {
 
 int defComponentStart(defrCallbackType_e c, int num, defiUserData ud) {
 	DefDscp & defDscp = getDesignFromUserData(ud);
-	defDscp.clsComps.reserve(num);
+	defDscp.clsComps.reserve(getReserveSize(ud, num));
+	return 0;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+int defComponentEnd(defrCallbackType_e c, void* dummy, defiUserData ud) {
+	flushComponents(ud, true);
 	return 0;
 } // end method
 
@@ -271,7 +336,14 @@ int defComponentStart(defrCallbackType_e c, int num, defiUserData ud) {
 
 int defNetStart(defrCallbackType_e c, int num, defiUserData ud) {
 	DefDscp & defDscp = getDesignFromUserData(ud);
-	defDscp.clsNets.reserve(num);
+	defDscp.clsNets.reserve(getReserveSize(ud, num));
+	return 0;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+int defNetEnd(defrCallbackType_e c, void* dummy, defiUserData ud) {
+	flushNets(ud, true);
 	return 0;
 } // end method
 
@@ -419,6 +491,8 @@ int defNet(defrCallbackType_e c, defiNet* net, defiUserData ud) {
 			} // end while 
 		} // end for 
 	} // end for 
+
+	flushNets(ud, false);
 	return 0;
 } // end method
 
@@ -30,10 +30,26 @@
 	
 #include "rsyn/phy/util/DefDescriptors.h"
 
+// Receives the components and nets of a DEF file in bounded batches while the
+// file is being parsed, so that they do not need to be stored all at once.
+// The batch is stored in the descriptor (i.e. clsComps or clsNets) and is
+// cleared after the handler returns. The other sections (e.g. rows, pins,
+// vias) are kept in the descriptor as usual and the ones preceding the batch
+// in the file are already available.
+
+class DefStreamHandler {
+public:
+	virtual ~DefStreamHandler() = default;
+	virtual void onComponents(DefDscp &defDscp) = 0;
+	virtual void onNets(DefDscp &defDscp) = 0;
+}; // end class
+
 class DEFControlParser {
 public:
 	DEFControlParser();
 	void parseDEF(const std::string &filename, DefDscp &defDscp) ;
+	void parseDEF(const std::string &filename, DefDscp &defDscp,
+		DefStreamHandler *handler, const int batchSize = 4096);
 	void writeDEF(const std::string &filename, const std::string designName, const std::vector<DefComponentDscp> &components);
 	void writeFullDEF(const std::string &filename, const DefDscp & defDscp);
 	virtual ~DEFControlParser();
@@ -22,11 +22,22 @@
 
 #include <math.h>
 #include <limits>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <thread>
 
 #include "LibertyControlParser.h"
+#include "LibertySerialization.h"
+#include "rsyn/util/BinaryStream.h"
+#include "rsyn/util/MappedFile.h"
+#include "rsyn/util/MD5.h"
 
 LibertyControlParser::LibertyControlParser() {
 	print = false;
+	useCache = true;
 }
 
 LibertyControlParser::~LibertyControlParser() {
@@ -103,6 +114,43 @@ void LibertyControlParser::parseLiberty_LookUpTable(si2drGroupIdT &gtiming2, si2
 // -----------------------------------------------------------------------------
 
 void LibertyControlParser::parseLiberty(const string &filename, ISPD13::LIBInfo & lib) {
+	if (!useCache) {
+		parseLibertyFile(filename, lib);
+		return;
+	} // end if
+
+	const std::string hash = computeFileHash(filename);
+	if (hash.empty()) {
+		// Let the parser report the error.
+		parseLibertyFile(filename, lib);
+		return;
+	} // end if
+
+	// The library is parsed into a separate object so that the cache holds
+	// only the cells from this file even if lib already has cells.
+	ISPD13::LIBInfo fileLib;
+	fileLib.default_max_transition = lib.default_max_transition;
+	const std::string cacheFilename = getCacheFilename(filename);
+	if (readCache(cacheFilename, hash, fileLib)) {
+		std::cout << "Liberty library loaded from cache '" << cacheFilename << "'.\n";
+	} else {
+		parseLibertyFile(filename, fileLib);
+		writeCache(cacheFilename, hash, fileLib);
+	} // end else
+
+	lib.default_max_transition = fileLib.default_max_transition;
+	if (lib.libCells.empty()) {
+		std::swap(lib.libCells, fileLib.libCells);
+	} else {
+		lib.libCells.insert(lib.libCells.end(),
+				std::make_move_iterator(fileLib.libCells.begin()),
+				std::make_move_iterator(fileLib.libCells.end()));
+	} // end else
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void LibertyControlParser::parseLibertyFile(const string &filename, ISPD13::LIBInfo & lib) {
 	const bool debug = false;
 	const bool infoSkipping = debug || false;
 	
@@ -586,3 +634,125 @@ void LibertyControlParser::parseLiberty(const string &filename, ISPD13::LIBInfo
 	} // end if
 	
 } // end method
+
+// =============================================================================
+// Cache
+// =============================================================================
+
+using Rsyn::BinaryReader;
+using Rsyn::BinaryWriter;
+
+static const char LIBERTY_CACHE_MAGIC[8] = {'R', 'S', 'Y', 'N', 'L', 'I', 'B', 'C'};
+static const std::uint32_t LIBERTY_CACHE_BYTE_ORDER_MARK = 0x01020304;
+
+// Any change in the cache layout or in how the Liberty values are converted
+// to internal units requires increasing this version.
+static const std::uint32_t LIBERTY_CACHE_VERSION = 1;
+
+std::string LibertyControlParser::getCacheFilename(const string &filename) {
+	return filename + ".rsyncache";
+} // end method
+
+// -----------------------------------------------------------------------------
+
+std::string LibertyControlParser::computeFileHash(const string &filename) {
+	Rsyn::MappedFile file;
+	if (!file.open(filename))
+		return "";
+
+	// MD5::update takes a 32-bit length.
+	const std::size_t chunkSize = 1 << 30;
+
+	MD5 md5;
+	const char *data = file.begin();
+	std::size_t remaining = file.getSize();
+	while (remaining > 0) {
+		const std::size_t size = std::min(remaining, chunkSize);
+		md5.update(data, (MD5::size_type) size);
+		data += size;
+		remaining -= size;
+	} // end while
+	md5.finalize();
+	return md5.hexdigest();
+} // end method
+
+// -----------------------------------------------------------------------------
+
+bool LibertyControlParser::readCache(const string &cacheFilename, const std::string &hash, ISPD13::LIBInfo & lib) {
+	Rsyn::MappedFile file;
+	if (!file.open(cacheFilename))
+		return false;
+
+	try {
+		BinaryReader in(file.begin(), file.end());
+		if (in.getRemainingSize() < sizeof(LIBERTY_CACHE_MAGIC) ||
+				std::memcmp(in.readBytes(sizeof(LIBERTY_CACHE_MAGIC)),
+				LIBERTY_CACHE_MAGIC, sizeof(LIBERTY_CACHE_MAGIC)) != 0)
+			return false;
+		if (in.read<std::uint32_t>() != LIBERTY_CACHE_BYTE_ORDER_MARK)
+			return false;
+		if (in.read<std::uint32_t>() != LIBERTY_CACHE_VERSION)
+			return false;
+		if (in.read<std::string>() != hash)
+			return false;
+
+		ISPD13::LIBInfo cachedLib;
+		const int timePrefix = in.read<int>();
+		const int capacitancePrefix = in.read<int>();
+		const int leakagePowerPrefix = in.read<int>();
+		loadLibertyLibrary(in, cachedLib);
+		if (!in.atEnd())
+			return false;
+
+		unitPrefixForTime = (Rsyn::UnitPrefix) timePrefix;
+		unitPrefixForCapacitance = (Rsyn::UnitPrefix) capacitancePrefix;
+		unitPrefixForLeakagePower = (Rsyn::UnitPrefix) leakagePowerPrefix;
+		std::swap(lib, cachedLib);
+	} catch (const Exception &) {
+		// Truncated or corrupted cache.
+		return false;
+	} // end try-catch
+
+	return true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void LibertyControlParser::writeCache(const string &cacheFilename, const std::string &hash, const ISPD13::LIBInfo & lib) {
+	// Write to a temporary file and then rename it, so that concurrent runs
+	// never see a partially written cache.
+	const std::size_t uniqueId =
+			std::hash<std::thread::id>()(std::this_thread::get_id()) ^
+			(std::size_t) std::chrono::steady_clock::now().time_since_epoch().count();
+	const std::string temporaryFilename =
+			cacheFilename + ".tmp" + std::to_string(uniqueId);
+
+	bool success;
+	{
+		std::ofstream file(temporaryFilename, std::ios::binary);
+		if (!file) {
+			// The Liberty directory may be read-only, just run without cache.
+			if (print)
+				std::cout << "Unable to create Liberty cache '" << cacheFilename << "'.\n";
+			return;
+		} // end if
+
+		BinaryWriter out(file);
+		out.writeBytes(LIBERTY_CACHE_MAGIC, sizeof(LIBERTY_CACHE_MAGIC));
+		out.write(LIBERTY_CACHE_BYTE_ORDER_MARK);
+		out.write(LIBERTY_CACHE_VERSION);
+		out.write(hash);
+		out.write((int) unitPrefixForTime);
+		out.write((int) unitPrefixForCapacitance);
+		out.write((int) unitPrefixForLeakagePower);
+		saveLibertyLibrary(out, lib);
+		file.flush();
+		success = out.good();
+	} // end block
+
+	if (!success || std::rename(temporaryFilename.c_str(), cacheFilename.c_str()) != 0) {
+		std::remove(temporaryFilename.c_str());
+		if (print)
+			std::cout << "Unable to write Liberty cache '" << cacheFilename << "'.\n";
+	} // end if
+} // end method
@@ -76,6 +76,15 @@ private:
 	} // end if
 	
 	void parseLiberty_LookUpTable(si2drGroupIdT &gtiming2, si2drErrorT &err, ISPD13::LibParserLUT &lut, const LutType &lutType);
+	void parseLibertyFile(const string &filename, ISPD13::LIBInfo & lib);
+
+	// Binary cache of parsed libraries. The cache is stored next to the
+	// Liberty file and tagged with the MD5 of its contents, so that it is
+	// ignored (and rebuilt) when the Liberty file changes.
+	static std::string getCacheFilename(const string &filename);
+	static std::string computeFileHash(const string &filename);
+	bool readCache(const string &cacheFilename, const std::string &hash, ISPD13::LIBInfo & lib);
+	void writeCache(const string &cacheFilename, const std::string &hash, const ISPD13::LIBInfo & lib);
 	
 	std::map<std::string, LookUpTableTemplate> lutTemplates;
 	Rsyn::UnitPrefix unitPrefixForTime;
@@ -84,6 +93,7 @@ private:
 	
 public:
 	bool print;
+	bool useCache;
 	LibertyControlParser();
 	void parseLiberty(const string &filename, ISPD13::LIBInfo & lib);
 	virtual ~LibertyControlParser();
@@ -0,0 +1,203 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+
+#include "LibertySerialization.h"
+#include "rsyn/util/BinaryStream.h"
+
+using Rsyn::BinaryReader;
+using Rsyn::BinaryWriter;
+
+// Each descriptor is written field by field in declaration order and read
+// back in the same order. Any change here requires increasing the version of
+// the files that store Liberty data (Liberty cache and snapshots).
+
+template<typename T>
+static void save(BinaryWriter &out, const T &value) {
+	out.write(value);
+} // end function
+
+template<typename T>
+static void load(BinaryReader &in, T &value) {
+	in.read(value);
+} // end function
+
+static void save(BinaryWriter &out, const std::string &value) { out.write(value); }
+static void load(BinaryReader &in, std::string &value) { in.read(value); }
+
+static void save(BinaryWriter &out, const std::vector<double> &value);
+static void load(BinaryReader &in, std::vector<double> &value);
+static void save(BinaryWriter &out, const ISPD13::LibParserLUT &value);
+static void load(BinaryReader &in, ISPD13::LibParserLUT &value);
+static void save(BinaryWriter &out, const ISPD13::LibParserTimingInfo &value);
+static void load(BinaryReader &in, ISPD13::LibParserTimingInfo &value);
+static void save(BinaryWriter &out, const ISPD13::LibParserPinInfo &value);
+static void load(BinaryReader &in, ISPD13::LibParserPinInfo &value);
+static void save(BinaryWriter &out, const ISPD13::LibParserCellInfo &value);
+static void load(BinaryReader &in, ISPD13::LibParserCellInfo &value);
+
+template<typename T>
+static void save(BinaryWriter &out, const std::vector<T> &value) {
+	out.write((std::uint64_t) value.size());
+	for (const T &element : value) {
+		save(out, element);
+	} // end for
+} // end function
+
+template<typename T>
+static void load(BinaryReader &in, std::vector<T> &value) {
+	const std::uint64_t size = in.read<std::uint64_t>();
+	// Each element takes at least one byte, so this rejects corrupted sizes
+	// before trying to allocate memory for them.
+	if (size > in.getRemainingSize())
+		throw Exception("Invalid vector size in Liberty data.");
+	value.resize((std::size_t) size);
+	for (T &element : value) {
+		load(in, element);
+	} // end for
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const std::vector<double> &value) {
+	out.write((std::uint64_t) value.size());
+	out.writeBytes(value.data(), value.size() * sizeof(double));
+} // end function
+
+static void load(BinaryReader &in, std::vector<double> &value) {
+	const std::uint64_t size = in.read<std::uint64_t>();
+	if (size > in.getRemainingSize() / sizeof(double))
+		throw Exception("Invalid vector size in Liberty data.");
+	const std::size_t numBytes = (std::size_t) size * sizeof(double);
+	value.resize((std::size_t) size);
+	std::memcpy(value.data(), in.readBytes(numBytes), numBytes);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const ISPD13::LibParserLUT &value) {
+	save(out, value.isScalar);
+	save(out, value.loadIndices);
+	save(out, value.transitionIndices);
+	save(out, value.tableVals);
+} // end function
+
+static void load(BinaryReader &in, ISPD13::LibParserLUT &value) {
+	load(in, value.isScalar);
+	load(in, value.loadIndices);
+	load(in, value.transitionIndices);
+	load(in, value.tableVals);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const ISPD13::LibParserTimingInfo &value) {
+	save(out, value.fromPin);
+	save(out, value.toPin);
+	save(out, value.timingSense);
+	save(out, value.timingType);
+	save(out, value.fallDelay);
+	save(out, value.riseDelay);
+	save(out, value.fallTransition);
+	save(out, value.riseTransition);
+} // end function
+
+static void load(BinaryReader &in, ISPD13::LibParserTimingInfo &value) {
+	load(in, value.fromPin);
+	load(in, value.toPin);
+	load(in, value.timingSense);
+	load(in, value.timingType);
+	load(in, value.fallDelay);
+	load(in, value.riseDelay);
+	load(in, value.fallTransition);
+	load(in, value.riseTransition);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const ISPD13::LibParserPinInfo &value) {
+	save(out, value.name);
+	save(out, value.related);
+	save(out, value.capacitance);
+	save(out, value.maxCapacitance);
+	save(out, value.maxTransition);
+	save(out, value.isInput);
+	save(out, value.isClock);
+	save(out, value.isTimingEndpoint);
+	save(out, value.risingEdge);
+	save(out, value.riseSetup);
+	save(out, value.fallSetup);
+	save(out, value.riseHold);
+	save(out, value.fallHold);
+} // end function
+
+static void load(BinaryReader &in, ISPD13::LibParserPinInfo &value) {
+	load(in, value.name);
+	load(in, value.related);
+	load(in, value.capacitance);
+	load(in, value.maxCapacitance);
+	load(in, value.maxTransition);
+	load(in, value.isInput);
+	load(in, value.isClock);
+	load(in, value.isTimingEndpoint);
+	load(in, value.risingEdge);
+	load(in, value.riseSetup);
+	load(in, value.fallSetup);
+	load(in, value.riseHold);
+	load(in, value.fallHold);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const ISPD13::LibParserCellInfo &value) {
+	save(out, value.name);
+	save(out, value.footprint);
+	save(out, value.leakagePower);
+	save(out, value.area);
+	save(out, value.isSequential);
+	save(out, value.dontTouch);
+	save(out, value.isTieLow);
+	save(out, value.isTieHigh);
+	save(out, value.pins);
+	save(out, value.timingArcs);
+} // end function
+
+static void load(BinaryReader &in, ISPD13::LibParserCellInfo &value) {
+	load(in, value.name);
+	load(in, value.footprint);
+	load(in, value.leakagePower);
+	load(in, value.area);
+	load(in, value.isSequential);
+	load(in, value.dontTouch);
+	load(in, value.isTieLow);
+	load(in, value.isTieHigh);
+	load(in, value.pins);
+	load(in, value.timingArcs);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+void saveLibertyLibrary(BinaryWriter &out, const ISPD13::LIBInfo &lib) {
+	save(out, lib.default_max_transition);
+	save(out, lib.libCells);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+void loadLibertyLibrary(BinaryReader &in, ISPD13::LIBInfo &lib) {
+	load(in, lib.default_max_transition);
+	load(in, lib.libCells);
+} // end function
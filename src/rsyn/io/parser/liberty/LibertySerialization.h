@@ -0,0 +1,34 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_LIBERTY_SERIALIZATION_H
+#define RSYN_LIBERTY_SERIALIZATION_H
+
+#include "rsyn/io/legacy/ispd13/global.h"
+
+namespace Rsyn {
+class BinaryReader;
+class BinaryWriter;
+} // end namespace
+
+// Binary serialization of parsed Liberty libraries. Used by the Liberty cache
+// and by design snapshots. Values are stored as parsed (i.e. already in the
+// units chosen by LibertyControlParser). Loading throws an exception if the
+// data is truncated or corrupted.
+
+void saveLibertyLibrary(Rsyn::BinaryWriter &out, const ISPD13::LIBInfo &lib);
+void loadLibertyLibrary(Rsyn::BinaryReader &in, ISPD13::LIBInfo &lib);
+
+#endif /* RSYN_LIBERTY_SERIALIZATION_H */
@@ -562,14 +562,25 @@ bool SdcParser::read_output_load (string& outPortName, double& load) {
     return valid ;
 }
 
+SpefParser::SpefParser (string filename) {
+    // Same special chars as is_special_char().
+    tokenizer.setSpecialChars("(),;/#[]{}*\"\\", true) ;
+    tokenizer.open(filename) ;
+}
+
+// Same as read_line_as_tokens (is, tokens, true /*include special chars*/),
+// but the tokens point into the mapped file.
+bool SpefParser::read_line_as_tokens () {
+    return tokenizer.nextNonEmptyLine(tokens) ;
+}
+
 // The return value indicates whether the *CONN section has been read or not
 bool SpefParser::read_connections (vector<SpefConnection>& connections) {
     
     connections.clear() ; // in case the input is not empty
     bool terminateEarly = false ;
     
-    vector<string> tokens ;
-    bool valid = read_line_as_tokens (is, tokens, true /*include special chars*/) ;
+    bool valid = read_line_as_tokens () ;
     
     // Skip the lines that are not "*CONN"
     while (valid && !(tokens.size() == 2 && tokens[0] == "*" && tokens[1] == "CONN")) {
@@ -581,7 +592,7 @@ bool SpefParser::read_connections (vector<SpefConnection>& connections) {
             break ;
         }
         
-        valid = read_line_as_tokens (is, tokens, true /*include special chars*/) ;
+        valid = read_line_as_tokens () ;
     }
     
     assert (valid) ; // end of file not expected here
@@ -590,7 +601,7 @@ bool SpefParser::read_connections (vector<SpefConnection>& connections) {
         return false ;
     
     while (valid) {
-        valid = read_line_as_tokens (is, tokens, true /*include special chars*/) ;
+        valid = read_line_as_tokens () ;
         
         if (tokens.size() == 2 && tokens[0] == "*" && tokens[1] == "CAP")
             break ; // the beginning of the next section
@@ -598,9 +609,6 @@ bool SpefParser::read_connections (vector<SpefConnection>& connections) {
 	if (tokens.size() == 2 && tokens[0] == "*" && tokens[1] == "END")
            return false ; // spef file for iccad 2015 contest
 	
-	//for(auto str: tokens)
-	//	cout<<str<<endl;
-        //cout<<"############################# "<<__func__<<" "<<__FILE__<<endl;
         // Line format: "*nodeType nodeName direction"
         // Note that nodeName can be either a single token or 3 tokens
         
@@ -614,10 +622,10 @@ bool SpefParser::read_connections (vector<SpefConnection>& connections) {
         curr.nodeType = tokens[tokenIndex++][0] ;
         assert (curr.nodeType == 'P' || curr.nodeType == 'I') ;
         
-        curr.nodeName.n1 = tokens[tokenIndex++] ;
+        curr.nodeName.n1 = tokens[tokenIndex++].str() ;
         if (tokens[tokenIndex] == ":") {
             ++tokenIndex ; // skip the current token
-            curr.nodeName.n2 = tokens[tokenIndex++] ;
+            curr.nodeName.n2 = tokens[tokenIndex++].str() ;
         }
         
         assert (tokens[tokenIndex].size() == 1) ; // should be a single character
@@ -634,11 +642,10 @@ void SpefParser::read_capacitances (vector<SpefCapacitance>& capacitances) {
     
     capacitances.clear() ; // in case the input is not empty
     
-    vector<string> tokens ;
     bool valid = true ;
     while (valid) {
         
-        valid = read_line_as_tokens (is, tokens, true /*include special chars*/) ;
+        valid = read_line_as_tokens () ;
         
         if (tokens.size() == 2 && tokens[0] == "*" && tokens[1] == "RES")
             break ; // the beginning of the next section
@@ -651,13 +658,13 @@ void SpefParser::read_capacitances (vector<SpefCapacitance>& capacitances) {
         SpefCapacitance curr ;
         int tokenIndex = 1 ;
         
-        curr.nodeName.n1 = tokens[tokenIndex++] ;
+        curr.nodeName.n1 = tokens[tokenIndex++].str() ;
         if (tokens[tokenIndex] == ":") {
             ++tokenIndex ; // skip the current token
-            curr.nodeName.n2 = tokens[tokenIndex++] ;
+            curr.nodeName.n2 = tokens[tokenIndex++].str() ;
         }
         
-        curr.capacitance = std::atof(tokens[tokenIndex++].c_str()) ;
+        curr.capacitance = Rsyn::TextTokenizer::toDouble(tokens[tokenIndex++]) ;
         assert (curr.capacitance >= 0) ;
         
         capacitances.push_back(curr) ;
@@ -668,11 +675,10 @@ void SpefParser::read_resistances (vector<SpefResistance>& resistances) {
     
     resistances.clear() ; // in case the input is not empty
     
-    vector<string> tokens ;
     bool valid = true ;
     while (valid) {
         
-        valid = read_line_as_tokens (is, tokens, true /*include special chars*/) ;
+        valid = read_line_as_tokens () ;
         
         if (tokens.size() == 2 && tokens[0] == "*" && tokens[1] == "END")
             break ; // end for this net
@@ -685,19 +691,19 @@ void SpefParser::read_resistances (vector<SpefResistance>& resistances) {
         SpefResistance curr ;
         int tokenIndex = 1 ;
         
-        curr.fromNodeName.n1 = tokens[tokenIndex++] ;
+        curr.fromNodeName.n1 = tokens[tokenIndex++].str() ;
         if (tokens[tokenIndex] == ":") {
             ++tokenIndex ; // skip the current token
-            curr.fromNodeName.n2 = tokens[tokenIndex++] ;
+            curr.fromNodeName.n2 = tokens[tokenIndex++].str() ;
         }
         
-        curr.toNodeName.n1 = tokens[tokenIndex++] ;
+        curr.toNodeName.n1 = tokens[tokenIndex++].str() ;
         if (tokens[tokenIndex] == ":") {
             ++tokenIndex ; // skip the current token
-            curr.toNodeName.n2 = tokens[tokenIndex++] ;
+            curr.toNodeName.n2 = tokens[tokenIndex++].str() ;
         }
         
-        curr.resistance = std::atof(tokens[tokenIndex++].c_str()) ;
+        curr.resistance = Rsyn::TextTokenizer::toDouble(tokens[tokenIndex++]) ;
         assert (curr.resistance >= 0) ;
         
         resistances.push_back(curr) ;
@@ -710,14 +716,13 @@ bool SpefParser::read_net_data (SpefNet& spefNet) {
     
     spefNet.clear() ;
     
-    vector<string> tokens ;
-    bool valid = read_line_as_tokens (is, tokens, true /*include special chars*/) ;
+    bool valid = read_line_as_tokens () ;
     
     // Read until a valid D_NET line is found
     while (valid) {
         if (tokens.size() == 4 && tokens[0] == "*" && tokens[1] == "D_NET") {
-            spefNet.netName = tokens[2] ;
-            spefNet.netLumpedCap = std::atof(tokens[3].c_str()) ;
+            spefNet.netName = tokens[2].str() ;
+            spefNet.netLumpedCap = Rsyn::TextTokenizer::toDouble(tokens[3]) ;
             
             bool readConns = read_connections (spefNet.connections) ;
 
@@ -732,7 +737,7 @@ bool SpefParser::read_net_data (SpefNet& spefNet) {
 				cout << "[BUG] @ SpefParser::read_net_data: possibly wrong-named net starting with '" << tokens[2] << "'\n";
 		} // end else
         
-        valid = read_line_as_tokens (is, tokens, true /*include special chars*/) ;
+        valid = read_line_as_tokens () ;
     }
     
     return false ; // a valid net was not read
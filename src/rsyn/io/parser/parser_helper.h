@@ -46,6 +46,8 @@ extern "C" {
 #include "rsyn/3rdparty/parser/liberty/si2dr_liberty.h"
 }
 
+#include "rsyn/util/TextTokenizer.h"
+
 using std::cout ;
 using std::endl ;
 using std::istream ;
@@ -263,17 +265,21 @@ struct SpefNodeName {
         
     } ;
     
+    // The spef file is memory mapped and tokenized in place (SPEF files may
+    // have hundreds of MB). Only the names stored in SpefNet are copied.
     class SpefParser {
         
-        std::ifstream is ;
+        Rsyn::TextTokenizer tokenizer ;
+        vector<Rsyn::StringRef> tokens ;
         
+        bool read_line_as_tokens () ;
         bool read_connections (vector<SpefConnection>& connections) ;
         void read_capacitances (vector<SpefCapacitance>& capacitances) ;
         void read_resistances (vector<SpefResistance>& resistances) ;
         
     public:
         
-        SpefParser (string filename): is(filename.c_str()) {}
+        SpefParser (string filename) ;
         
         // Read the spef data for the next net.
         // Return value indicates if the last read was successful or not.
@@ -0,0 +1,92 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_SNAPSHOT_DESCRIPTOR_H
+#define RSYN_SNAPSHOT_DESCRIPTOR_H
+
+#include <string>
+#include <vector>
+
+#include "rsyn/phy/util/DefDescriptors.h"
+#include "rsyn/phy/util/LefDescriptors.h"
+#include "rsyn/io/legacy/ispd13/global.h"
+
+static const std::string INVALID_SNAPSHOT_NAME = "*<INVALID_SNAPSHOT_NAME>*";
+
+// -----------------------------------------------------------------------------
+
+class SnapshotLibraryPinDscp {
+public:
+	std::string clsName = INVALID_SNAPSHOT_NAME;
+	int clsDirection = 0; // Rsyn::Direction
+	SnapshotLibraryPinDscp() = default;
+}; // end class
+
+// -----------------------------------------------------------------------------
+
+class SnapshotLibraryArcDscp {
+public:
+	std::string clsFromPinName = INVALID_SNAPSHOT_NAME;
+	std::string clsToPinName = INVALID_SNAPSHOT_NAME;
+	SnapshotLibraryArcDscp() = default;
+}; // end class
+
+// -----------------------------------------------------------------------------
+
+//! Descriptor for library cells. Pins are stored in index order.
+
+class SnapshotLibraryCellDscp {
+public:
+	std::string clsName = INVALID_SNAPSHOT_NAME;
+	std::vector<SnapshotLibraryPinDscp> clsPins;
+	std::vector<SnapshotLibraryArcDscp> clsArcs;
+	SnapshotLibraryCellDscp() = default;
+}; // end class
+
+// -----------------------------------------------------------------------------
+
+//! Descriptor for a design snapshot. The netlist, placement and routing are
+//! stored as DEF components, ports and nets, so that a snapshot is restored
+//! through the same path as a LEF/DEF design. The timing inputs (Liberty, SDC
+//! and wire parasitics) are stored as parsed so that the timing stack can be
+//! rebuilt without parsing any text file.
+
+class SnapshotDscp {
+public:
+	std::string clsDesignName = INVALID_SNAPSHOT_NAME;
+	std::vector<SnapshotLibraryCellDscp> clsLibraryCells;
+
+	bool clsHasPhysicalDesign = false;
+	bool clsEnablePhysicalPins = false;
+	bool clsEnableMergeRectangles = false;
+	bool clsEnableNetPinBoundaries = false;
+	std::string clsClockNetName; // empty if no clock net was set
+	std::vector<LefDscp> clsLefDscps;
+	DefDscp clsDefDscp;
+
+	bool clsHasTiming = false;
+	bool clsEnableRSTT = false;
+	double clsWireResistancePerDBU = 0.0;
+	double clsWireCapacitancePerDBU = 0.0;
+	DBU clsMaxWireSegmentLength = 0;
+	ISPD13::LIBInfo clsLibInfoEarly;
+	ISPD13::LIBInfo clsLibInfoLate;
+	ISPD13::SDCInfo clsSdcInfo;
+	SnapshotDscp() = default;
+}; // end class
+
+// -----------------------------------------------------------------------------
+
+#endif /* RSYN_SNAPSHOT_DESCRIPTOR_H */
@@ -0,0 +1,913 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstring>
+#include <fstream>
+
+#include "SnapshotParser.h"
+#include "rsyn/io/parser/liberty/LibertySerialization.h"
+#include "rsyn/util/BinaryStream.h"
+#include "rsyn/util/MappedFile.h"
+
+using Rsyn::BinaryReader;
+using Rsyn::BinaryWriter;
+
+static const char SNAPSHOT_MAGIC[8] = {'R', 'S', 'Y', 'N', 'S', 'N', 'A', 'P'};
+static const std::uint32_t SNAPSHOT_BYTE_ORDER_MARK = 0x01020304;
+
+// =============================================================================
+// Descriptor serialization
+// =============================================================================
+
+// Basic types are written as is. Each descriptor is written field by field in
+// declaration order and read back in the same order. Any change here requires
+// increasing SnapshotParser::VERSION.
+
+template<typename T>
+static void save(BinaryWriter &out, const T &value) {
+	out.write(value);
+} // end function
+
+template<typename T>
+static void load(BinaryReader &in, T &value) {
+	in.read(value);
+} // end function
+
+static void save(BinaryWriter &out, const std::string &value) { out.write(value); }
+static void load(BinaryReader &in, std::string &value) { in.read(value); }
+
+static void save(BinaryWriter &out, const double2 &value);
+static void load(BinaryReader &in, double2 &value);
+static void save(BinaryWriter &out, const DBUxy &value);
+static void load(BinaryReader &in, DBUxy &value);
+static void save(BinaryWriter &out, const DoubleRectangle &value);
+static void load(BinaryReader &in, DoubleRectangle &value);
+static void save(BinaryWriter &out, const Bounds &value);
+static void load(BinaryReader &in, Bounds &value);
+
+static void save(BinaryWriter &out, const LefPolygonDscp &value);
+static void load(BinaryReader &in, LefPolygonDscp &value);
+static void save(BinaryWriter &out, const LefPortDscp &value);
+static void load(BinaryReader &in, LefPortDscp &value);
+static void save(BinaryWriter &out, const LefPinDscp &value);
+static void load(BinaryReader &in, LefPinDscp &value);
+static void save(BinaryWriter &out, const LefObsDscp &value);
+static void load(BinaryReader &in, LefObsDscp &value);
+static void save(BinaryWriter &out, const LefMacroDscp &value);
+static void load(BinaryReader &in, LefMacroDscp &value);
+static void save(BinaryWriter &out, const LefSpacingRuleDscp &value);
+static void load(BinaryReader &in, LefSpacingRuleDscp &value);
+static void save(BinaryWriter &out, const LefLayerDscp &value);
+static void load(BinaryReader &in, LefLayerDscp &value);
+static void save(BinaryWriter &out, const LefSiteDscp &value);
+static void load(BinaryReader &in, LefSiteDscp &value);
+static void save(BinaryWriter &out, const LefSpacingDscp &value);
+static void load(BinaryReader &in, LefSpacingDscp &value);
+static void save(BinaryWriter &out, const LefViaLayerDscp &value);
+static void load(BinaryReader &in, LefViaLayerDscp &value);
+static void save(BinaryWriter &out, const LefViaDscp &value);
+static void load(BinaryReader &in, LefViaDscp &value);
+static void save(BinaryWriter &out, const LefDscp &value);
+static void load(BinaryReader &in, LefDscp &value);
+
+static void save(BinaryWriter &out, const DefComponentDscp &value);
+static void load(BinaryReader &in, DefComponentDscp &value);
+static void save(BinaryWriter &out, const DefGroupDscp &value);
+static void load(BinaryReader &in, DefGroupDscp &value);
+static void save(BinaryWriter &out, const DefPortDscp &value);
+static void load(BinaryReader &in, DefPortDscp &value);
+static void save(BinaryWriter &out, const DefNetConnection &value);
+static void load(BinaryReader &in, DefNetConnection &value);
+static void save(BinaryWriter &out, const DefRoutingPointDscp &value);
+static void load(BinaryReader &in, DefRoutingPointDscp &value);
+static void save(BinaryWriter &out, const DefWireSegmentDscp &value);
+static void load(BinaryReader &in, DefWireSegmentDscp &value);
+static void save(BinaryWriter &out, const DefWireDscp &value);
+static void load(BinaryReader &in, DefWireDscp &value);
+static void save(BinaryWriter &out, const DefNetDscp &value);
+static void load(BinaryReader &in, DefNetDscp &value);
+static void save(BinaryWriter &out, const DefSpecialNetDscp &value);
+static void load(BinaryReader &in, DefSpecialNetDscp &value);
+static void save(BinaryWriter &out, const DefRegionDscp &value);
+static void load(BinaryReader &in, DefRegionDscp &value);
+static void save(BinaryWriter &out, const DefRowDscp &value);
+static void load(BinaryReader &in, DefRowDscp &value);
+static void save(BinaryWriter &out, const DefTrackDscp &value);
+static void load(BinaryReader &in, DefTrackDscp &value);
+static void save(BinaryWriter &out, const DefViaLayerDscp &value);
+static void load(BinaryReader &in, DefViaLayerDscp &value);
+static void save(BinaryWriter &out, const DefViaDscp &value);
+static void load(BinaryReader &in, DefViaDscp &value);
+static void save(BinaryWriter &out, const DefDscp &value);
+static void load(BinaryReader &in, DefDscp &value);
+
+static void save(BinaryWriter &out, const SnapshotLibraryPinDscp &value);
+static void load(BinaryReader &in, SnapshotLibraryPinDscp &value);
+static void save(BinaryWriter &out, const SnapshotLibraryArcDscp &value);
+static void load(BinaryReader &in, SnapshotLibraryArcDscp &value);
+static void save(BinaryWriter &out, const SnapshotLibraryCellDscp &value);
+static void load(BinaryReader &in, SnapshotLibraryCellDscp &value);
+
+static void save(BinaryWriter &out, const ISPD13::InputDelay &value);
+static void load(BinaryReader &in, ISPD13::InputDelay &value);
+static void save(BinaryWriter &out, const ISPD13::OutputDelay &value);
+static void load(BinaryReader &in, ISPD13::OutputDelay &value);
+static void save(BinaryWriter &out, const ISPD13::InputDriver &value);
+static void load(BinaryReader &in, ISPD13::InputDriver &value);
+static void save(BinaryWriter &out, const ISPD13::OutputLoad &value);
+static void load(BinaryReader &in, ISPD13::OutputLoad &value);
+static void save(BinaryWriter &out, const ISPD13::SDCInfo &value);
+static void load(BinaryReader &in, ISPD13::SDCInfo &value);
+
+template<typename T>
+static void save(BinaryWriter &out, const std::vector<T> &values) {
+	out.write((std::uint64_t) values.size());
+	for (const T &value : values) {
+		save(out, value);
+	} // end for
+} // end function
+
+template<typename T>
+static void load(BinaryReader &in, std::vector<T> &values) {
+	// Every element takes at least one byte, which bounds the size of
+	// corrupted vectors.
+	const std::uint64_t size = in.read<std::uint64_t>();
+	if (size > in.getRemainingSize())
+		throw Exception("Invalid vector size in binary data.");
+	values.resize((std::size_t) size);
+	for (T &value : values) {
+		load(in, value);
+	} // end for
+} // end function
+
+// Bit fields cannot be bound to references.
+static bool loadBool(BinaryReader &in) {
+	return in.read<bool>();
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const double2 &value) {
+	save(out, value.x);
+	save(out, value.y);
+} // end function
+
+static void load(BinaryReader &in, double2 &value) {
+	load(in, value.x);
+	load(in, value.y);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const DBUxy &value) {
+	save(out, value.x);
+	save(out, value.y);
+} // end function
+
+static void load(BinaryReader &in, DBUxy &value) {
+	load(in, value.x);
+	load(in, value.y);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const DoubleRectangle &value) {
+	save(out, value[LOWER]);
+	save(out, value[UPPER]);
+} // end function
+
+static void load(BinaryReader &in, DoubleRectangle &value) {
+	load(in, value[LOWER]);
+	load(in, value[UPPER]);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const Bounds &value) {
+	save(out, value[LOWER]);
+	save(out, value[UPPER]);
+} // end function
+
+static void load(BinaryReader &in, Bounds &value) {
+	load(in, value[LOWER]);
+	load(in, value[UPPER]);
+} // end function
+
+// =============================================================================
+// LEF
+// =============================================================================
+
+static void save(BinaryWriter &out, const LefPolygonDscp &value) {
+	save(out, value.clsPolygonPoints);
+} // end function
+
+static void load(BinaryReader &in, LefPolygonDscp &value) {
+	load(in, value.clsPolygonPoints);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const LefPortDscp &value) {
+	save(out, value.clsMetalName);
+	save(out, value.clsBounds);
+	save(out, value.clsLefPolygonDscp);
+} // end function
+
+static void load(BinaryReader &in, LefPortDscp &value) {
+	load(in, value.clsMetalName);
+	load(in, value.clsBounds);
+	load(in, value.clsLefPolygonDscp);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const LefPinDscp &value) {
+	save(out, value.clsHasPort);
+	save(out, value.clsPinName);
+	save(out, value.clsPinDirection);
+	save(out, value.clsBounds);
+	save(out, value.clsPorts);
+} // end function
+
+static void load(BinaryReader &in, LefPinDscp &value) {
+	load(in, value.clsHasPort);
+	load(in, value.clsPinName);
+	load(in, value.clsPinDirection);
+	load(in, value.clsBounds);
+	load(in, value.clsPorts);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const LefObsDscp &value) {
+	save(out, value.clsMetalLayer);
+	save(out, value.clsBounds);
+} // end function
+
+static void load(BinaryReader &in, LefObsDscp &value) {
+	load(in, value.clsMetalLayer);
+	load(in, value.clsBounds);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const LefMacroDscp &value) {
+	save(out, value.clsMacroName);
+	save(out, value.clsMacroClass);
+	save(out, value.clsSite);
+	save(out, value.clsOrigin);
+	save(out, value.clsSize);
+	save(out, value.clsSymmetry);
+	save(out, value.clsPins);
+	save(out, value.clsObs);
+} // end function
+
+static void load(BinaryReader &in, LefMacroDscp &value) {
+	load(in, value.clsMacroName);
+	load(in, value.clsMacroClass);
+	load(in, value.clsSite);
+	load(in, value.clsOrigin);
+	load(in, value.clsSize);
+	load(in, value.clsSymmetry);
+	load(in, value.clsPins);
+	load(in, value.clsObs);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const LefSpacingRuleDscp &value) {
+	save(out, value.clsSpacing);
+	save(out, value.clsEOL);
+	save(out, value.clsEOLWithin);
+} // end function
+
+static void load(BinaryReader &in, LefSpacingRuleDscp &value) {
+	load(in, value.clsSpacing);
+	load(in, value.clsEOL);
+	load(in, value.clsEOLWithin);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const LefLayerDscp &value) {
+	save(out, value.clsName);
+	save(out, value.clsType);
+	save(out, value.clsDirection);
+	save(out, value.clsPitch[0]);
+	save(out, value.clsPitch[1]);
+	save(out, value.clsOffset);
+	save(out, value.clsWidth);
+	save(out, value.clsMinWidth);
+	save(out, value.clsArea);
+	save(out, value.clsSpacingRules);
+} // end function
+
+static void load(BinaryReader &in, LefLayerDscp &value) {
+	load(in, value.clsName);
+	load(in, value.clsType);
+	load(in, value.clsDirection);
+	load(in, value.clsPitch[0]);
+	load(in, value.clsPitch[1]);
+	load(in, value.clsOffset);
+	load(in, value.clsWidth);
+	load(in, value.clsMinWidth);
+	load(in, value.clsArea);
+	load(in, value.clsSpacingRules);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const LefSiteDscp &value) {
+	save(out, value.clsName);
+	save(out, value.clsSize);
+	save(out, value.clsHasClass);
+	save(out, value.clsSiteClass);
+} // end function
+
+static void load(BinaryReader &in, LefSiteDscp &value) {
+	load(in, value.clsName);
+	load(in, value.clsSize);
+	load(in, value.clsHasClass);
+	load(in, value.clsSiteClass);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const LefSpacingDscp &value) {
+	save(out, value.clsLayer1);
+	save(out, value.clsLayer2);
+	save(out, value.clsDistance);
+} // end function
+
+static void load(BinaryReader &in, LefSpacingDscp &value) {
+	load(in, value.clsLayer1);
+	load(in, value.clsLayer2);
+	load(in, value.clsDistance);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const LefViaLayerDscp &value) {
+	save(out, value.clsLayerName);
+	save(out, value.clsBounds);
+} // end function
+
+static void load(BinaryReader &in, LefViaLayerDscp &value) {
+	load(in, value.clsLayerName);
+	load(in, value.clsBounds);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const LefViaDscp &value) {
+	save(out, value.clsHasDefault);
+	save(out, value.clsName);
+	save(out, value.clsViaLayers);
+} // end function
+
+static void load(BinaryReader &in, LefViaDscp &value) {
+	load(in, value.clsHasDefault);
+	load(in, value.clsName);
+	load(in, value.clsViaLayers);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const LefDscp &value) {
+	save(out, value.clsMajorVersion);
+	save(out, value.clsMinorVersion);
+	save(out, value.clsCaseSensitive);
+	save(out, value.clsBusBitChars);
+	save(out, value.clsDivideChar);
+	save(out, value.clsManufactGrid);
+	save(out, value.clsLefUnitsDscp); // plain bools and ints
+	save(out, value.clsLefSiteDscps);
+	save(out, value.clsLefLayerDscps);
+	save(out, value.clsLefMacroDscps);
+	save(out, value.clsLefSpacingDscps);
+	save(out, value.clsLefViaDscps);
+} // end function
+
+static void load(BinaryReader &in, LefDscp &value) {
+	load(in, value.clsMajorVersion);
+	load(in, value.clsMinorVersion);
+	load(in, value.clsCaseSensitive);
+	load(in, value.clsBusBitChars);
+	load(in, value.clsDivideChar);
+	load(in, value.clsManufactGrid);
+	load(in, value.clsLefUnitsDscp);
+	load(in, value.clsLefSiteDscps);
+	load(in, value.clsLefLayerDscps);
+	load(in, value.clsLefMacroDscps);
+	load(in, value.clsLefSpacingDscps);
+	load(in, value.clsLefViaDscps);
+} // end function
+
+// =============================================================================
+// DEF
+// =============================================================================
+
+static void save(BinaryWriter &out, const DefComponentDscp &value) {
+	save(out, value.clsName);
+	save(out, value.clsMacroName);
+	save(out, value.clsLocationType);
+	save(out, value.clsPos);
+	save(out, value.clsOrientation);
+	save(out, value.clsIsFixed);
+	save(out, value.clsIsPlaced);
+} // end function
+
+static void load(BinaryReader &in, DefComponentDscp &value) {
+	load(in, value.clsName);
+	load(in, value.clsMacroName);
+	load(in, value.clsLocationType);
+	load(in, value.clsPos);
+	load(in, value.clsOrientation);
+	load(in, value.clsIsFixed);
+	load(in, value.clsIsPlaced);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const DefGroupDscp &value) {
+	save(out, value.clsName);
+	save(out, value.clsPatterns);
+	save(out, value.clsRegion);
+} // end function
+
+static void load(BinaryReader &in, DefGroupDscp &value) {
+	load(in, value.clsName);
+	load(in, value.clsPatterns);
+	load(in, value.clsRegion);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const DefPortDscp &value) {
+	save(out, value.clsName);
+	save(out, value.clsNetName);
+	save(out, value.clsDirection);
+	save(out, value.clsLocationType);
+	save(out, value.clsOrientation);
+	save(out, value.clsLayerName);
+	save(out, value.clsUse);
+	save(out, value.clsPos);
+	save(out, value.clsICCADPos);
+	save(out, value.clsLayerBounds);
+	save(out, value.clsSpecial);
+} // end function
+
+static void load(BinaryReader &in, DefPortDscp &value) {
+	load(in, value.clsName);
+	load(in, value.clsNetName);
+	load(in, value.clsDirection);
+	load(in, value.clsLocationType);
+	load(in, value.clsOrientation);
+	load(in, value.clsLayerName);
+	load(in, value.clsUse);
+	load(in, value.clsPos);
+	load(in, value.clsICCADPos);
+	load(in, value.clsLayerBounds);
+	load(in, value.clsSpecial);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const DefNetConnection &value) {
+	save(out, value.clsPinName);
+	save(out, value.clsComponentName);
+} // end function
+
+static void load(BinaryReader &in, DefNetConnection &value) {
+	load(in, value.clsPinName);
+	load(in, value.clsComponentName);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const DefRoutingPointDscp &value) {
+	save(out, value.clsViaName);
+	save(out, value.clsOrientation);
+	save(out, value.clsExtension);
+	save(out, value.clsPos);
+	save(out, (bool) value.clsHasMask);
+	save(out, (bool) value.clsHasRectangle);
+	save(out, (bool) value.clsHasVirtual);
+	save(out, (bool) value.clsHasVia);
+	save(out, value.clsRect);
+} // end function
+
+static void load(BinaryReader &in, DefRoutingPointDscp &value) {
+	load(in, value.clsViaName);
+	load(in, value.clsOrientation);
+	load(in, value.clsExtension);
+	load(in, value.clsPos);
+	value.clsHasMask = loadBool(in);
+	value.clsHasRectangle = loadBool(in);
+	value.clsHasVirtual = loadBool(in);
+	value.clsHasVia = loadBool(in);
+	load(in, value.clsRect);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const DefWireSegmentDscp &value) {
+	save(out, value.clsLayerName);
+	save(out, (bool) value.clsNew);
+	save(out, value.clsRoutingPoints);
+	save(out, value.clsRoutedWidth);
+	save(out, value.clsViaName);
+	save(out, value.clsExtensionBegin);
+	save(out, value.clsExtensionEnd);
+	save(out, value.clsMask);
+	save(out, value.clsWidth);
+	save(out, (bool) value.clsHasVia);
+	save(out, (bool) value.clsHasRectangle);
+	save(out, value.clsRect);
+	save(out, value.clsPoints);
+} // end function
+
+static void load(BinaryReader &in, DefWireSegmentDscp &value) {
+	load(in, value.clsLayerName);
+	value.clsNew = loadBool(in);
+	load(in, value.clsRoutingPoints);
+	load(in, value.clsRoutedWidth);
+	load(in, value.clsViaName);
+	load(in, value.clsExtensionBegin);
+	load(in, value.clsExtensionEnd);
+	load(in, value.clsMask);
+	load(in, value.clsWidth);
+	value.clsHasVia = loadBool(in);
+	value.clsHasRectangle = loadBool(in);
+	load(in, value.clsRect);
+	load(in, value.clsPoints);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const DefWireDscp &value) {
+	save(out, value.clsWireSegments);
+	save(out, value.clsWireType);
+} // end function
+
+static void load(BinaryReader &in, DefWireDscp &value) {
+	load(in, value.clsWireSegments);
+	load(in, value.clsWireType);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const DefNetDscp &value) {
+	save(out, value.clsName);
+	save(out, value.clsConnections);
+	save(out, value.clsWires);
+} // end function
+
+static void load(BinaryReader &in, DefNetDscp &value) {
+	load(in, value.clsName);
+	load(in, value.clsConnections);
+	load(in, value.clsWires);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const DefSpecialNetDscp &value) {
+	save(out, value.clsName);
+	save(out, value.clsWires);
+} // end function
+
+static void load(BinaryReader &in, DefSpecialNetDscp &value) {
+	load(in, value.clsName);
+	load(in, value.clsWires);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const DefRegionDscp &value) {
+	save(out, value.clsName);
+	save(out, value.clsType);
+	save(out, value.clsBounds);
+} // end function
+
+static void load(BinaryReader &in, DefRegionDscp &value) {
+	load(in, value.clsName);
+	load(in, value.clsType);
+	load(in, value.clsBounds);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const DefRowDscp &value) {
+	save(out, value.clsName);
+	save(out, value.clsSite);
+	save(out, value.clsOrigin);
+	save(out, value.clsOrientation);
+	save(out, value.clsNumX);
+	save(out, value.clsNumY);
+	save(out, value.clsStepX);
+	save(out, value.clsStepY);
+} // end function
+
+static void load(BinaryReader &in, DefRowDscp &value) {
+	load(in, value.clsName);
+	load(in, value.clsSite);
+	load(in, value.clsOrigin);
+	load(in, value.clsOrientation);
+	load(in, value.clsNumX);
+	load(in, value.clsNumY);
+	load(in, value.clsStepX);
+	load(in, value.clsStepY);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const DefTrackDscp &value) {
+	save(out, value.clsDirection);
+	save(out, value.clsLocation);
+	save(out, value.clsNumTracks);
+	save(out, value.clsLayers);
+	save(out, value.clsSpace);
+} // end function
+
+static void load(BinaryReader &in, DefTrackDscp &value) {
+	load(in, value.clsDirection);
+	load(in, value.clsLocation);
+	load(in, value.clsNumTracks);
+	load(in, value.clsLayers);
+	load(in, value.clsSpace);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const DefViaLayerDscp &value) {
+	save(out, value.clsLayerName);
+	save(out, value.clsBounds);
+} // end function
+
+static void load(BinaryReader &in, DefViaLayerDscp &value) {
+	load(in, value.clsLayerName);
+	load(in, value.clsBounds);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const DefViaDscp &value) {
+	save(out, value.clsName);
+	save(out, value.clsViaLayers);
+} // end function
+
+static void load(BinaryReader &in, DefViaDscp &value) {
+	load(in, value.clsName);
+	load(in, value.clsViaLayers);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const DefDscp &value) {
+	save(out, value.clsVersion);
+	save(out, value.clsDeviderChar);
+	save(out, value.clsBusBitChars);
+	save(out, value.clsDesignName);
+	save(out, value.clsDieBounds);
+	save(out, value.clsDatabaseUnits);
+	save(out, value.clsRows);
+	save(out, value.clsComps);
+	save(out, value.clsPorts);
+	save(out, value.clsNets);
+	save(out, value.clsRegions);
+	save(out, value.clsGroups);
+	save(out, value.clsSpecialNets);
+	save(out, value.clsVias);
+	save(out, value.clsTracks);
+} // end function
+
+static void load(BinaryReader &in, DefDscp &value) {
+	load(in, value.clsVersion);
+	load(in, value.clsDeviderChar);
+	load(in, value.clsBusBitChars);
+	load(in, value.clsDesignName);
+	load(in, value.clsDieBounds);
+	load(in, value.clsDatabaseUnits);
+	load(in, value.clsRows);
+	load(in, value.clsComps);
+	load(in, value.clsPorts);
+	load(in, value.clsNets);
+	load(in, value.clsRegions);
+	load(in, value.clsGroups);
+	load(in, value.clsSpecialNets);
+	load(in, value.clsVias);
+	load(in, value.clsTracks);
+} // end function
+
+// =============================================================================
+// Library
+// =============================================================================
+
+static void save(BinaryWriter &out, const SnapshotLibraryPinDscp &value) {
+	save(out, value.clsName);
+	save(out, value.clsDirection);
+} // end function
+
+static void load(BinaryReader &in, SnapshotLibraryPinDscp &value) {
+	load(in, value.clsName);
+	load(in, value.clsDirection);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const SnapshotLibraryArcDscp &value) {
+	save(out, value.clsFromPinName);
+	save(out, value.clsToPinName);
+} // end function
+
+static void load(BinaryReader &in, SnapshotLibraryArcDscp &value) {
+	load(in, value.clsFromPinName);
+	load(in, value.clsToPinName);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const SnapshotLibraryCellDscp &value) {
+	save(out, value.clsName);
+	save(out, value.clsPins);
+	save(out, value.clsArcs);
+} // end function
+
+static void load(BinaryReader &in, SnapshotLibraryCellDscp &value) {
+	load(in, value.clsName);
+	load(in, value.clsPins);
+	load(in, value.clsArcs);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const ISPD13::InputDelay &value) {
+	save(out, value.port_name);
+	save(out, value.delay);
+} // end function
+
+static void load(BinaryReader &in, ISPD13::InputDelay &value) {
+	load(in, value.port_name);
+	load(in, value.delay);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const ISPD13::OutputDelay &value) {
+	save(out, value.port_name);
+	save(out, value.delay);
+} // end function
+
+static void load(BinaryReader &in, ISPD13::OutputDelay &value) {
+	load(in, value.port_name);
+	load(in, value.delay);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const ISPD13::InputDriver &value) {
+	save(out, value.port_name);
+	save(out, value.driver);
+	save(out, value.rise);
+	save(out, value.fall);
+} // end function
+
+static void load(BinaryReader &in, ISPD13::InputDriver &value) {
+	load(in, value.port_name);
+	load(in, value.driver);
+	load(in, value.rise);
+	load(in, value.fall);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const ISPD13::OutputLoad &value) {
+	save(out, value.port_name);
+	save(out, value.load);
+} // end function
+
+static void load(BinaryReader &in, ISPD13::OutputLoad &value) {
+	load(in, value.port_name);
+	load(in, value.load);
+} // end function
+
+// -----------------------------------------------------------------------------
+
+static void save(BinaryWriter &out, const ISPD13::SDCInfo &value) {
+	save(out, value.clk_name);
+	save(out, value.clk_port);
+	save(out, value.clk_period);
+	save(out, value.input_delays);
+	save(out, value.input_drivers);
+	save(out, value.output_delays);
+	save(out, value.output_loads);
+} // end function
+
+static void load(BinaryReader &in, ISPD13::SDCInfo &value) {
+	load(in, value.clk_name);
+	load(in, value.clk_port);
+	load(in, value.clk_period);
+	load(in, value.input_delays);
+	load(in, value.input_drivers);
+	load(in, value.output_delays);
+	load(in, value.output_loads);
+} // end function
+
+// =============================================================================
+// Snapshot Parser
+// =============================================================================
+
+void SnapshotParser::parse(const std::string &filename, SnapshotDscp &snapshotDscp) {
+	Rsyn::MappedFile file;
+	if (!file.open(filename))
+		throw Exception("Unable to open snapshot file '" + filename + "'.");
+
+	BinaryReader in(file.begin(), file.end());
+	if (in.getRemainingSize() < sizeof(SNAPSHOT_MAGIC) ||
+			std::memcmp(in.readBytes(sizeof(SNAPSHOT_MAGIC)),
+			SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+		throw Exception("File '" + filename + "' is not a snapshot.");
+	} // end if
+
+	if (in.read<std::uint32_t>() != SNAPSHOT_BYTE_ORDER_MARK)
+		throw Exception("Snapshot '" + filename + "' was written on a machine "
+				"with a different byte order.");
+
+	const std::uint32_t version = in.read<std::uint32_t>();
+	if (version != VERSION)
+		throw Exception("Snapshot '" + filename + "' has version " +
+				std::to_string(version) + ", expected " +
+				std::to_string(VERSION) + ".");
+
+	load(in, snapshotDscp.clsDesignName);
+	load(in, snapshotDscp.clsLibraryCells);
+	load(in, snapshotDscp.clsHasPhysicalDesign);
+	load(in, snapshotDscp.clsEnablePhysicalPins);
+	load(in, snapshotDscp.clsEnableMergeRectangles);
+	load(in, snapshotDscp.clsEnableNetPinBoundaries);
+	load(in, snapshotDscp.clsClockNetName);
+	load(in, snapshotDscp.clsLefDscps);
+	load(in, snapshotDscp.clsDefDscp);
+	load(in, snapshotDscp.clsHasTiming);
+	if (snapshotDscp.clsHasTiming) {
+		load(in, snapshotDscp.clsEnableRSTT);
+		load(in, snapshotDscp.clsWireResistancePerDBU);
+		load(in, snapshotDscp.clsWireCapacitancePerDBU);
+		load(in, snapshotDscp.clsMaxWireSegmentLength);
+		loadLibertyLibrary(in, snapshotDscp.clsLibInfoEarly);
+		loadLibertyLibrary(in, snapshotDscp.clsLibInfoLate);
+		load(in, snapshotDscp.clsSdcInfo);
+	} // end if
+
+	if (!in.atEnd())
+		throw Exception("Snapshot '" + filename + "' has unexpected trailing data.");
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void SnapshotParser::write(const std::string &filename, const SnapshotDscp &snapshotDscp) {
+	std::ofstream file(filename, std::ios::binary);
+	if (!file)
+		throw Exception("Unable to create snapshot file '" + filename + "'.");
+
+	BinaryWriter out(file);
+	out.writeBytes(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+	out.write(SNAPSHOT_BYTE_ORDER_MARK);
+	out.write((std::uint32_t) VERSION);
+
+	save(out, snapshotDscp.clsDesignName);
+	save(out, snapshotDscp.clsLibraryCells);
+	save(out, snapshotDscp.clsHasPhysicalDesign);
+	save(out, snapshotDscp.clsEnablePhysicalPins);
+	save(out, snapshotDscp.clsEnableMergeRectangles);
+	save(out, snapshotDscp.clsEnableNetPinBoundaries);
+	save(out, snapshotDscp.clsClockNetName);
+	save(out, snapshotDscp.clsLefDscps);
+	save(out, snapshotDscp.clsDefDscp);
+	save(out, snapshotDscp.clsHasTiming);
+	if (snapshotDscp.clsHasTiming) {
+		save(out, snapshotDscp.clsEnableRSTT);
+		save(out, snapshotDscp.clsWireResistancePerDBU);
+		save(out, snapshotDscp.clsWireCapacitancePerDBU);
+		save(out, snapshotDscp.clsMaxWireSegmentLength);
+		saveLibertyLibrary(out, snapshotDscp.clsLibInfoEarly);
+		saveLibertyLibrary(out, snapshotDscp.clsLibInfoLate);
+		save(out, snapshotDscp.clsSdcInfo);
+	} // end if
+
+	file.flush();
+	if (!out.good())
+		throw Exception("Error while writing snapshot file '" + filename + "'.");
+} // end method
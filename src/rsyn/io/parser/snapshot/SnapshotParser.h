@@ -0,0 +1,43 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_SNAPSHOT_PARSER_H
+#define RSYN_SNAPSHOT_PARSER_H
+
+#include <cstdint>
+#include <string>
+
+#include "SnapshotDescriptor.h"
+
+// Reads and writes design snapshots. A snapshot is a binary file starting
+// with a magic string, a byte order mark and a format version. Files written
+// by a different version of the format are rejected. The file is memory
+// mapped when read.
+
+class SnapshotParser {
+public:
+	static const std::uint32_t VERSION = 2;
+
+	SnapshotParser() = default;
+
+	// Throws an exception if the file cannot be read or is not a valid
+	// snapshot.
+	void parse(const std::string &filename, SnapshotDscp &snapshotDscp);
+
+	// Throws an exception if the file cannot be written.
+	void write(const std::string &filename, const SnapshotDscp &snapshotDscp);
+}; // end class
+
+#endif /* RSYN_SNAPSHOT_PARSER_H */
@@ -27,6 +27,7 @@
 #include "rsyn/phy/PhysicalService.h"
 #include "rsyn/phy/PhysicalDesign.h"
 #include "rsyn/util/Stepwatch.h"
+#include "rsyn/io/reader/ParsingPipeline.h"
 #include "rsyn/model/timing/Timer.h"
 #include "rsyn/model/routing/RsttRoutingEstimatorModel.h"
 
@@ -66,6 +67,8 @@ void GenericReader::load(const Json& params) {
 		defFiles.push_back(path + params.value("defFiles", ""));
 	} // end if
 
+	numParsingThreads = params.value("numParsingThreads", 0);
+
 	if (params.count("verilogFile")) {
 		verilogFile = path + params.value("verilogFile", "");
 		enableNetlistFromVerilog = true;
@@ -113,20 +116,24 @@ void GenericReader::load(const Json& params) {
 void GenericReader::parsingFlow() {
 	Stepwatch watch("Running generic reader");
 
-	parseLEFFiles();
-
-	parseDEFFiles();
+	// Input files are independent until the design is populated, so they are
+	// parsed concurrently.
+	ParsingPipeline pipeline(numParsingThreads);
+	pipeline.addStage("LEF", [&]() { parseLEFFiles(); });
+	pipeline.addStage("DEF", [&]() { parseDEFFiles(); });
 
 	if (enableNetlistFromVerilog)
-		parseVerilogFile();
+		pipeline.addStage("Verilog", [&]() { parseVerilogFile(); });
 
-	if (enableTiming)
-		parseLibertyFile();
+	if (enableTiming) {
+		pipeline.addStage("Liberty", [&]() { parseLibertyFile(); });
+		pipeline.addStage("SDC", [&]() { parseSDCFile(); });
+	} // end if
 
-	populateDesign();
+	pipeline.run();
+	pipeline.report("Parsing stages");
 
-	if (enableTiming)
-		parseSDCFile();
+	populateDesign();
 
 	initializeAuxiliarInfrastructure();
 } // end method 
@@ -134,7 +141,6 @@ void GenericReader::parsingFlow() {
 // -----------------------------------------------------------------------------
 
 void GenericReader::parseLEFFiles() {
-	Stepwatch watch("Parsing LEF files");
 	LEFControlParser lefParser;
 
 	for (int i = 0; i < lefFiles.size(); i++) {
@@ -150,7 +156,6 @@ void GenericReader::parseLEFFiles() {
 // -----------------------------------------------------------------------------
 
 void GenericReader::parseDEFFiles() {
-	Stepwatch watch("Parsing DEF files");
 	DEFControlParser defParser;
 
 	for (int i = 0; i < defFiles.size(); i++) {
@@ -166,8 +171,6 @@ void GenericReader::parseDEFFiles() {
 // -----------------------------------------------------------------------------
 
 void GenericReader::parseVerilogFile() {
-	Stepwatch watch("Parsing Verilog file");
-
 	if (!boost::filesystem::exists(verilogFile)) {
 		std::cout << "[WARNING] Failed to open file " << verilogFile << "\n";
 		std::exit(1);
@@ -206,10 +209,6 @@ void GenericReader::populateDesign() {
 // -----------------------------------------------------------------------------
 
 void GenericReader::parseLibertyFile() {
-	Stepwatch parsingLibertyWatch("Parsing Liberty file");
-
-	Rsyn::Design design = session.getDesign();
-
 	if (!boost::filesystem::exists(libertyFile)) {
 		std::cout << "[WARNING] Failed to open file " << libertyFile << "\n";
 		std::exit(1);
@@ -222,7 +221,6 @@ void GenericReader::parseLibertyFile() {
 // -----------------------------------------------------------------------------
 
 void GenericReader::parseSDCFile() {
-	Stepwatch watchParsingSdc("Parsing SDC file");
 	SDCControlParser sdcParser;
 
 	if (!boost::filesystem::exists(sdcFile)) {
@@ -231,7 +229,6 @@ void GenericReader::parseSDCFile() {
 	} // end if 
 
 	sdcParser.parseSDC_iccad15(sdcFile, sdcInfo);
-	watchParsingSdc.finish();
 } // end method
 
 // -----------------------------------------------------------------------------
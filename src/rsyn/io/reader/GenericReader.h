@@ -36,6 +36,8 @@ class GenericReader : public Reader {
 	bool enableNetlistFromVerilog = false;
 	bool enableRSTT = false;
 	
+	int numParsingThreads = 0; // 0: one thread per input file type
+	
 public:
 	GenericReader() = default;
 	
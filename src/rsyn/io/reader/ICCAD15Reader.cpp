@@ -34,6 +34,7 @@
 #include "rsyn/io/parser/liberty/LibertyControlParser.h"
 #include "rsyn/io/parser/spef/SPEFControlParser.h"
 #include "rsyn/io/parser/verilog/SimplifiedVerilogReader.h"
+#include "rsyn/io/reader/ParsingPipeline.h"
 
 #include "rsyn/phy/PhysicalService.h"
 #include "rsyn/phy/PhysicalDesign.h"
@@ -57,6 +58,7 @@ void ICCAD15Reader::load(const Json &options) {
 	optionSetting = options.value("parms", "");
 	optionMaxDisplacement = options.value("maxDisplacement", 400);
 	optionTargetUtilization = options.value("targetUtilization", 0.85);
+	optionNumParsingThreads = options.value("numParsingThreads", 0);
 	optionBenchmark = boost::filesystem::exists(file) ?
 		file : path + "/" + file;
 	optionSetting = boost::filesystem::exists(optionSetting) ?
@@ -116,32 +118,32 @@ void ICCAD15Reader::openBenchmarkFromICCAD15()  {
 	parseConfigFileICCAD15(path);
 	parseParams(optionSetting);
 
-	Stepwatch watchParsingLibertyEarly("Parsing Liberty (Early)");
-	libParser.parseLiberty(clsFilenameLibertyEarly, libInfosEarly);
-	watchParsingLibertyEarly.finish();
-
-	Stepwatch watchParsingLibertyLate("Parsing Liberty (Late)");
-	libParser.parseLiberty(clsFilenameLibertyLate, libInfosLate);
-	watchParsingLibertyLate.finish();
-
-	Stepwatch watchParsingLef("Parsing LEF");
-	lefParser.parseLEF(clsFilenameLEF, lefDscp);
-	watchParsingLef.finish();
-
-	Stepwatch watchParsingDef("Parsing DEF");
-	defParser.parseDEF(clsFilenameDEF, defDscp);
-	watchParsingDef.finish();
-
-	Stepwatch watchParsingSdc("Parsing SDC");
-	sdcParser.parseSDC_iccad15(clsFilenameSDC, sdcInfos);
-	watchParsingSdc.finish();
-
-	Stepwatch watchParsingVerilog("Parsing Verilog");
+	// The input files are independent until the design is populated, so
+	// they are parsed concurrently. Both Liberty files go in the same stage
+	// as the Liberty parser library keeps global state.
 	Parsing::SimplifiedVerilogReader parser(verilogDesignDescriptor);
-	parser.parseFromFile(clsFilenameV);
-	watchParsingVerilog.finish();
+
+	ParsingPipeline pipeline(optionNumParsingThreads);
+	pipeline.addStage("Liberty (Early/Late)", [&]() {
+		libParser.parseLiberty(clsFilenameLibertyEarly, libInfosEarly);
+		libParser.parseLiberty(clsFilenameLibertyLate, libInfosLate);
+	});
+	pipeline.addStage("LEF", [&]() {
+		lefParser.parseLEF(clsFilenameLEF, lefDscp);
+	});
+	pipeline.addStage("DEF", [&]() {
+		defParser.parseDEF(clsFilenameDEF, defDscp);
+	});
+	pipeline.addStage("SDC", [&]() {
+		sdcParser.parseSDC_iccad15(clsFilenameSDC, sdcInfos);
+	});
+	pipeline.addStage("Verilog", [&]() {
+		parser.parseFromFile(clsFilenameV);
+	});
+	pipeline.run();
 	
 	watchParsing.finish();
+	pipeline.report("Parsing stages");
 	
 	// Create the design.
 	clsDesign = session.getDesign();
@@ -266,11 +268,23 @@ void ICCAD15Reader::openBenchmarkFromICCAD15ForGlobalPlacementOnly() {
 
 	boost::filesystem::path path(optionBenchmark);
 	parseConfigFileICCAD15(path);
-	lefParser.parseLEF(clsFilenameLEF, lefDscp);
-	defParser.parseDEF(clsFilenameDEF, defDscp);
+
 	Parsing::SimplifiedVerilogReader parser(verilogDesignDescriptor);
-	parser.parseFromFile(clsFilenameV);
+
+	ParsingPipeline pipeline(optionNumParsingThreads);
+	pipeline.addStage("LEF", [&]() {
+		lefParser.parseLEF(clsFilenameLEF, lefDscp);
+	});
+	pipeline.addStage("DEF", [&]() {
+		defParser.parseDEF(clsFilenameDEF, defDscp);
+	});
+	pipeline.addStage("Verilog", [&]() {
+		parser.parseFromFile(clsFilenameV);
+	});
+	pipeline.run();
+
 	watchParsing.finish();
+	pipeline.report("Parsing stages");
 	
 	Stepwatch watchRsyn("Populating Rsyn");
 	clsDesign = session.getDesign();
@@ -69,6 +69,7 @@ protected:
 	std::string optionBenchmark;
 	double optionTargetUtilization;
 	double optionMaxDisplacement;
+	int optionNumParsingThreads; // 0: one thread per input file
 	
 	////////////////////////////////////////////////////////////////////////////
 	// Routing
@@ -22,6 +22,7 @@
 #include "rsyn/io/parser/guide-ispd18/GuideParser.h"
 #include "rsyn/io/parser/lef_def/LEFControlParser.h"
 #include "rsyn/io/parser/lef_def/DEFControlParser.h"
+#include "rsyn/io/reader/ParsingPipeline.h"
 #include "rsyn/io/Graphics.h"
 
 namespace Rsyn {
@@ -48,6 +49,9 @@ void ISPD2018Reader::load(const Json& params) {
 		return;
 	} // end if
 	guideFile = session.findFile(params.value("guideFile", ""), path);
+
+	numParsingThreads = params.value("numParsingThreads", 0);
+	streamingDef = params.value("streamingDef", false);
 	
 	parsingFlow();
 } // end method
@@ -55,17 +59,33 @@ void ISPD2018Reader::load(const Json& params) {
 // -----------------------------------------------------------------------------
 
 void ISPD2018Reader::parsingFlow() {
-	parseLEFFile();
-	parseDEFFile();
-	populateDesign();
-	parseGuideFile();
+	// Input files are independent until the design is populated, so they are
+	// parsed concurrently. Guides are loaded once the design is populated.
+	ParsingPipeline pipeline(numParsingThreads);
+	if (streamingDef) {
+		// The DEF populates the design as it is parsed, which requires the
+		// library to be loaded first.
+		pipeline.addStage("LEF + DEF (streaming)", [&]() {
+			parseLEFFile();
+			streamDEFFile();
+		});
+	} else {
+		pipeline.addStage("LEF", [&]() { parseLEFFile(); });
+		pipeline.addStage("DEF", [&]() { parseDEFFile(); });
+	} // end if-else
+	pipeline.addStage("Guide", [&]() { parseGuideFile(); });
+	pipeline.run();
+	pipeline.report("Parsing stages");
+
+	if (!streamingDef)
+		populateDesign();
+	loadGuides();
 	initializeAuxiliarInfrastructure();
 } // end method
 
 // -----------------------------------------------------------------------------
 
 void ISPD2018Reader::parseLEFFile() {
-	Stepwatch watch("Parsing LEF file");
 	LEFControlParser lefParser;
 	lefParser.parseLEF(lefFile, lefDescriptor);
 } // end method
@@ -73,7 +93,6 @@ void ISPD2018Reader::parseLEFFile() {
 // -----------------------------------------------------------------------------
 
 void ISPD2018Reader::parseDEFFile() {
-	Stepwatch watch("Parsing DEF file");
 	DEFControlParser defParser;
 	defParser.parseDEF(defFile, defDescriptor);
 } // end method
@@ -81,10 +100,14 @@ void ISPD2018Reader::parseDEFFile() {
 // -----------------------------------------------------------------------------
 
 void ISPD2018Reader::parseGuideFile() {
-	Stepwatch watch("Parsing guide file");
-	GuideDscp guideDescriptor;
 	GuideParser guideParser;
 	guideParser.parse(guideFile, guideDescriptor);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void ISPD2018Reader::loadGuides() {
+	Stepwatch watch("Loading guides");
 	session.startService("rsyn.routingGuide");
 	routingGuide = (RoutingGuide*) session.getService("rsyn.routingGuide");
 	routingGuide->loadGuides(guideDescriptor);
@@ -97,16 +120,82 @@ void ISPD2018Reader::populateDesign() {
 
 	Reader::populateRsyn(lefDescriptor, defDescriptor, design);
 
+	startPhysicalService();
+	physicalDesign.loadLibrary(lefDescriptor);
+	physicalDesign.loadDesign(defDescriptor);
+	physicalDesign.updateAllNetBounds(false);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void ISPD2018Reader::streamDEFFile() {
+	Rsyn::Design design = session.getDesign();
+
+	populateRsynLibraryFromLef(lefDescriptor, design);
+	startPhysicalService();
+	physicalDesign.loadLibrary(lefDescriptor);
+
+	{
+		// Observers (e.g. the physical service) are notified once, after the
+		// whole design is loaded.
+		Rsyn::DesignEditGuard edit(design);
+
+		DEFControlParser defParser;
+		defParser.parseDEF(defFile, defDescriptor, this);
+
+		// DEF without nets.
+		if (!streamedPorts)
+			populateRsynPorts(defDescriptor.clsPorts, design);
+
+		design.updateName(defDescriptor.clsDesignName);
+
+		defDescriptor.clsNets.swap(routedNets);
+		physicalDesign.loadDesign(defDescriptor);
+		defDescriptor.clsNets.clear();
+		routedNets.clear();
+	} // end block
+
+	physicalDesign.updateAllNetBounds(false);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void ISPD2018Reader::onComponents(DefDscp &defDscp) {
+	populateRsynCells(defDscp.clsComps, session.getDesign());
+	physicalDesign.loadDesignComponents(defDscp.clsComps);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void ISPD2018Reader::onNets(DefDscp &defDscp) {
+	// The PINS section precedes the NETS section.
+	if (!streamedPorts) {
+		populateRsynPorts(defDscp.clsPorts, session.getDesign());
+		streamedPorts = true;
+	} // end if
+
+	populateRsynNets(defDscp.clsNets, session.getDesign());
+
+	// Wires may use vias defined in the DEF, which are only loaded with the
+	// rest of the design. So the wires of routed nets are kept until then.
+	for (DefNetDscp &net : defDscp.clsNets) {
+		if (!net.clsWires.empty()) {
+			net.clsConnections.clear();
+			routedNets.push_back(std::move(net));
+		} // end if
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void ISPD2018Reader::startPhysicalService() {
 	Json physicalDesignConfiguration;
 	physicalDesignConfiguration["clsEnableMergeRectangles"] = true;
 	physicalDesignConfiguration["clsEnableNetPinBoundaries"] = true;
 	physicalDesignConfiguration["clsEnableRowSegments"] = true;
 	session.startService("rsyn.physical", physicalDesignConfiguration);
 	Rsyn::PhysicalService* phService = session.getService("rsyn.physical");
-	Rsyn::PhysicalDesign physicalDesign = phService->getPhysicalDesign();
-	physicalDesign.loadLibrary(lefDescriptor);
-	physicalDesign.loadDesign(defDescriptor);
-	physicalDesign.updateAllNetBounds(false);
+	physicalDesign = phService->getPhysicalDesign();
 } // end method
 
 void ISPD2018Reader::initializeAuxiliarInfrastructure() {
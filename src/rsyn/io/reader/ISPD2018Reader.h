@@ -17,12 +17,15 @@
 #define RSYN_ISPD2018READER_H
 
 #include "rsyn/session/Session.h"
+#include "rsyn/phy/PhysicalDesign.h"
+#include "rsyn/io/parser/guide-ispd18/GuideDescriptor.h"
+#include "rsyn/io/parser/lef_def/DEFControlParser.h"
 
 namespace Rsyn  {
 	
 class RoutingGuide;
 	
-class ISPD2018Reader : public Reader {
+class ISPD2018Reader : public Reader, private DefStreamHandler {
 public:
 	ISPD2018Reader() = default;
 	void load(const Json& params) override;
@@ -35,14 +38,29 @@ private:
 	std::string guideFile;
 	LefDscp lefDescriptor;
 	DefDscp defDescriptor;
+	GuideDscp guideDescriptor;
 	RoutingGuide *routingGuide;
+	int numParsingThreads = 0; // 0: one thread per input file
+
+	// When streaming, the design is populated while the DEF is parsed so that
+	// components and nets are never stored all at once.
+	bool streamingDef = false;
+	bool streamedPorts = false;
+	Rsyn::PhysicalDesign physicalDesign;
+	std::vector<DefNetDscp> routedNets;
 	
 	void parsingFlow();
 	void parseLEFFile();
 	void parseDEFFile();
 	void parseGuideFile();
 	void populateDesign();
+	void streamDEFFile();
+	void startPhysicalService();
+	void loadGuides();
 	void initializeAuxiliarInfrastructure();
+
+	void onComponents(DefDscp &defDscp) override;
+	void onNets(DefDscp &defDscp) override;
 };
 
 }
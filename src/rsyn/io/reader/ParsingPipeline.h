@@ -0,0 +1,159 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_PARSING_PIPELINE_H
+#define RSYN_PARSING_PIPELINE_H
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rsyn/util/Stopwatch.h"
+#include "rsyn/util/StreamStateSaver.h"
+
+namespace Rsyn {
+
+// Runs independent parsing stages (e.g. LEF, DEF, Verilog) concurrently and
+// waits for all of them to finish. Each stage must write to its own
+// descriptor. Parsers sharing global state (e.g. two Liberty files parsed by
+// the same library) must be placed in the same stage.
+//
+// With a single thread, stages run in the calling thread in the order they
+// were added, which is the same as the sequential flow.
+
+class ParsingPipeline {
+public:
+
+	// Zero threads means one thread per stage, up to the number of hardware
+	// threads.
+	ParsingPipeline(const int numThreads = 0) : clsNumThreads(numThreads) {}
+
+	void addStage(const std::string &name, std::function<void()> task) {
+		Stage stage;
+		stage.propName = name;
+		stage.propTask = task;
+		stage.propRuntime = 0;
+		clsStages.push_back(stage);
+	} // end method
+
+	// Runs all stages. If a stage throws, the exception is re-thrown once all
+	// stages have finished.
+	void run() {
+		const int numStages = (int) clsStages.size();
+		const int numThreads = std::max(1, std::min(numStages, getNumThreads()));
+
+		Stopwatch watch;
+		watch.start();
+
+		std::vector<std::exception_ptr> exceptions(numStages);
+		std::atomic<int> next(0);
+
+		auto worker = [&]() {
+			while (true) {
+				const int index = next++;
+				if (index >= numStages)
+					break;
+
+				Stage &stage = clsStages[index];
+				Stopwatch stageWatch;
+				stageWatch.start();
+				try {
+					stage.propTask();
+				} catch (...) {
+					exceptions[index] = std::current_exception();
+				} // end catch
+				stageWatch.stop();
+				stage.propRuntime = stageWatch.getElapsedTime();
+			} // end while
+		}; // end lambda
+
+		if (numThreads == 1) {
+			worker();
+		} else {
+			std::vector<std::thread> threads;
+			for (int i = 0; i < numThreads; i++) {
+				threads.emplace_back(worker);
+			} // end for
+			for (std::thread &thread : threads) {
+				thread.join();
+			} // end for
+		} // end if-else
+
+		watch.stop();
+		clsRuntime = watch.getElapsedTime();
+		clsNumThreadsUsed = numThreads;
+
+		for (const std::exception_ptr &exception : exceptions) {
+			if (exception) {
+				std::rethrow_exception(exception);
+			} // end if
+		} // end for
+	} // end method
+
+	// Prints the runtime of each stage.
+	void report(const std::string &title, std::ostream &out = std::cout) const {
+		StreamStateSaver sss(out);
+
+		const std::string total = "Total (wall)";
+		double sum = 0;
+		int width = (int) total.size();
+		for (const Stage &stage : clsStages) {
+			sum += stage.propRuntime;
+			width = std::max(width, (int) stage.propName.size());
+		} // end for
+
+		out << title << " (" << clsStages.size() << " stages, "
+				<< clsNumThreadsUsed << " thread(s))\n";
+		for (const Stage &stage : clsStages) {
+			out << "\t" << std::left << std::setw(width) << stage.propName
+					<< std::right << " " << std::setw(10) << std::fixed
+					<< std::setprecision(3) << stage.propRuntime << " s\n";
+		} // end for
+		out << "\t" << std::left << std::setw(width) << total
+				<< std::right << " " << std::setw(10) << clsRuntime << " s"
+				<< " (sum of stages: " << sum << " s)\n";
+	} // end method
+
+	int getNumThreads() const {
+		if (clsNumThreads > 0)
+			return clsNumThreads;
+		return std::max(1u, std::thread::hardware_concurrency());
+	} // end method
+
+	double getRuntime() const { return clsRuntime; }
+
+private:
+
+	struct Stage {
+		std::string propName;
+		std::function<void()> propTask;
+		double propRuntime;
+	}; // end struct
+
+	std::vector<Stage> clsStages;
+	int clsNumThreads;
+	int clsNumThreadsUsed = 1;
+	double clsRuntime = 0;
+}; // end class
+
+} // end namespace
+
+#endif
@@ -145,7 +145,12 @@ void PopulateRsyn::populateRsynNetlistFromVerilog(
 		} // end else
 	} // end for
 
-	// Creates cells.
+	// Reserves memory for the netlist objects so that they are allocated at
+	// once.
+	std::vector<Rsyn::LibraryCell> lcells;
+	lcells.reserve(verilogDesign.components.size());
+	int numPins = 0;
+	int numArcs = 0;
 	for (auto &component : verilogDesign.components) {
 		Rsyn::LibraryCell lcell =
 			rsynDesign.findLibraryCellByName(component.id);
@@ -154,7 +159,17 @@ void PopulateRsyn::populateRsynNetlistFromVerilog(
 			string str = "Library cell " + component.id + " not found\n";
 			throw Exception(str);
 		} // end if
-		top.createCell(lcell, component.name);
+		lcells.push_back(lcell);
+		numPins += lcell.getNumPins();
+		numArcs += lcell.getNumArcs();
+	} // end for
+
+	rsynDesign.reserve((int) verilogDesign.components.size(), numPins,
+			(int) verilogDesign.nets.size(), numArcs);
+
+	// Creates cells.
+	for (int i = 0; i < (int) verilogDesign.components.size(); i++) {
+		top.createCell(lcells[i], verilogDesign.components[i].name);
 	} // end for
 
 	// Creates nets and connections.
@@ -348,10 +363,6 @@ void PopulateRsyn::populateRsyn(
 	const DefDscp &defDscp,
 	Rsyn::Design rsynDesign) {
 
-	bool keepWarning;
-	int keepWarningCounter;
-
-	Rsyn::Module top = rsynDesign.getTopModule();
 	rsynDesign.updateName(defDscp.clsDesignName);
 
 	// Create library cells.
@@ -360,18 +371,35 @@ void PopulateRsyn::populateRsyn(
 	// also cells using LEF.
 	populateRsynLibraryFromLef(lefDscp, rsynDesign);
 
-	// Creates ports.
-	for (const DefPortDscp &port : defDscp.clsPorts) {
+	populateRsynPorts(defDscp.clsPorts, rsynDesign);
+	populateRsynCells(defDscp.clsComps, rsynDesign);
+	populateRsynNets(defDscp.clsNets, rsynDesign);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void PopulateRsyn::populateRsynPorts(
+	const std::vector<DefPortDscp> &ports,
+	Rsyn::Design rsynDesign) {
+
+	Rsyn::Module top = rsynDesign.getTopModule();
+	for (const DefPortDscp &port : ports) {
 
 		const Rsyn::Direction direction =
 			(port.clsDirection == "INPUT") ? Rsyn::IN : Rsyn::OUT;
 
 		top.createPort(direction, port.clsName);
 	} // end for
+} // end method
 
+// -----------------------------------------------------------------------------
 
-	//	// Creates cells.
-	for (const DefComponentDscp &component : defDscp.clsComps) {
+void PopulateRsyn::populateRsynCells(
+	const std::vector<DefComponentDscp> &components,
+	Rsyn::Design rsynDesign) {
+
+	Rsyn::Module top = rsynDesign.getTopModule();
+	for (const DefComponentDscp &component : components) {
 		Rsyn::LibraryCell lcell =
 			rsynDesign.findLibraryCellByName(component.clsMacroName);
 
@@ -381,10 +409,16 @@ void PopulateRsyn::populateRsyn(
 		} // end if
 		top.createCell(lcell, component.clsName);
 	} // end for
+} // end method
 
+// -----------------------------------------------------------------------------
 
-	// Creates nets and connections.
-	for (const DefNetDscp &net : defDscp.clsNets) {
+void PopulateRsyn::populateRsynNets(
+	const std::vector<DefNetDscp> &nets,
+	Rsyn::Design rsynDesign) {
+
+	Rsyn::Module top = rsynDesign.getTopModule();
+	for (const DefNetDscp &net : nets) {
 		if (net.clsName == "") {
 			std::cout << "[ERROR] Empty net name.\n";
 			for (unsigned i = 0; i < net.clsConnections.size(); i++) {
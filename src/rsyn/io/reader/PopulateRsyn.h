@@ -67,6 +67,21 @@ protected:
 		const DefDscp &defDscp,
 		Rsyn::Design rsynDesign);
 
+	// The pieces of populateRsyn(lef, def, design). They may be called
+	// several times (e.g. once per batch when the DEF is streamed). Ports
+	// and cells must be created before the nets connected to them.
+	virtual void populateRsynPorts(
+		const std::vector<DefPortDscp> &ports,
+		Rsyn::Design rsynDesign);
+
+	virtual void populateRsynCells(
+		const std::vector<DefComponentDscp> &components,
+		Rsyn::Design rsynDesign);
+
+	virtual void populateRsynNets(
+		const std::vector<DefNetDscp> &nets,
+		Rsyn::Design rsynDesign);
+
 };
 
 } // end namespace 
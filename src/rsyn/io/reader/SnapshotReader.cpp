@@ -0,0 +1,195 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "SnapshotReader.h"
+#include "rsyn/util/Stepwatch.h"
+#include "rsyn/phy/PhysicalService.h"
+#include "rsyn/phy/PhysicalDesign.h"
+#include "rsyn/io/parser/snapshot/SnapshotParser.h"
+#include "rsyn/io/Graphics.h"
+#include "rsyn/model/timing/Timer.h"
+#include "rsyn/model/timing/DefaultTimingModel.h"
+#include "rsyn/model/routing/RoutingEstimator.h"
+#include "rsyn/model/routing/DefaultRoutingEstimationModel.h"
+#include "rsyn/model/routing/DefaultRoutingExtractionModel.h"
+#include "rsyn/model/routing/RsttRoutingEstimatorModel.h"
+#include "rsyn/model/library/LibraryCharacterizer.h"
+#include "rsyn/model/scenario/Scenario.h"
+
+namespace Rsyn {
+
+void SnapshotReader::load(const Json& params) {
+	std::string path = params.value("path", "");
+
+	if (!params.count("file")) {
+		std::cout << "[ERROR] Snapshot file not specified...\n";
+		return;
+	} // end if
+	snapshotFile = session.findFile(params.value("file", ""), path);
+
+	parseSnapshotFile();
+	populateDesign();
+	initializeAuxiliarInfrastructure();
+
+	// Release the descriptors, they are not needed anymore.
+	snapshotDscp = SnapshotDscp();
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void SnapshotReader::parseSnapshotFile() {
+	Stepwatch watch("Parsing snapshot");
+	SnapshotParser parser;
+	parser.parse(snapshotFile, snapshotDscp);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void SnapshotReader::populateDesign() {
+	Stepwatch watch("Populating the design");
+
+	Rsyn::Design design = session.getDesign();
+	design.updateName(snapshotDscp.clsDesignName);
+
+	for (const SnapshotLibraryCellDscp &cellDscp : snapshotDscp.clsLibraryCells) {
+		Rsyn::CellDescriptor dscp;
+		dscp.setName(cellDscp.clsName);
+		for (const SnapshotLibraryPinDscp &pinDscp : cellDscp.clsPins) {
+			dscp.addPin(pinDscp.clsName, (Rsyn::Direction) pinDscp.clsDirection);
+		} // end for
+		for (const SnapshotLibraryArcDscp &arcDscp : cellDscp.clsArcs) {
+			dscp.addArc(arcDscp.clsFromPinName, arcDscp.clsToPinName);
+		} // end for
+		design.createLibraryCell(dscp, true);
+	} // end for
+
+	const DefDscp &defDscp = snapshotDscp.clsDefDscp;
+	{
+		Rsyn::DesignEditGuard edit(design);
+		populateRsynPorts(defDscp.clsPorts, design);
+		populateRsynCells(defDscp.clsComps, design);
+		populateRsynNets(defDscp.clsNets, design);
+	} // end block
+
+	if (!snapshotDscp.clsHasPhysicalDesign)
+		return;
+
+	Json physicalDesignConfiguration;
+	physicalDesignConfiguration["clsEnablePhysicalPins"] = snapshotDscp.clsEnablePhysicalPins;
+	physicalDesignConfiguration["clsEnableMergeRectangles"] = snapshotDscp.clsEnableMergeRectangles;
+	physicalDesignConfiguration["clsEnableNetPinBoundaries"] = snapshotDscp.clsEnableNetPinBoundaries;
+	session.startService("rsyn.physical", physicalDesignConfiguration);
+	Rsyn::PhysicalService* phService = session.getService("rsyn.physical");
+	Rsyn::PhysicalDesign physicalDesign = phService->getPhysicalDesign();
+	for (const LefDscp &lefDscp : snapshotDscp.clsLefDscps) {
+		physicalDesign.loadLibrary(lefDscp);
+	} // end for
+	physicalDesign.loadDesign(defDscp);
+	physicalDesign.updateAllNetBounds(false);
+	if (!snapshotDscp.clsClockNetName.empty())
+		physicalDesign.setClockNet(design.findNetByName(snapshotDscp.clsClockNetName));
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void SnapshotReader::initializeTiming() {
+	Rsyn::Design design = session.getDesign();
+
+	Stepwatch watchScenario("Loading scenario");
+	session.startService("rsyn.scenario", {});
+	Rsyn::Scenario* scenario = session.getService("rsyn.scenario");
+	scenario->init(design, snapshotDscp.clsLibInfoEarly,
+			snapshotDscp.clsLibInfoLate, snapshotDscp.clsSdcInfo);
+	watchScenario.finish();
+
+	RoutingEstimationModel* routingEstimationModel;
+	if (!snapshotDscp.clsEnableRSTT) {
+		session.startService("rsyn.defaultRoutingEstimationModel", {});
+		DefaultRoutingEstimationModel* defaultRoutingEstimationModel =
+			session.getService("rsyn.defaultRoutingEstimationModel");
+		routingEstimationModel = defaultRoutingEstimationModel;
+	} else {
+		session.startService("rsyn.RSTTroutingEstimationModel");
+		RsttRoutingEstimatorModel* rsstRoutingEstimationModel =
+			session.getService("rsyn.RSTTroutingEstimationModel");
+		routingEstimationModel = rsstRoutingEstimationModel;
+	} // end if
+
+	session.startService("rsyn.defaultRoutingExtractionModel", {});
+	DefaultRoutingExtractionModel* routingExtractionModel =
+		session.getService("rsyn.defaultRoutingExtractionModel");
+	routingExtractionModel->initialize(
+		(Number) snapshotDscp.clsWireResistancePerDBU,
+		(Number) snapshotDscp.clsWireCapacitancePerDBU,
+		snapshotDscp.clsMaxWireSegmentLength);
+
+	session.startService("rsyn.routingEstimator", {});
+	RoutingEstimator *routingEstimator = session.getService("rsyn.routingEstimator");
+	Stepwatch updateSteiner("Updating Steiner trees");
+	routingEstimator->setRoutingEstimationModel(routingEstimationModel);
+	routingEstimator->setRoutingExtractionModel(routingExtractionModel);
+	routingEstimator->updateRoutingFull();
+	updateSteiner.finish();
+
+	session.startService("rsyn.timer", {});
+	Rsyn::Timer* timer = session.getService("rsyn.timer");
+
+	Stepwatch watchInit("Initializing timer");
+	timer->init(
+		design,
+		session,
+		scenario,
+		snapshotDscp.clsLibInfoEarly,
+		snapshotDscp.clsLibInfoLate);
+	watchInit.finish();
+
+	Stepwatch watchInitModel("Initializing default timing model");
+	session.startService("rsyn.defaultTimingModel", {});
+	DefaultTimingModel* timingModel = session.getService("rsyn.defaultTimingModel");
+	timer->setTimingModel(timingModel);
+	watchInitModel.finish();
+
+	Stepwatch watchInitLogicalEffort("Library characterization");
+	session.startService("rsyn.libraryCharacterizer", {});
+	LibraryCharacterizer *libc = session.getService("rsyn.libraryCharacterizer");
+	libc->runLibraryAnalysis(design, timingModel);
+	watchInitLogicalEffort.finish();
+
+	Stepwatch updateTiming("Updating timing");
+	timer->updateTimingFull();
+	updateTiming.finish();
+
+	session.startService("rsyn.report", {});
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void SnapshotReader::initializeAuxiliarInfrastructure() {
+	if (!snapshotDscp.clsHasPhysicalDesign)
+		return;
+
+	if (snapshotDscp.clsHasTiming)
+		initializeTiming();
+
+	// Start graphics service...
+	session.startService("rsyn.graphics",{});
+	Graphics *graphics = session.getService("rsyn.graphics");
+	graphics->coloringByCellType();
+
+	// Start writer service...
+	session.startService("rsyn.writer",{});
+} // end method
+
+} // end namespace
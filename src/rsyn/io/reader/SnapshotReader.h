@@ -0,0 +1,50 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_SNAPSHOTREADER_H
+#define RSYN_SNAPSHOTREADER_H
+
+#include "rsyn/session/Session.h"
+#include "rsyn/io/parser/snapshot/SnapshotDescriptor.h"
+
+namespace Rsyn {
+
+// Restores a design saved by the "writeSnapshot" command:
+//     open snapshot {"file": "design.snapshot"}
+// The netlist, the placement, the routing and the physical design are
+// restored. If the snapshot has timing data, the scenario, routing estimator
+// and timer are started from it and the timing is updated, as done by the
+// readers that parse Liberty and SDC files.
+
+class SnapshotReader : public Reader {
+public:
+	SnapshotReader() = default;
+	void load(const Json& params) override;
+
+private:
+	Session session;
+
+	std::string snapshotFile;
+	SnapshotDscp snapshotDscp;
+
+	void parseSnapshotFile();
+	void populateDesign();
+	void initializeTiming();
+	void initializeAuxiliarInfrastructure();
+}; // end class
+
+} // end namespace
+
+#endif /* RSYN_SNAPSHOTREADER_H */
@@ -33,7 +33,12 @@
 #include "rsyn/core/Rsyn.h"
 #include "rsyn/util/dbu.h"
 #include "rsyn/util/Proxy.h"
+#include "rsyn/util/ThreadPool.h"
 #include <vector>
+#include <memory>
+#include <functional>
+#include <cstdint>
+#include <cmath>
 
 
 namespace Rsyn {
@@ -57,6 +62,7 @@ enum PinType : std::int8_t {
 
 class DensityGridBlockage;
 class DensityGridBin;
+class DensityGridAbuHistogram;
 class DensityGridData;
 
 class DensityGrid;
@@ -67,6 +73,7 @@ class DensityGrid;
 
 #include "rsyn/model/congestion/DensityGrid/data/DensityGridBin.h"
 #include "rsyn/model/congestion/DensityGrid/data/DensityGridBlockage.h"
+#include "rsyn/model/congestion/DensityGrid/data/DensityGridAbuHistogram.h"
 #include "rsyn/model/congestion/DensityGrid/data/DensityGridData.h"
 
 #include "rsyn/model/congestion/DensityGrid/impl/DensityGrid.h"
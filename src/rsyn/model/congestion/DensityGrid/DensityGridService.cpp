@@ -24,6 +24,11 @@
 #include "DensityGridService.h"
 #include "rsyn/session/Session.h"
 #include "rsyn/phy/PhysicalService.h"
+#include "rsyn/util/Stopwatch.h"
+
+#include <iomanip>
+#include <random>
+#include <set>
 
 namespace Rsyn {
 
@@ -45,19 +50,336 @@ void DensityGridService::start(const Rsyn::Json &params) {
 	int numRows = 9; 
 	bool showDetails = false;
 	bool keepRowBounds = false;
+	bool incremental = false;
+	int numThreads = 1;
 	targetUtil = params.value("density", targetUtil);
 	numRows = params.value("numRows", numRows);
 	showDetails = params.value("showDetails", showDetails);
 	keepRowBounds = params.value("keepRowBounds", keepRowBounds);
+	incremental = params.value("incremental", incremental);
+	numThreads = params.value("numThreads", numThreads);
 	//module = params.value("module", module);
-	clsDensityGrid.init(phDsg, module, targetUtil, numRows, showDetails, keepRowBounds);
+	clsDensityGrid.init(phDsg, module, targetUtil, numRows, showDetails, keepRowBounds, numThreads);
 	clsDensityGrid.updateArea(MOVABLE_AREA);
+
+	if (incremental) {
+		clsDensityGrid.enableIncrementalMode();
+		clsDesign = dsg;
+		clsDesign.registerObserver(this);
+		clsPhDesign = phDsg;
+		clsPhDesign.registerObserver(this);
+	} // end if 
+
+	{ // benchmarkDensityGrid
+		ScriptParsing::CommandDescriptor dscp;
+		dscp.setName("benchmarkDensityGrid");
+		dscp.setDescription("Reports the runtime to build the density grid "
+			"(areas and blockages) for several bin sizes using one and "
+			"multiple threads.");
+
+		dscp.addNamedParam("binSizes",
+			ScriptParsing::PARAM_TYPE_JSON,
+			ScriptParsing::PARAM_SPEC_OPTIONAL,
+			"Bin sizes in number of rows (default: [1, 2, 4, 9, 16, 32, 64]).",
+			"");
+
+		dscp.addNamedParam("numThreads",
+			ScriptParsing::PARAM_TYPE_INTEGER,
+			ScriptParsing::PARAM_SPEC_OPTIONAL,
+			"Number of threads (0 uses all hardware threads).",
+			"0");
+
+		session.registerCommand(dscp, [this, phDsg](const ScriptParsing::Command &command) {
+			const Json binSizes = command.getParam("binSizes");
+			const int numThreads = command.getParam("numThreads");
+
+			std::vector<double> sizes = {1, 2, 4, 9, 16, 32, 64};
+			if (binSizes.is_array()) {
+				sizes.clear();
+				for (const Json & size : binSizes)
+					sizes.push_back(size);
+			} // end if 
+
+			benchmark(phDsg, sizes, numThreads > 0 ? numThreads :
+				std::max(2u, std::thread::hardware_concurrency()));
+		});
+	} // end block
+
+	{ // checkDensityGridIncremental
+		ScriptParsing::CommandDescriptor dscp;
+		dscp.setName("checkDensityGridIncremental");
+		dscp.setDescription("Moves, creates and remaps random cells and "
+			"checks that the incremental bin areas and ABU match a full "
+			"update. Requires the incremental mode. Modifies the design.");
+
+		dscp.addNamedParam("numSteps",
+			ScriptParsing::PARAM_TYPE_INTEGER,
+			ScriptParsing::PARAM_SPEC_OPTIONAL,
+			"Number of random edits.",
+			"1000");
+
+		dscp.addNamedParam("seed",
+			ScriptParsing::PARAM_TYPE_INTEGER,
+			ScriptParsing::PARAM_SPEC_OPTIONAL,
+			"Seed of the random number generator.",
+			"0");
+
+		session.registerCommand(dscp, [&](const ScriptParsing::Command &command) {
+			const int numSteps = command.getParam("numSteps");
+			const int seed = command.getParam("seed");
+			checkIncremental(numSteps, seed);
+		});
+	} // end block
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+void DensityGridService::benchmark(Rsyn::PhysicalDesign phDesign,
+		const std::vector<double> &binSizes, const int numThreads) {
+	Rsyn::DensityGrid grid = clsDensityGrid;
+	if (!grid.isInitialized())
+		return;
+
+	const DBU originalBinSize = grid.getBinSize();
+	const int originalNumThreads = grid.getNumThreads();
+	const bool hasRowBounds = grid.hasRowBounds();
+	const bool hasBlockages = grid.hasBlockages();
+
+	const int W1 = 10;
+	const int W2 = 14;
+
+	std::cout
+			<< std::setw(W1) << "Bin Size"
+			<< std::setw(W2) << "Num Bins"
+			<< std::setw(W2) << "1 Thread (s)"
+			<< std::setw(W2) << std::to_string(numThreads) + " Threads (s)"
+			<< std::setw(W2) << "Speedup"
+			<< std::setw(W2) << "Mismatches"
+			<< "\n";
+
+	std::vector<DBU> reference;
+	std::vector<int> referenceBlockages;
+	for (const double binSize : binSizes) {
+		const DBU binLength = static_cast<DBU> (binSize * phDesign.getRowHeight());
+		if (binLength <= 0)
+			continue;
+
+		Stopwatch watch[2];
+		int numMismatches = 0;
+		for (int i = 0; i < 2; i++) {
+			grid.setNumThreads(i == 0 ? 1 : numThreads);
+
+			watch[i].start();
+			grid.updateBinLength(binLength, false, hasRowBounds);
+			grid.updateArea(MOVABLE_AREA);
+			grid.initBlockages();
+			watch[i].stop();
+
+			// Results must not depend on the number of threads.
+			const std::vector<DensityGridBin> & bins = grid.allBins();
+			if (i == 0) {
+				reference.clear();
+				referenceBlockages.clear();
+			} // end if 
+			for (int b = 0; b < (int) bins.size(); b++) {
+				const DensityGridBin & bin = bins[b];
+				const int numBlockages = (int) bin.allDensityGridBlockage().size();
+				if (i == 0) {
+					for (int type = 0; type < NUM_AREAS; type++)
+						reference.push_back(bin.getArea((AreaType) type));
+					referenceBlockages.push_back(numBlockages);
+				} else {
+					bool mismatch = numBlockages != referenceBlockages[b];
+					for (int type = 0; type < NUM_AREAS; type++)
+						mismatch |= bin.getArea((AreaType) type) != reference[b * NUM_AREAS + type];
+					numMismatches += mismatch;
+				} // end if-else
+			} // end for 
+		} // end for 
+
+		std::cout
+				<< std::setw(W1) << binSize
+				<< std::setw(W2) << grid.getNumBins()
+				<< std::setw(W2) << watch[0].getElapsedTime()
+				<< std::setw(W2) << watch[1].getElapsedTime()
+				<< std::setw(W2) << (watch[0].getElapsedTime() /
+					std::max(1e-9, watch[1].getElapsedTime()))
+				<< std::setw(W2) << numMismatches
+				<< "\n";
+	} // end for 
+
+	// Restore the grid.
+	grid.setNumThreads(originalNumThreads);
+	grid.updateBinLength(originalBinSize, false, hasRowBounds);
+	grid.updateArea(MOVABLE_AREA);
+	if (hasBlockages)
+		grid.initBlockages();
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+int DensityGridService::checkIncremental(const int numSteps, const unsigned seed) {
+	Rsyn::DensityGrid grid = clsDensityGrid;
+	if (!grid.isInitialized() || !grid.isIncrementalModeEnabled()) {
+		std::cout << "[ERROR] The density grid is not in incremental mode.\n";
+		return -1;
+	} // end if 
+
+	Rsyn::Module module = clsDesign.getTopModule();
+	std::vector<Rsyn::Cell> cells;
+	for (Rsyn::Instance instance : module.allInstances()) {
+		if (instance.getType() == Rsyn::CELL && instance.isMovable())
+			cells.push_back(instance.asCell());
+	} // end for 
+	if (cells.empty()) {
+		std::cout << "[ERROR] The design has no movable cells.\n";
+		return -1;
+	} // end if 
+
+	std::vector<Rsyn::LibraryCell> libraryCells;
+	for (Rsyn::LibraryCell libraryCell : clsDesign.allLibraryCells())
+		libraryCells.push_back(libraryCell);
+
+	const Bounds & dieBounds = clsPhDesign.getPhysicalDie().getBounds();
+	std::mt19937 rng(seed);
+	auto random = [&](const DBU min, const DBU max) {
+		return std::uniform_int_distribution<DBU>(min, std::max(min, max))(rng);
+	}; // end lambda
+
+	// Edits are checked in batches. Every other batch is done inside an edit
+	// transaction, where cells can not be moved as they are only placed when
+	// the transaction is committed.
+	const int batchSize = 100;
+	int numMoves = 0;
+	int numCreates = 0;
+	int numRemaps = 0;
+	int numChecks = 0;
+	int numMismatches = 0;
+	double maxError = 0;
+	for (int step = 0; step < numSteps; ) {
+		const bool transaction = (step / batchSize) % 2 == 1;
+		const int last = std::min(numSteps, step + batchSize);
+		if (transaction)
+			clsDesign.beginEdit();
+		for (; step < last; step++) {
+			const int operation = random(transaction ? 1 : 0, 2);
+			Rsyn::Cell cell = cells[random(0, cells.size() - 1)];
+			if (operation == 0) {
+				const Rsyn::PhysicalCell phCell = clsPhDesign.getPhysicalCell(cell);
+				clsPhDesign.placeCell(phCell,
+					random(dieBounds[LOWER][X], dieBounds[UPPER][X] - phCell.getWidth()),
+					random(dieBounds[LOWER][Y], dieBounds[UPPER][Y] - phCell.getHeight()));
+				numMoves++;
+			} else if (operation == 1) {
+				cells.push_back(module.createCell(cell.getLibraryCell()));
+				numCreates++;
+			} else {
+				Rsyn::LibraryCell libraryCell = libraryCells[random(0, libraryCells.size() - 1)];
+				try {
+					cell.remap(libraryCell);
+					numRemaps++;
+				} catch (const IncompatibleLibraryCellForRemapping &) {
+				} // end try-catch
+			} // end if-else
+		} // end for 
+		if (transaction)
+			clsDesign.commitEdit();
+
+		// Compare against a full update. Enabling the incremental mode again
+		// rebuilds the histogram from the bins.
+		std::vector<DBU> areas(grid.getNumBins());
+		for (int i = 0; i < grid.getNumBins(); i++)
+			areas[i] = grid.getDensityGridBin(i).getArea(MOVABLE_AREA);
+		grid.updateAbu();
+		const double incrementalAbu = grid.getAbu();
+
+		grid.disableIncrementalMode();
+		grid.updateAbu();
+		const double abu = grid.getAbu();
+		grid.enableIncrementalMode();
+
+		int numAreaMismatches = 0;
+		for (int i = 0; i < grid.getNumBins(); i++) {
+			if (areas[i] != grid.getDensityGridBin(i).getArea(MOVABLE_AREA))
+				numAreaMismatches++;
+		} // end for 
+
+		const double error = std::abs(incrementalAbu - abu);
+		maxError = std::max(maxError, error);
+		if (numAreaMismatches || error > 1e-6 * std::max(1.0, abu)) {
+			if (numMismatches < 10) {
+				std::cout << "[ERROR] Incremental density grid mismatch after "
+					<< step << " edits: " << numAreaMismatches << " bin(s), "
+					<< "ABU " << incrementalAbu << " (incremental) " << abu 
+					<< " (full).\n";
+			} // end if 
+			numMismatches++;
+		} // end if 
+		numChecks++;
+	} // end for 
+
+	std::cout << "Edits (moves/creates/remaps): " << numMoves << " / " 
+		<< numCreates << " / " << numRemaps << "\n";
+	std::cout << "Checks: " << numChecks << "\n";
+	std::cout << "Mismatches: " << numMismatches << "\n";
+	std::cout << "Max ABU error: " << maxError << "\n";
+
+	return numMismatches;
 } // end method 
 
 // -----------------------------------------------------------------------------
 
 void DensityGridService::stop() {
-	
+	if (clsDesign) {
+		clsDesign.unregisterObserver(this);
+		clsDesign = nullptr;
+	} // end if 
+	if (clsPhDesign) {
+		clsPhDesign.unregisterObserver(this);
+		clsPhDesign = nullptr;
+	} // end if 
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+void DensityGridService::onPostInstanceCreate(Rsyn::Instance instance) {
+	clsDensityGrid.addCellArea(instance);
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+void DensityGridService::onPostCellRemap(Rsyn::Cell cell, Rsyn::LibraryCell oldLibraryCell) {
+	clsDensityGrid.remapCellArea(cell, oldLibraryCell);
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+void DensityGridService::onPostDesignEdit(const Rsyn::DesignChangeSet &changes) {
+	// Cells created in the edit are added with their final size, so their 
+	// remaps are skipped.
+	std::set<Rsyn::Instance> createdInstances;
+	for (Rsyn::Instance instance : changes.createdInstances) {
+		clsDensityGrid.addCellArea(instance);
+		createdInstances.insert(instance);
+	} // end for 
+
+	for (const std::tuple<Rsyn::Cell, Rsyn::LibraryCell> &remap : changes.remappedCells) {
+		Rsyn::Cell cell = std::get<0>(remap);
+		if (!createdInstances.count(cell))
+			clsDensityGrid.remapCellArea(cell, std::get<1>(remap));
+	} // end for 
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+void DensityGridService::onPreMovedInstance(Rsyn::Instance instance) {
+	clsDensityGrid.removeCellArea(instance);
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+void DensityGridService::onPostMovedInstance(Rsyn::PhysicalInstance phInstance) {
+	clsDensityGrid.addCellArea(phInstance.getInstance());
 } // end method 
 
 } // end namespace
\ No newline at end of file
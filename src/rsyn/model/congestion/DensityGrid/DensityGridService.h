@@ -36,16 +36,37 @@
 
 namespace Rsyn {
 
-class DensityGridService : public Rsyn::Service {
+class DensityGridService : public Rsyn::Service, public Rsyn::Observer, 
+	public Rsyn::PhysicalObserver {
 private:
 	Rsyn::DensityGrid clsDensityGrid;
+	Rsyn::Design clsDesign;
+	Rsyn::PhysicalDesign clsPhDesign;
 public:
 
 	DensityGridService () {}
 	virtual void start(const Json &params) override;
 	virtual void stop() override;
 
+	// In incremental mode, keeps the density grid up to date as cells are 
+	// created, moved and remapped.
+	virtual void onPostInstanceCreate(Rsyn::Instance instance) override;
+	virtual void onPostCellRemap(Rsyn::Cell cell, Rsyn::LibraryCell oldLibraryCell) override;
+	virtual void onPostDesignEdit(const Rsyn::DesignChangeSet &changes) override;
+	virtual void onPreMovedInstance(Rsyn::Instance instance) override;
+	virtual void onPostMovedInstance(Rsyn::PhysicalInstance phInstance) override;
+
 	Rsyn::DensityGrid getDensityGrid() { return clsDensityGrid; }
+
+	// Reports the runtime to build the grid for each bin size (in rows) using 
+	// one and numThreads threads. The grid is restored afterwards.
+	void benchmark(Rsyn::PhysicalDesign phDesign, 
+		const std::vector<double> &binSizes, const int numThreads);
+	
+	// Moves, creates and remaps random cells and compares the incremental 
+	// ABU against a full update after each step. Returns the number of 
+	// mismatches. Note that the design is modified.
+	int checkIncremental(const int numSteps, const unsigned seed);
 }; // end class
 
 } // end namespace 
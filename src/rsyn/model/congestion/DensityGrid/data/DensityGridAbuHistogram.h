@@ -0,0 +1,214 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef GRIDAREAABUHISTOGRAM_H
+#define GRIDAREAABUHISTOGRAM_H
+
+namespace Rsyn {
+
+// Histogram of the bin utilization ratios used to compute ABU incrementally.
+// Ratios are stored in fixed point and indexed by a three-level radix tree 
+// (bucket, group and leaf) that keeps the number of bins and the sum of their
+// ratios at each level. All bins of a leaf have exactly the same ratio, so the
+// sum of the k largest ratios is computed by visiting the levels from the top
+// without selecting among bins. Sums are exact integers and do not drift
+// however many times the ratios are updated. Leaves are only allocated when
+// a bin falls in them. Ratios that do not fit in the tree (16 or more) are 
+// kept in a list and selected explicitly, which is rare.
+
+class DensityGridAbuHistogram {
+	friend class DensityGrid;
+protected:
+	static const int FRACTION_BITS = 20; // resolution of about 1e-6
+	static const int LEAF_BITS = 6;
+	static const int GROUP_BITS = 6;
+	static const int BUCKET_BITS = 12;
+	static const int KEY_BITS = BUCKET_BITS + GROUP_BITS + LEAF_BITS; // ratios < 16
+	static const int NUM_BUCKETS = 1 << BUCKET_BITS;
+	static const int NUM_GROUPS = 1 << GROUP_BITS;
+	static const int NUM_LEAVES = 1 << LEAF_BITS;
+	static const std::int64_t NUM_KEYS = std::int64_t(1) << KEY_BITS;
+	static constexpr double ONE = double(std::int64_t(1) << FRACTION_BITS);
+
+	struct Bucket {
+		int count = 0;
+		std::int64_t sum = 0;
+		std::vector<int> groupCounts;
+		std::vector<std::int64_t> groupSums;
+		std::vector<std::vector<int>> leafCounts;
+	}; // end struct
+
+	std::vector<Bucket> clsBuckets;
+
+	// Bins whose ratio does not fit in the tree.
+	std::vector<int> clsOverflowBins;
+	std::int64_t clsOverflowSum = 0;
+
+	std::vector<std::int64_t> clsBinRatios;
+	std::vector<int> clsBinSlots; // position in clsOverflowBins
+
+	int clsNumSkippedBins = 0;
+
+	static std::int64_t toFixedPoint(const double ratio) {
+		return ratio > 0 ? std::llround(ratio * ONE) : 0;
+	} // end method
+
+	// Adds (count = 1) or removes (count = -1) a ratio from the tree.
+	void updateKey(const std::int64_t ratio, const int count) {
+		Bucket &bucket = clsBuckets[ratio >> (GROUP_BITS + LEAF_BITS)];
+		const int group = (ratio >> LEAF_BITS) & (NUM_GROUPS - 1);
+		const int leaf = ratio & (NUM_LEAVES - 1);
+		if (bucket.groupCounts.empty()) {
+			bucket.groupCounts.assign(NUM_GROUPS, 0);
+			bucket.groupSums.assign(NUM_GROUPS, 0);
+			bucket.leafCounts.resize(NUM_GROUPS);
+		} // end if
+		std::vector<int> &leaves = bucket.leafCounts[group];
+		if (leaves.empty())
+			leaves.assign(NUM_LEAVES, 0);
+
+		bucket.count += count;
+		bucket.sum += count * ratio;
+		bucket.groupCounts[group] += count;
+		bucket.groupSums[group] += count * ratio;
+		leaves[leaf] += count;
+	} // end method
+
+	void addRatio(const int bin, const std::int64_t ratio) {
+		if (ratio < NUM_KEYS) {
+			updateKey(ratio, +1);
+		} else {
+			clsBinSlots[bin] = (int) clsOverflowBins.size();
+			clsOverflowBins.push_back(bin);
+			clsOverflowSum += ratio;
+		} // end if-else
+	} // end method
+
+	void removeRatio(const int bin, const std::int64_t ratio) {
+		if (ratio < NUM_KEYS) {
+			updateKey(ratio, -1);
+		} else {
+			// Swap-remove from the overflow list.
+			const int slot = clsBinSlots[bin];
+			const int last = clsOverflowBins.back();
+			clsOverflowBins[slot] = last;
+			clsBinSlots[last] = slot;
+			clsOverflowBins.pop_back();
+			clsOverflowSum -= ratio;
+		} // end if-else
+	} // end method
+
+	void init(const int numBins) {
+		clsBuckets.assign(NUM_BUCKETS, Bucket());
+		clsOverflowBins.clear();
+		clsOverflowSum = 0;
+		clsBinRatios.assign(numBins, 0);
+		clsBinSlots.assign(numBins, -1);
+		clsNumSkippedBins = 0;
+
+		updateKey(0, numBins);
+	} // end method
+
+	void setRatio(const int bin, const double value) {
+		const std::int64_t ratio = toFixedPoint(value);
+		if (ratio == clsBinRatios[bin])
+			return;
+		removeRatio(bin, clsBinRatios[bin]);
+		addRatio(bin, ratio);
+		clsBinRatios[bin] = ratio;
+	} // end method
+
+	// Returns the sum of the k largest ratios.
+	double sumOfLargest(int k) const {
+		std::int64_t sum = 0;
+
+		const int numOverflowBins = (int) clsOverflowBins.size();
+		if (numOverflowBins <= k) {
+			sum += clsOverflowSum;
+			k -= numOverflowBins;
+		} else {
+			std::vector<std::int64_t> ratios(numOverflowBins);
+			for (int i = 0; i < numOverflowBins; i++)
+				ratios[i] = clsBinRatios[clsOverflowBins[i]];
+			std::nth_element(ratios.begin(), ratios.begin() + k, ratios.end(),
+					std::greater<std::int64_t>());
+			for (int i = 0; i < k; i++)
+				sum += ratios[i];
+			k = 0;
+		} // end if-else
+
+		for (int b = NUM_BUCKETS - 1; b >= 0 && k > 0; b--) {
+			const Bucket &bucket = clsBuckets[b];
+			if (bucket.count <= k) {
+				sum += bucket.sum;
+				k -= bucket.count;
+				continue;
+			} // end if
+			for (int g = NUM_GROUPS - 1; g >= 0 && k > 0; g--) {
+				if (bucket.groupCounts[g] <= k) {
+					sum += bucket.groupSums[g];
+					k -= bucket.groupCounts[g];
+					continue;
+				} // end if
+				const std::vector<int> &leaves = bucket.leafCounts[g];
+				for (int l = NUM_LEAVES - 1; l >= 0 && k > 0; l--) {
+					const int count = std::min(k, leaves[l]);
+					const std::int64_t ratio = 
+							(std::int64_t(b) << (GROUP_BITS + LEAF_BITS)) | (g << LEAF_BITS) | l;
+					sum += count * ratio;
+					k -= count;
+				} // end for
+			} // end for
+		} // end for
+		return sum / ONE;
+	} // end method
+
+	// Returns the largest ratio.
+	double getMax() const {
+		if (!clsOverflowBins.empty()) {
+			std::int64_t max = 0;
+			for (const int bin : clsOverflowBins)
+				max = std::max(max, clsBinRatios[bin]);
+			return max / ONE;
+		} // end if
+		for (int b = NUM_BUCKETS - 1; b >= 0; b--) {
+			const Bucket &bucket = clsBuckets[b];
+			if (!bucket.count)
+				continue;
+			for (int g = NUM_GROUPS - 1; g >= 0; g--) {
+				if (!bucket.groupCounts[g])
+					continue;
+				const std::vector<int> &leaves = bucket.leafCounts[g];
+				for (int l = NUM_LEAVES - 1; l >= 0; l--) {
+					if (leaves[l])
+						return ((std::int64_t(b) << (GROUP_BITS + LEAF_BITS)) | 
+								(g << LEAF_BITS) | l) / ONE;
+				} // end for
+			} // end for
+		} // end for
+		return 0;
+	} // end method
+
+public:
+
+	DensityGridAbuHistogram() {}
+
+	int getNumSkippedBins() const { return clsNumSkippedBins; }
+	double getRatio(const int bin) const { return clsBinRatios[bin] / ONE; }
+}; // end class
+
+} // end namespace
+
+#endif /* GRIDAREAABUHISTOGRAM_H */
@@ -31,6 +31,7 @@
 
 #include "DensityGridBin.h"
 #include "DensityGridBlockage.h"
+#include "DensityGridAbuHistogram.h"
 
 
 
@@ -58,6 +59,15 @@ protected:
 
 	bool clsHasRowBounds : 1;
 	bool clsHasBlockages : 1;
+	bool clsIncrementalMode : 1;
+	
+	// Utilization ratio of the bins. Only maintained in incremental mode.
+	DensityGridAbuHistogram clsAbuHistogram;
+	
+	// Threads used to build the grid. The thread pool is only created when 
+	// more than one thread is requested.
+	int clsNumThreads;
+	std::unique_ptr<ThreadPool> clsThreadPool;
 	
 	double clsTargetDensity;
 	double clsAbu;
@@ -71,6 +81,9 @@ protected:
 	const double clsAbu5Weight = 4.0;
 	const double clsAbu10Weight = 2.0;
 	const double clsAbu20Weight = 1.0;
+	
+	/* parallel construction parameters */
+	const int clsParallelMinItems = 4096; // minimum number of rectangles to split the work among threads
 	//const int clsNumBinsX = 500;
 	//const int clsNumBinsY = 500;
 
@@ -87,6 +100,8 @@ public:
 		clsAbu = 0.0;
 		clsHasRowBounds = false;
 		clsHasBlockages = false;
+		clsIncrementalMode = false;
+		clsNumThreads = 1;
 	} // end constructor 
 }; // end class 
 
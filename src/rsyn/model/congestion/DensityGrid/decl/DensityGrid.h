@@ -46,7 +46,8 @@ public:
 
 	// initialize abu
 	void init(Rsyn::PhysicalDesign phDesign, Rsyn::Module module, double targetUtilization, 
-		double unit = 9.0, bool showDetails = false, const bool keepRowBounds = false);
+		double unit = 9.0, bool showDetails = false, const bool keepRowBounds = false, 
+		const int numThreads = 1);
 	void updateBinLength(const DBU binLength, bool showDetails = false, const bool keepRowBounds = false);
 	void updateArea(const AreaType type);
 	void clearAreaOfBins(const AreaType type);
@@ -100,6 +101,14 @@ public:
 	void initBlockages();
 	void clearBlockageOfBins();
 	
+	bool hasRowBounds() const;
+	bool hasBlockages() const;
+	
+	/* Number of threads used to build the grid (i.e. bin bounds, areas and 
+	 * blockages). The result does not depend on the number of threads. */
+	void setNumThreads(const int numThreads);
+	int getNumThreads() const;
+	
 	void splitGridBins(const double minBinSize = 0.0);
 	
 	const Bounds & getBinBound(const int row, const int col);
@@ -113,11 +122,55 @@ public:
 	// update area usage of the bins and the abu violation
 	void updateAbu(bool showDetails = false);
 	
+	/* In incremental mode the movable area of the bins and the histogram of 
+	 * bin utilization are updated cell by cell as cells are created, moved 
+	 * and remapped (see addCellArea(), removeCellArea() and remapCellArea()).
+	 * Then, updateAbu() neither rescans the cells nor sorts the bins. Any 
+	 * other change (e.g. fixing a cell) requires updateArea(MOVABLE_AREA). */
+	void enableIncrementalMode();
+	void disableIncrementalMode();
+	bool isIncrementalModeEnabled() const;
+	
+	/* Adds/removes the area of a movable cell at its current position to/from
+	 * the bins. Should be called after/before the cell moves. */
+	void addCellArea(Rsyn::Instance instance);
+	void removeCellArea(Rsyn::Instance instance);
+	
+	/* Replaces the area of a movable cell with the size of oldLibraryCell by 
+	 * its current area. Should be called after the cell is remapped. */
+	void remapCellArea(Rsyn::Cell cell, Rsyn::LibraryCell oldLibraryCell);
+	
 protected:
 	// Adding out of row bound region to fixed area of the bin
 	void updatePlaceableArea(const bool storeRowBounds = false);
 	void addArea(const AreaType type, const Bounds & bound);
 	void addBlockageBound(const Bounds & bound, Rsyn::Instance inst);
+	// Only bins in the rows [minRow, maxRow] are updated.
+	void addBlockageBound(const Bounds & bound, Rsyn::Instance inst, 
+		const int minRow, const int maxRow);
+	
+	/* Adds to the bins the area of the rectangles returned by getBounds for
+	 * each item in [0, numItems). With several threads, the rectangles are 
+	 * gathered in parallel into per-band lists and then each thread adds the
+	 * rectangles of its own band of bin rows, so no bin is written by two 
+	 * threads. */
+	void addAreas(const AreaType type, const int numItems, 
+		const std::function<void(const int item, std::vector<Bounds> & bounds)> & getBounds);
+	
+	/* Adds the area of a rectangle to the bins in the rows [minRow, maxRow]. */
+	void accumulateArea(const AreaType type, const Bounds & bound, 
+		const int minRow, const int maxRow);
+	
+	/* Splits [0, numItems) in contiguous ranges and calls task for each range, 
+	 * in parallel if a thread pool is available. */
+	void runInParallel(const int numItems, 
+		const std::function<void(const int begin, const int end)> & task);
+	
+	// Returns false if the bin is skipped by ABU computation. The ratio of 
+	// skipped and small bins is zero.
+	bool computeAbuRatio(const int index, double & ratio) const;
+	void initAbuHistogram();
+	void updateCellArea(const Bounds & bound, const bool add);
 }; // end class 
 
 } // end namespace 
@@ -30,7 +30,7 @@ inline bool DensityGrid::isInitialized() const {
 // -----------------------------------------------------------------------------
 
 inline void DensityGrid::init(Rsyn::PhysicalDesign phDesign, Rsyn::Module module, double targetUtilization,
-	double unit, bool showDetails, const bool keepRowBounds) {
+	double unit, bool showDetails, const bool keepRowBounds, const int numThreads) {
 	if (data) {
 		std::cout << "WARNING:  ABU was already initialized\n";
 		return;
@@ -41,6 +41,7 @@ inline void DensityGrid::init(Rsyn::PhysicalDesign phDesign, Rsyn::Module module
 	data->clsModule = module;
 	data->clsTargetDensity = targetUtilization;
 	data->clsPhModule = phDesign.getPhysicalModule(module);
+	setNumThreads(numThreads);
 
 	const DBU length = static_cast<DBU> (unit * data->clsPhDesign.getRowHeight());
 
@@ -58,6 +59,7 @@ inline void DensityGrid::updateBinLength(const DBU binLength, bool showDetails,
 	data->clsBins.clear();
 	data->clsBins.resize(getNumBins());
 	data->clsBins.shrink_to_fit();
+	data->clsHasBlockages = false;
 
 	if (showDetails) {
 		std::cout << "\tDie Bounds      : " << dieBounds << "\n";
@@ -68,19 +70,23 @@ inline void DensityGrid::updateBinLength(const DBU binLength, bool showDetails,
 	/* 0. initialize density map */
 	DBUxy lower = data->clsPhModule.getCoordinate(LOWER);
 	DBUxy upper = data->clsPhModule.getCoordinate(UPPER);
-	for (int j = 0; j < getNumRows(); j++) {
-		for (int k = 0; k < getNumCols(); k++) {
-			unsigned binId = getIndex(j, k);
-			DensityGridBin & bin = data->clsBins[binId];
-			bin.clsBounds[LOWER][X] = lower[X] + k*binLength;
-			bin.clsBounds[LOWER][Y] = lower[Y] + j*binLength;
-			bin.clsBounds[UPPER][X] = std::min(bin.clsBounds[LOWER][X] + binLength, upper[X]);
-			bin.clsBounds[UPPER][Y] = std::min(bin.clsBounds[LOWER][Y] + binLength, upper[Y]);
+	runInParallel(getNumRows(), [&](const int begin, const int end) {
+		for (int j = begin; j < end; j++) {
+			for (int k = 0; k < getNumCols(); k++) {
+				unsigned binId = getIndex(j, k);
+				DensityGridBin & bin = data->clsBins[binId];
+				bin.clsBounds[LOWER][X] = lower[X] + k*binLength;
+				bin.clsBounds[LOWER][Y] = lower[Y] + j*binLength;
+				bin.clsBounds[UPPER][X] = std::min(bin.clsBounds[LOWER][X] + binLength, upper[X]);
+				bin.clsBounds[UPPER][Y] = std::min(bin.clsBounds[LOWER][Y] + binLength, upper[Y]);
+			} // end for 
 		} // end for 
-	} // end for 
+	});
 
 	updatePlaceableArea(keepRowBounds);
 	updateArea(FIXED_AREA);
+	if (isIncrementalModeEnabled())
+		updateArea(MOVABLE_AREA);
 
 } // end method 
 
@@ -99,27 +105,39 @@ inline void DensityGrid::updatePlaceableArea(const bool storeRowBounds) {
 	} // end if
 
 	const Bounds & dieBounds = data->clsPhModule.getBounds();
+	std::vector<Bounds> rowOverlaps;
+	rowOverlaps.reserve(data->clsPhDesign.getNumRows());
 	for (const Rsyn::PhysicalRow phRow : data->clsPhDesign.allPhysicalRows()) {
-		Bounds rowOverlap = dieBounds.overlapRectangle(phRow.getBounds());
-		int lcol, rcol, brow, trow;
-		getIndex(rowOverlap[LOWER], brow, lcol);
-		getIndex(rowOverlap[UPPER], trow, rcol);
-		lcol = std::max(lcol, 0);
-		rcol = std::min(rcol, getNumCols() - 1);
-		brow = std::max(brow, 0);
-		trow = std::min(trow, getNumRows() - 1);
-		for (int j = brow; j <= trow; j++) {
-			for (int k = lcol; k <= rcol; k++) {
-				unsigned binId = getIndex(j, k);
-				DensityGridBin & bin = data->clsBins[binId];
-				const Bounds & binBound = bin.clsBounds;
-				Bounds binOverlap = rowOverlap.overlapRectangle(binBound);
-				bin.addArea(PLACEABLE_AREA, binOverlap.computeArea());
-				if (storeRowBounds)
-					bin.clsRows.push_back(binOverlap);
-			} // end for 
-		} // end for 
+		rowOverlaps.push_back(dieBounds.overlapRectangle(phRow.getBounds()));
 	} // end for
+
+	addAreas(PLACEABLE_AREA, rowOverlaps.size(), [&](const int i, std::vector<Bounds> & bounds) {
+		bounds.push_back(rowOverlaps[i]);
+	});
+
+	if (!storeRowBounds)
+		return;
+
+	// Each task owns a range of bin rows, so the row bounds are stored in the
+	// same order regardless of the number of threads.
+	runInParallel(getNumRows(), [&](const int begin, const int end) {
+		for (const Bounds & rowOverlap : rowOverlaps) {
+			int lcol, rcol, brow, trow;
+			getIndex(rowOverlap[LOWER], brow, lcol);
+			getIndex(rowOverlap[UPPER], trow, rcol);
+			lcol = std::max(lcol, 0);
+			rcol = std::min(rcol, getNumCols() - 1);
+			brow = std::max(brow, begin);
+			trow = std::min(trow, end - 1);
+			for (int j = brow; j <= trow; j++) {
+				for (int k = lcol; k <= rcol; k++) {
+					unsigned binId = getIndex(j, k);
+					DensityGridBin & bin = data->clsBins[binId];
+					bin.clsRows.push_back(rowOverlap.overlapRectangle(bin.clsBounds));
+				} // end for 
+			} // end for 
+		} // end for
+	});
 } // end method 
 
 // -----------------------------------------------------------------------------
@@ -127,6 +145,7 @@ inline void DensityGrid::updatePlaceableArea(const bool storeRowBounds) {
 inline void DensityGrid::updateArea(const AreaType type) {
 	clearAreaOfBins(type);
 
+	std::vector<Rsyn::Cell> cells;
 	for (Rsyn::Instance instance : data->clsModule.allInstances()) {
 		if (instance.getType() != Rsyn::CELL) {
 			continue;
@@ -138,7 +157,11 @@ inline void DensityGrid::updateArea(const AreaType type) {
 		if (instance.isFixed() && type != FIXED_AREA)
 			continue;
 
-		Rsyn::Cell cell = instance.asCell();
+		cells.push_back(instance.asCell());
+	} // end for
+
+	addAreas(type, cells.size(), [&](const int i, std::vector<Bounds> & bounds) {
+		Rsyn::Cell cell = cells[i];
 		const Rsyn::PhysicalCell phCell = data->clsPhDesign.getPhysicalCell(cell);
 
 		if (type == FIXED_AREA && phCell.hasLayerBounds()) {
@@ -146,13 +169,15 @@ inline void DensityGrid::updateArea(const AreaType type) {
 			for (const Bounds & rect : phLibCel.allLayerObstacles()) {
 				Bounds bound = rect;
 				bound.translate(phCell.getPosition());
-				addArea(type, bound);
+				bounds.push_back(bound);
 			} // end for 
 		} else {
-			const Bounds &bounds = phCell.getBounds();
-			addArea(type, bounds);
-		}
-	} // end for
+			bounds.push_back(phCell.getBounds());
+		} // end if-else
+	});
+	
+	if (isIncrementalModeEnabled())
+		initAbuHistogram();
 } // end method 
 
 // -----------------------------------------------------------------------------
@@ -254,7 +279,7 @@ inline DBU DensityGrid::getAvailableArea(const int row, const int col, const Are
 inline void DensityGrid::removeArea(const int row, const int col, const AreaType type, const DBU area) {
 	const int index = getIndex(row, col);
 	DensityGridBin & bin = data->clsBins[index];
-	bin.addArea(type, area);
+	bin.removeArea(type, area);
 } // end method 
 
 // -----------------------------------------------------------------------------
@@ -263,7 +288,7 @@ inline void DensityGrid::removeArea(const int row, const int col, const AreaType
 	const int index = getIndex(row, col);
 	DensityGridBin & bin = data->clsBins[index];
 	const Bounds & overlap = rect.overlapRectangle(bin.getBounds());
-	bin.addArea(type, overlap.computeArea());
+	bin.removeArea(type, overlap.computeArea());
 } // end method 
 
 // -----------------------------------------------------------------------------
@@ -415,6 +440,7 @@ inline void DensityGrid::updateMaxPins() {
 
 inline void DensityGrid::initBlockages() {
 	// TODO -> reserve space in vectors. 
+	std::vector<std::pair<Bounds, Rsyn::Instance>> blockages;
 	for (Rsyn::Instance inst : data->clsModule.allInstances()) {
 		if (inst.getType() == Rsyn::CELL) {
 			Rsyn::PhysicalCell phCell = data->clsPhDesign.getPhysicalCell(inst.asCell());
@@ -425,11 +451,11 @@ inline void DensityGrid::initBlockages() {
 				for (const Bounds & rect : phLibCell.allLayerObstacles()) {
 					Bounds bounds = rect;
 					bounds.translate(phCell.getPosition());
-					addBlockageBound(bounds, inst);
+					blockages.push_back(std::make_pair(bounds, inst));
 				} // end for 
 			} else {
 				const Bounds & bounds = phCell.getBounds();
-				addBlockageBound(bounds, inst);
+				blockages.push_back(std::make_pair(bounds, inst));
 			} // end if-else 
 		} else {
 			Rsyn::PhysicalInstance phInstance = data->clsPhDesign.getPhysicalInstance(inst);
@@ -438,9 +464,18 @@ inline void DensityGrid::initBlockages() {
 			const Bounds &overlap = bounds.overlapRectangle(phModule.getBounds());
 			if (overlap.computeArea() <= 0)
 				continue;
-			addBlockageBound(overlap, inst);
+			blockages.push_back(std::make_pair(overlap, inst));
 		} // end if-else 
 	} // end for 
+
+	// Each task owns a range of bin rows, so the blockages are stored in the
+	// same order regardless of the number of threads.
+	runInParallel(getNumRows(), [&](const int begin, const int end) {
+		for (const std::pair<Bounds, Rsyn::Instance> & blockage : blockages) {
+			addBlockageBound(blockage.first, blockage.second, begin, end - 1);
+		} // end for 
+	});
+	data->clsHasBlockages = true;
 } // end method 
 
 // -----------------------------------------------------------------------------
@@ -449,7 +484,40 @@ inline void DensityGrid::clearBlockageOfBins() {
 	for (int i = 0; i < getNumBins(); i++) {
 		DensityGridBin & bin = data->clsBins[i];
 		bin.clsBlockages.clear();
+		bin.clsMapBlockages.clear();
 	} // end method 
+	data->clsHasBlockages = false;
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline bool DensityGrid::hasRowBounds() const {
+	return data->clsHasRowBounds;
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline bool DensityGrid::hasBlockages() const {
+	return data->clsHasBlockages;
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline void DensityGrid::setNumThreads(const int numThreads) {
+	data->clsNumThreads = std::max(1, numThreads);
+	if (data->clsNumThreads > 1) {
+		if (!data->clsThreadPool || (int) data->clsThreadPool->getNumThreads() != data->clsNumThreads) {
+			data->clsThreadPool.reset(new ThreadPool(data->clsNumThreads));
+		} // end if
+	} else {
+		data->clsThreadPool.reset();
+	} // end else
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline int DensityGrid::getNumThreads() const {
+	return data->clsNumThreads;
 } // end method 
 
 // -----------------------------------------------------------------------------
@@ -560,59 +628,62 @@ inline const std::vector<DensityGridBlockage> & DensityGrid::allDensityGridBlock
 // -----------------------------------------------------------------------------
 
 inline void DensityGrid::updateAbu(bool showDetails) {
-	updateArea(MOVABLE_AREA);
-
+	double abu1 = 0.0, abu2 = 0.0, abu5 = 0.0, abu10 = 0.0, abu20 = 0.0;
+	
+	if (isIncrementalModeEnabled()) {
+		/* bin areas and ratios are already up to date */
+		const DensityGridAbuHistogram & histogram = data->clsAbuHistogram;
+		const int numBins = getNumBins() - histogram.getNumSkippedBins();
+		const double maxRatio = histogram.getMax();
+		auto average = [&](const double fraction) {
+			const int clip_index = static_cast<int> (fraction * numBins);
+			return clip_index ? histogram.sumOfLargest(clip_index) / clip_index : maxRatio;
+		}; // end lambda
+		abu2 = average(0.02);
+		abu5 = average(0.05);
+		abu10 = average(0.10);
+		abu20 = average(0.20);
+	} else {
+		updateArea(MOVABLE_AREA);
+
+		int skipped_bin_cnt = 0;
+		std::vector<double> ratioUsage;
+		ratioUsage.resize(getNumBins(), 0.0);
+		/* 2. determine the free space & utilization per bin */
+		for (int binId = 0; binId < getNumBins(); binId++) {
+			if (!computeAbuRatio(binId, ratioUsage[binId]))
+				skipped_bin_cnt++;
+		} // end for  
+
+		std::sort(ratioUsage.begin(), ratioUsage.end());
+
+		/* 3. obtain ABU numbers */
+		const int numBins = getNumBins();
+		int clip_index = static_cast<int> (0.02 * (numBins - skipped_bin_cnt));
+		for (int j = numBins - 1; j > numBins - 1 - clip_index; j--) {
+			abu2 += ratioUsage[j];
+		}
+		abu2 = (clip_index) ? abu2 / clip_index : ratioUsage[numBins - 1];
 
-	int skipped_bin_cnt = 0;
-	std::vector<double> ratioUsage;
-	ratioUsage.resize(getNumBins(), 0.0);
-	double areaThreshold = getBinSize() * getBinSize() * data->clsBinAreaThreshold;
-	/* 2. determine the free space & utilization per bin */
-	for (int j = 0; j < getNumRows(); j++) {
-		for (int k = 0; k < getNumCols(); k++) {
-			const DensityGridBin & bin = getDensityGridBin(j, k);
-			double binArea = bin.clsBounds.computeArea();
-			if (binArea > areaThreshold) {
-				double freeArea = bin.getArea(PLACEABLE_AREA) - bin.getArea(FIXED_AREA);
-				if (freeArea > data->clsFreeSpaceThreshold * binArea) {
-					int binId = getIndex(j, k);
-					ratioUsage[binId] = bin.getArea(MOVABLE_AREA) / freeArea;
-				} else {
-					skipped_bin_cnt++;
-				}
-			} // end if 
-		} // end for 
-	} // end for  
+		clip_index = static_cast<int> (0.05 * (numBins - skipped_bin_cnt));
+		for (int j = numBins - 1; j > numBins - 1 - clip_index; j--) {
+			abu5 += ratioUsage[j];
+		}
+		abu5 = (clip_index) ? abu5 / clip_index : ratioUsage[numBins - 1];
 
-	std::sort(ratioUsage.begin(), ratioUsage.end());
+		clip_index = static_cast<int> (0.10 * (numBins - skipped_bin_cnt));
+		for (int j = numBins - 1; j > numBins - 1 - clip_index; j--) {
+			abu10 += ratioUsage[j];
+		}
+		abu10 = (clip_index) ? abu10 / clip_index : ratioUsage[numBins - 1];
 
-	/* 3. obtain ABU numbers */
-	double abu1 = 0.0, abu2 = 0.0, abu5 = 0.0, abu10 = 0.0, abu20 = 0.0;
-	const int numBins = getNumBins();
-	int clip_index = static_cast<int> (0.02 * (numBins - skipped_bin_cnt));
-	for (int j = numBins - 1; j > numBins - 1 - clip_index; j--) {
-		abu2 += ratioUsage[j];
-	}
-	abu2 = (clip_index) ? abu2 / clip_index : ratioUsage[numBins - 1];
-
-	clip_index = static_cast<int> (0.05 * (numBins - skipped_bin_cnt));
-	for (int j = numBins - 1; j > numBins - 1 - clip_index; j--) {
-		abu5 += ratioUsage[j];
-	}
-	abu5 = (clip_index) ? abu5 / clip_index : ratioUsage[numBins - 1];
-
-	clip_index = static_cast<int> (0.10 * (numBins - skipped_bin_cnt));
-	for (int j = numBins - 1; j > numBins - 1 - clip_index; j--) {
-		abu10 += ratioUsage[j];
-	}
-	abu10 = (clip_index) ? abu10 / clip_index : ratioUsage[numBins - 1];
-
-	clip_index = static_cast<int> (0.20 * (numBins - skipped_bin_cnt));
-	for (int j = numBins - 1; j > numBins - 1 - clip_index; j--) {
-		abu20 += ratioUsage[j];
-	}
-	abu20 = (clip_index) ? abu20 / clip_index : ratioUsage[numBins - 1];
-	//	ratioUsage.clear();
+		clip_index = static_cast<int> (0.20 * (numBins - skipped_bin_cnt));
+		for (int j = numBins - 1; j > numBins - 1 - clip_index; j--) {
+			abu20 += ratioUsage[j];
+		}
+		abu20 = (clip_index) ? abu20 / clip_index : ratioUsage[numBins - 1];
+		//	ratioUsage.clear();
+	} // end if-else
 
 	if (showDetails) {
 		std::cout << "\ttarget util     : " << getTargetDensity() << "\n";
@@ -636,6 +707,117 @@ inline void DensityGrid::updateAbu(bool showDetails) {
 
 // -----------------------------------------------------------------------------
 
+inline bool DensityGrid::computeAbuRatio(const int index, double & ratio) const {
+	const DensityGridBin & bin = data->clsBins[index];
+	const double areaThreshold = getBinSize() * getBinSize() * data->clsBinAreaThreshold;
+	const double binArea = bin.clsBounds.computeArea();
+	ratio = 0.0;
+	if (binArea > areaThreshold) {
+		const double freeArea = bin.getArea(PLACEABLE_AREA) - bin.getArea(FIXED_AREA);
+		if (freeArea > data->clsFreeSpaceThreshold * binArea) {
+			ratio = bin.getArea(MOVABLE_AREA) / freeArea;
+		} else {
+			return false;
+		} // end if-else 
+	} // end if 
+	return true;
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline void DensityGrid::enableIncrementalMode() {
+	data->clsIncrementalMode = true;
+	updateArea(MOVABLE_AREA);
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline void DensityGrid::disableIncrementalMode() {
+	data->clsIncrementalMode = false;
+	data->clsAbuHistogram = DensityGridAbuHistogram();
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline bool DensityGrid::isIncrementalModeEnabled() const {
+	return data->clsIncrementalMode;
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline void DensityGrid::initAbuHistogram() {
+	DensityGridAbuHistogram & histogram = data->clsAbuHistogram;
+	histogram.init(getNumBins());
+	for (int i = 0; i < getNumBins(); i++) {
+		double ratio;
+		if (!computeAbuRatio(i, ratio))
+			histogram.clsNumSkippedBins++;
+		histogram.setRatio(i, ratio);
+	} // end for 
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline void DensityGrid::addCellArea(Rsyn::Instance instance) {
+	if (instance.getType() != Rsyn::CELL || !instance.isMovable())
+		return;
+	const Rsyn::PhysicalCell phCell = data->clsPhDesign.getPhysicalCell(instance.asCell());
+	updateCellArea(phCell.getBounds(), true);
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline void DensityGrid::removeCellArea(Rsyn::Instance instance) {
+	if (instance.getType() != Rsyn::CELL || !instance.isMovable())
+		return;
+	const Rsyn::PhysicalCell phCell = data->clsPhDesign.getPhysicalCell(instance.asCell());
+	updateCellArea(phCell.getBounds(), false);
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline void DensityGrid::remapCellArea(Rsyn::Cell cell, Rsyn::LibraryCell oldLibraryCell) {
+	if (!cell.isMovable())
+		return;
+	const Rsyn::PhysicalCell phCell = data->clsPhDesign.getPhysicalCell(cell);
+	const Rsyn::PhysicalLibraryCell phOldLibCell = 
+		data->clsPhDesign.getPhysicalLibraryCell(oldLibraryCell);
+	const DBUxy pos = phCell.getPosition();
+	updateCellArea(Bounds(pos, pos + phOldLibCell.getSize()), false);
+	updateCellArea(phCell.getBounds(), true);
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline void DensityGrid::updateCellArea(const Bounds & bound, const bool add) {
+	int lcol, rcol, brow, trow;
+	getIndex(bound[LOWER], brow, lcol);
+	getIndex(bound[UPPER], trow, rcol);
+
+	lcol = std::max(lcol, 0);
+	rcol = std::min(rcol, getNumCols() - 1);
+	brow = std::max(brow, 0);
+	trow = std::min(trow, getNumRows() - 1);
+	for (int j = brow; j <= trow; j++) {
+		for (int k = lcol; k <= rcol; k++) {
+			if (add) {
+				addArea(j, k, MOVABLE_AREA, bound);
+			} else {
+				removeArea(j, k, MOVABLE_AREA, bound);
+			} // end if-else 
+			
+			if (isIncrementalModeEnabled()) {
+				const int index = getIndex(j, k);
+				double ratio;
+				computeAbuRatio(index, ratio);
+				data->clsAbuHistogram.setRatio(index, ratio);
+			} // end if 
+		} // end for 
+	} // end for 
+} // end method 
+
+// -----------------------------------------------------------------------------
+
 inline void DensityGrid::addArea(const AreaType type, const Bounds & bound) {
 	int lcol, rcol, brow, trow;
 	getIndex(bound[LOWER], brow, lcol);
@@ -655,9 +837,20 @@ inline void DensityGrid::addArea(const AreaType type, const Bounds & bound) {
 // -----------------------------------------------------------------------------
 
 inline void DensityGrid::addBlockageBound(const Bounds & bound, Rsyn::Instance inst) {
+	addBlockageBound(bound, inst, 0, getNumRows() - 1);
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline void DensityGrid::addBlockageBound(const Bounds & bound, Rsyn::Instance inst, 
+	const int minRow, const int maxRow) {
 	int brow, lcol, trow, rcol;
 	getIndex(bound[LOWER], brow, lcol);
 	getIndex(bound[UPPER], trow, rcol);
+	lcol = std::max(lcol, 0);
+	rcol = std::min(rcol, getNumCols() - 1);
+	brow = std::max(brow, minRow);
+	trow = std::min(trow, maxRow);
 	for (int i = brow; i <= trow; i++) {
 		for (int j = lcol; j <= rcol; j++) {
 			const int index = getIndex(i, j);
@@ -679,4 +872,135 @@ inline void DensityGrid::addBlockageBound(const Bounds & bound, Rsyn::Instance i
 
 // -----------------------------------------------------------------------------
 
+inline void DensityGrid::addAreas(const AreaType type, const int numItems,
+	const std::function<void(const int item, std::vector<Bounds> & bounds)> & getBounds) {
+	if (!data->clsThreadPool || numItems < data->clsParallelMinItems) {
+		std::vector<Bounds> bounds;
+		for (int i = 0; i < numItems; i++) {
+			bounds.clear();
+			getBounds(i, bounds);
+			for (const Bounds & bound : bounds) {
+				accumulateArea(type, bound, 0, getNumRows() - 1);
+			} // end for 
+		} // end for 
+		return;
+	} // end if 
+
+	// Rows are split in bands, one per thread. While gathering the rectangles,
+	// each chunk of items keeps a list per band with the rectangles that 
+	// overlap that band, so each band only visits its own rectangles.
+	const int numRows = getNumRows();
+	const int numBands = std::min(numRows, data->clsNumThreads);
+	const int numRowsPerBand = (numRows + numBands - 1) / numBands;
+	const int numChunks = data->clsNumThreads;
+	const int numItemsPerChunk = (numItems + numChunks - 1) / numChunks;
+	std::vector<std::vector<std::vector<Bounds>>> chunks(numChunks, 
+		std::vector<std::vector<Bounds>>(numBands));
+	runInParallel(numChunks, [&](const int begin, const int end) {
+		std::vector<Bounds> bounds;
+		for (int t = begin; t < end; t++) {
+			const int last = std::min(numItems, (t + 1) * numItemsPerChunk);
+			for (int i = t * numItemsPerChunk; i < last; i++) {
+				bounds.clear();
+				getBounds(i, bounds);
+				for (const Bounds & bound : bounds) {
+					int brow, trow, col;
+					getIndex(bound[LOWER], brow, col);
+					getIndex(bound[UPPER], trow, col);
+					brow = std::max(brow, 0);
+					trow = std::min(trow, numRows - 1);
+					if (brow > trow)
+						continue;
+					for (int band = brow / numRowsPerBand; band <= trow / numRowsPerBand; band++) {
+						chunks[t][band].push_back(bound);
+					} // end for 
+				} // end for 
+			} // end for 
+		} // end for 
+	});
+
+	// Each task owns a band of bin rows, so the bins are written without 
+	// synchronization. Chunks are visited in order, so the result does not 
+	// depend on the scheduling.
+	runInParallel(numBands, [&](const int begin, const int end) {
+		for (int band = begin; band < end; band++) {
+			const int minRow = band * numRowsPerBand;
+			const int maxRow = std::min(numRows, minRow + numRowsPerBand) - 1;
+			for (const std::vector<std::vector<Bounds>> & chunk : chunks) {
+				for (const Bounds & bound : chunk[band]) {
+					accumulateArea(type, bound, minRow, maxRow);
+				} // end for 
+			} // end for 
+		} // end for 
+	});
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline void DensityGrid::accumulateArea(const AreaType type, const Bounds & bound, 
+	const int minRow, const int maxRow) {
+	int lcol, rcol, brow, trow;
+	getIndex(bound[LOWER], brow, lcol);
+	getIndex(bound[UPPER], trow, rcol);
+
+	lcol = std::max(lcol, 0);
+	rcol = std::min(rcol, getNumCols() - 1);
+	brow = std::max(brow, minRow);
+	trow = std::min(trow, maxRow);
+	if (lcol > rcol)
+		return;
+
+	for (int j = brow; j <= trow; j++) {
+		DensityGridBin * row = &data->clsBins[getIndex(j, 0)];
+		const Bounds & lbin = row[lcol].clsBounds;
+		const DBU height = std::min(bound[UPPER][Y], lbin[UPPER][Y]) - 
+			std::max(bound[LOWER][Y], lbin[LOWER][Y]);
+		if (height <= 0)
+			continue;
+
+		// Leftmost and rightmost bins may be partially covered.
+		const DBU lwidth = std::min(bound[UPPER][X], lbin[UPPER][X]) - 
+			std::max(bound[LOWER][X], lbin[LOWER][X]);
+		if (lwidth > 0)
+			row[lcol].addArea(type, lwidth * height);
+		if (lcol == rcol)
+			continue;
+
+		const Bounds & rbin = row[rcol].clsBounds;
+		const DBU rwidth = std::min(bound[UPPER][X], rbin[UPPER][X]) - 
+			std::max(bound[LOWER][X], rbin[LOWER][X]);
+		if (rwidth > 0)
+			row[rcol].addArea(type, rwidth * height);
+
+		// Bins in between are fully covered in x. Only the last bin of a row 
+		// may be narrower than the bin size, but it is never in between.
+		const DBU area = getBinSize() * height;
+		for (int k = lcol + 1; k < rcol; k++) {
+			row[k].addArea(type, area);
+		} // end for 
+	} // end for 
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline void DensityGrid::runInParallel(const int numItems,
+	const std::function<void(const int begin, const int end)> & task) {
+	if (!data->clsThreadPool || numItems < 2) {
+		task(0, numItems);
+		return;
+	} // end if
+
+	const int numTasks = std::min(numItems, data->clsNumThreads);
+	const int numItemsPerTask = (numItems + numTasks - 1) / numTasks;
+	for (int begin = 0; begin < numItems; begin += numItemsPerTask) {
+		const int end = std::min(numItems, begin + numItemsPerTask);
+		data->clsThreadPool->addTask([&task, begin, end]() {
+			task(begin, end);
+		});
+	} // end for
+	data->clsThreadPool->wait();
+} // end method 
+
+// -----------------------------------------------------------------------------
+
 } // end namespace 
\ No newline at end of file
@@ -13,12 +13,19 @@
  * limitations under the License.
  */
 
+#include <cstdio>
+#include <memory>
 #include <random>
 
+#include <unistd.h>
+
+#include <boost/filesystem.hpp>
+
 #include "rsyn/session/Session.h"
 #include "rsyn/phy/PhysicalService.h"
 #include "rsyn/3rdparty/flute/flute.h"
 #include "rsyn/util/Stopwatch.h"
+#include "rsyn/util/Stepwatch.h"
 
 #include "DefaultRoutingEstimationModel.h"
 #include "RoutingTopology.h"
@@ -43,7 +50,93 @@ DefaultRoutingEstimationModel::start(const Json &params) {
 
 	clsPhysicalDesign = clsPhysical->getPhysicalDesign();
 
-	Flute::readLUT();
+	clsEnableTopologyCache = params.value("topologyCache", clsEnableTopologyCache);
+
+	// Load Flute look-up tables here, so that a missing or invalid table is
+	// reported when the service starts and not in the middle of a routing
+	// estimation (possibly in a worker thread).
+	const std::string fluteDir = session.getInstallationPath() + "/data/flute";
+	std::string lutFile = session.findFile(FLUTE_LUTFILE, fluteDir);
+	if (lutFile.empty()) {
+		lutFile = session.findFile(FLUTE_POWVFILE, fluteDir);
+	} // end if
+	if (!lutFile.empty()) {
+		std::string lutDir = boost::filesystem::path(lutFile).parent_path().string();
+		if (lutDir.empty())
+			lutDir = ".";
+		Flute::setLUTDirectory(lutDir.c_str());
+	} // end if
+
+	Stepwatch watchFlute("Loading Flute look-up tables");
+	if (!Flute::readLUT()) {
+		throw Exception(std::string("Unable to load Flute look-up tables. ") +
+				Flute::getLUTError());
+	} // end if
+	watchFlute.finish();
+
+	// When the tables were parsed from the text files, store them in the
+	// binary format next to the files actually read, so that later runs map
+	// them instead.
+	if (!Flute::isLUTMapped()) {
+		writeFluteLUT(std::string(Flute::getLUTSourceDirectory()) + "/" + FLUTE_LUTFILE);
+	} // end if
+
+	{ // writeFluteLUT
+		ScriptParsing::CommandDescriptor dscp;
+		dscp.setName("writeFluteLUT");
+		dscp.setDescription("Writes Flute look-up tables to a binary file, which is loaded faster than the text files.");
+
+		dscp.addPositionalParam("file",
+			ScriptParsing::PARAM_TYPE_STRING,
+			ScriptParsing::PARAM_SPEC_OPTIONAL,
+			"Output file.",
+			FLUTE_LUTFILE);
+
+		session.registerCommand(dscp, [&](const ScriptParsing::Command &command) {
+			const std::string filename = command.getParam("file");
+			if (!writeFluteLUT(filename)) {
+				std::cout << "[ERROR] Unable to write Flute look-up tables to \""
+						<< filename << "\".\n";
+			} // end if
+		});
+	} // end block
+
+	{ // checkFluteSorting
+		ScriptParsing::CommandDescriptor dscp;
+		dscp.setName("checkFluteSorting");
+		dscp.setDescription("Checks that Flute produces the same Steiner trees using the default and the legacy point sorting.");
+
+		dscp.addNamedParam("minDegree",
+			ScriptParsing::PARAM_TYPE_INTEGER,
+			ScriptParsing::PARAM_SPEC_OPTIONAL,
+			"Only nets with at least this number of pins are checked.",
+			"2");
+
+		session.registerCommand(dscp, [&](const ScriptParsing::Command &command) {
+			const int minDegree = command.getParam("minDegree");
+			checkFluteSorting(minDegree);
+		});
+	} // end block
+
+	{ // reportSteinerTopologyCache
+		ScriptParsing::CommandDescriptor dscp;
+		dscp.setName("reportSteinerTopologyCache");
+		dscp.setDescription("Reports the hits and misses of the cache of Steiner topologies of low-degree nets.");
+
+		dscp.addNamedParam("clear",
+			ScriptParsing::PARAM_TYPE_BOOLEAN,
+			ScriptParsing::PARAM_SPEC_OPTIONAL,
+			"Clears the cache and its statistics after reporting.",
+			"false");
+
+		session.registerCommand(dscp, [&](const ScriptParsing::Command &command) {
+			const bool clear = command.getParam("clear");
+			reportTopologyCache();
+			if (clear) {
+				clearTopologyCache();
+			} // end if
+		});
+	} // end block
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -55,6 +148,20 @@ DefaultRoutingEstimationModel::stop() {
 
 // -----------------------------------------------------------------------------
 
+bool
+DefaultRoutingEstimationModel::writeFluteLUT(const std::string &filename) {
+	const std::string temporaryFilename =
+			filename + ".tmp" + std::to_string(::getpid());
+	if (!Flute::writeLUT(temporaryFilename.c_str()) ||
+			std::rename(temporaryFilename.c_str(), filename.c_str()) != 0) {
+		std::remove(temporaryFilename.c_str());
+		return false;
+	} // end if
+	return true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
 void
 DefaultRoutingEstimationModel::updateRoutingEstimation(Rsyn::Net net, Rsyn::RoutingTopologyDescriptor<int> &topology, DBU &wirelength) {
 	wirelength = generateSteinerTree(net, topology);
@@ -67,7 +174,17 @@ DBU DefaultRoutingEstimationModel::generateSteinerTree(Rsyn::Net net, Rsyn::Rout
 
 	const unsigned numPins = net.getNumPins();
 
-	int * mapPinNodeIndexToFluteNodeIndex = new int[numPins];
+	if (numPins <= SteinerTopologyCache::MAX_DEGREE && numPins > 2) {
+		return generateLowDegreeSteinerTree(net, topology);
+	} // end if
+
+	int localMapping[SteinerTopologyCache::MAX_DEGREE];
+	std::unique_ptr<int[]> heapMapping;
+	if (numPins > SteinerTopologyCache::MAX_DEGREE) {
+		heapMapping.reset(new int[numPins]);
+	} // end if
+	int * mapPinNodeIndexToFluteNodeIndex =
+			heapMapping ? heapMapping.get() : localMapping;
 	int counter = 0;
 	int offset2driver = -1;
 
@@ -266,12 +383,189 @@ DBU DefaultRoutingEstimationModel::generateSteinerTree(Rsyn::Net net, Rsyn::Rout
 		counter++;
 	} // end for
 
-	delete [] mapPinNodeIndexToFluteNodeIndex;
 	return netSteinerWirelength;
 } // end method
 
 // -----------------------------------------------------------------------------
 
+DBU DefaultRoutingEstimationModel::generateLowDegreeSteinerTree(
+		Rsyn::Net net, Rsyn::RoutingTopologyDescriptor<int> &topology) {
+	// Pin positions relative to the lower-left corner of the bounding box.
+	SteinerTopologyCache::Key key;
+	DBU x[SteinerTopologyCache::MAX_DEGREE];
+	DBU y[SteinerTopologyCache::MAX_DEGREE];
+
+	int counter = 0;
+	for (Rsyn::Pin pin : net.allPins()) {
+		const DBUxy pinPos = clsPhysicalDesign.getPinPosition(pin);
+		x[counter] = pinPos[X];
+		y[counter] = pinPos[Y];
+		counter++;
+	} // end for
+
+	const DBU x0 = *std::min_element(x, x + counter);
+	const DBU y0 = *std::min_element(y, y + counter);
+
+	key.propDegree = counter;
+	for (int i = 0; i < counter; i++) {
+		key.propX[i] = x[i] - x0;
+		key.propY[i] = y[i] - y0;
+	} // end for
+
+	SteinerTopologyCache::Topology result;
+	if (!clsEnableTopologyCache || !clsTopologyCache.find(key, result)) {
+		buildLowDegreeSteinerTopology(key, result);
+		if (clsEnableTopologyCache) {
+			clsTopologyCache.insert(key, result);
+		} // end if
+	} // end if
+
+	// Build the topology in the same order as generateSteinerTree().
+	topology.clear();
+	for (int i = 0; i < result.propNumSegments; i++) {
+		topology.addSegment(result.propSegments[i][0], result.propSegments[i][1]);
+	} // end for
+
+	for (int i = 0; i < result.propNumPositions; i++) {
+		topology.setNodePosition(result.propPositionNodes[i],
+				result.propPositionX[i] + x0, result.propPositionY[i] + y0);
+	} // end for
+
+	counter = 0;
+	for (Rsyn::Pin pin : net.allPins()) {
+		topology.setAttachedPin(result.propPinNodes[counter], pin);
+		counter++;
+	} // end for
+
+	return result.propWirelength;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void DefaultRoutingEstimationModel::buildLowDegreeSteinerTopology(
+		const SteinerTopologyCache::Key &key,
+		SteinerTopologyCache::Topology &result) const {
+	const int numPins = key.propDegree;
+
+	FLUTE_DTYPE x[SteinerTopologyCache::MAX_DEGREE];
+	FLUTE_DTYPE y[SteinerTopologyCache::MAX_DEGREE];
+	for (int i = 0; i < numPins; i++) {
+		x[i] = (FLUTE_DTYPE) key.propX[i];
+		y[i] = (FLUTE_DTYPE) key.propY[i];
+	} // end for
+
+	result = SteinerTopologyCache::Topology();
+	result.propDegree = numPins;
+
+	Flute::Tree flutetree = Flute::flute(numPins, x, y, FLUTE_ACCURACY,
+			result.propPinNodes);
+
+	// Same merging of nodes at the same position as in generateSteinerTree(),
+	// but using linear searches on fixed-size arrays as there are at most
+	// MAX_NODES points.
+	int numPoints = 0;
+	FLUTE_DTYPE pointX[SteinerTopologyCache::MAX_NODES];
+	FLUTE_DTYPE pointY[SteinerTopologyCache::MAX_NODES];
+	int pointNode[SteinerTopologyCache::MAX_NODES];
+
+	auto findPoint = [&](const FLUTE_DTYPE px, const FLUTE_DTYPE py) {
+		for (int k = 0; k < numPoints; k++) {
+			if (pointX[k] == px && pointY[k] == py)
+				return k;
+		} // end for
+		return -1;
+	}; // end lambda
+
+	for (int i = 0; i < numPins; i++) {
+		int k = findPoint(x[i], y[i]);
+		if (k == -1) {
+			k = numPoints++;
+			pointX[k] = x[i];
+			pointY[k] = y[i];
+		} // end if
+		pointNode[k] = result.propPinNodes[i];
+	} // end for
+
+	auto resolveNode = [&](const int n) {
+		if (n < numPins)
+			return n; // regular node
+
+		// steiner node
+		const int k = findPoint(flutetree.branch[n].x, flutetree.branch[n].y);
+		if (k != -1)
+			return pointNode[k];
+		pointX[numPoints] = flutetree.branch[n].x;
+		pointY[numPoints] = flutetree.branch[n].y;
+		pointNode[numPoints] = n;
+		numPoints++;
+		return n;
+	}; // end lambda
+
+	const int numBranches = 2 * flutetree.deg - 2;
+	for (int j = 0; j < numBranches; j++) {
+		const int i = flutetree.branch[j].n;
+		if (j == i)
+			continue;
+
+		const DBU wirelength =
+			std::abs(flutetree.branch[j].x - flutetree.branch[i].x) +
+			std::abs(flutetree.branch[j].y - flutetree.branch[i].y);
+
+		const int index_j = resolveNode(j);
+		const int index_i = resolveNode(i);
+		if (index_j == index_i)
+			continue;
+
+		const int a = std::min(index_j, index_i);
+		const int b = std::max(index_j, index_i);
+
+		bool duplicated = false;
+		for (int k = 0; k < result.propNumSegments && !duplicated; k++) {
+			const int *segment = result.propSegments[k];
+			duplicated = std::min(segment[0], segment[1]) == a &&
+					std::max(segment[0], segment[1]) == b;
+		} // end for
+		if (duplicated)
+			continue;
+
+		result.propSegments[result.propNumSegments][0] = index_i;
+		result.propSegments[result.propNumSegments][1] = index_j;
+		result.propNumSegments++;
+		result.propWirelength += wirelength;
+	} // end for
+
+	for (int k = 0; k < numPoints; k++) {
+		result.propPositionNodes[k] = pointNode[k];
+		result.propPositionX[k] = (DBU) pointX[k];
+		result.propPositionY[k] = (DBU) pointY[k];
+	} // end for
+	result.propNumPositions = numPoints;
+
+	free(flutetree.branch);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void DefaultRoutingEstimationModel::reportTopologyCache(std::ostream &out) {
+	const long long numHits = clsTopologyCache.getNumHits();
+	const long long numMisses = clsTopologyCache.getNumMisses();
+	const long long numLookups = numHits + numMisses;
+
+	out << "Steiner topology cache (nets with 3 to "
+			<< SteinerTopologyCache::MAX_DEGREE << " pins):\n";
+	out << "  Enabled: " << (clsEnableTopologyCache? "true" : "false") << "\n";
+	out << "  Entries: " << clsTopologyCache.getNumEntries() << "\n";
+	out << "  Lookups: " << numLookups << "\n";
+	out << "  Hits:    " << numHits;
+	if (numLookups > 0) {
+		out << " (" << (100.0 * numHits / numLookups) << "%)";
+	} // end if
+	out << "\n";
+	out << "  Misses:  " << numMisses << "\n";
+} // end method
+
+// -----------------------------------------------------------------------------
+
 void DefaultRoutingEstimationModel::generateFluteAvgRuntimeTable(const int N,
 		const double maxSecondsPerDegree,
 		const int minNumTreesPerDegree,
@@ -341,5 +635,80 @@ void DefaultRoutingEstimationModel::generateFluteAvgRuntimeTable(const int N,
 	delete[] mapping;
 } // end method
 
+// -----------------------------------------------------------------------------
+
+int DefaultRoutingEstimationModel::checkFluteSorting(const int minDegree) {
+	std::vector<FLUTE_DTYPE> x;
+	std::vector<FLUTE_DTYPE> y;
+	std::vector<int> mapping[2];
+
+	const Flute::SortingAlgorithm algorithms[2] = {
+		Flute::FLUTE_SORT_DEFAULT,
+		Flute::FLUTE_SORT_LEGACY
+	};
+
+	Stopwatch watch[2];
+
+	int numNets = 0;
+	int numMismatches = 0;
+	DBU totalWirelength[2] = {0, 0};
+
+	for (Rsyn::Net net : module.allNets()) {
+		const int numPins = net.getNumPins();
+		if (numPins < std::max(2, minDegree))
+			continue;
+
+		x.clear();
+		y.clear();
+		for (Rsyn::Pin pin : net.allPins()) {
+			const DBUxy pinPos = clsPhysicalDesign.getPinPosition(pin);
+			x.push_back((FLUTE_DTYPE) (pinPos[X]));
+			y.push_back((FLUTE_DTYPE) (pinPos[Y]));
+		} // end for
+
+		Flute::Tree tree[2];
+		for (int k = 0; k < 2; k++) {
+			mapping[k].resize(numPins);
+			watch[k].start();
+			tree[k] = Flute::flute(numPins, x.data(), y.data(), FLUTE_ACCURACY,
+					mapping[k].data(), algorithms[k]);
+			watch[k].stop();
+			totalWirelength[k] += Flute::wirelength(tree[k]);
+		} // end for
+
+		bool match = tree[0].deg == tree[1].deg &&
+				Flute::wirelength(tree[0]) == Flute::wirelength(tree[1]) &&
+				mapping[0] == mapping[1];
+		const int numBranches = 2 * tree[0].deg - 2;
+		for (int i = 0; match && i < numBranches; i++) {
+			const Flute::Branch &b0 = tree[0].branch[i];
+			const Flute::Branch &b1 = tree[1].branch[i];
+			match = b0.x == b1.x && b0.y == b1.y && b0.n == b1.n;
+		} // end for
+
+		if (!match) {
+			if (numMismatches < 10) {
+				std::cout << "[ERROR] Flute sorting mismatch on net "
+						<< net.getName() << " (" << numPins << " pins).\n";
+			} // end if
+			numMismatches++;
+		} // end if
+
+		free(tree[0].branch);
+		free(tree[1].branch);
+		numNets++;
+	} // end for
+
+	std::cout << "Checked nets: " << numNets << "\n";
+	std::cout << "Mismatches: " << numMismatches << "\n";
+	std::cout << "Wirelength (default/legacy): "
+			<< totalWirelength[0] << " / " << totalWirelength[1] << "\n";
+	std::cout << "Runtime (default/legacy): "
+			<< watch[0].getElapsedTime() << "s / "
+			<< watch[1].getElapsedTime() << "s\n";
+
+	return numMismatches;
+} // end method
+
 
 } // end namespace
\ No newline at end of file
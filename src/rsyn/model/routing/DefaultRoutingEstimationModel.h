@@ -22,6 +22,7 @@
 #include "rsyn/session/Session.h"
 #include "rsyn/model/scenario/Scenario.h"
 #include "rsyn/model/routing/RoutingEstimationModel.h"
+#include "rsyn/model/routing/SteinerTopologyCache.h"
 
 namespace Rsyn {
 class PhysicalService;
@@ -50,15 +51,33 @@ private:
 	// Config
 	static const bool ENABLE_DO_NOT_USE_FLUTE_FOR_2_PIN_NETS;
 
+	// Topologies of low-degree nets.
+	SteinerTopologyCache clsTopologyCache;
+	bool clsEnableTopologyCache = true;
+
 	// Call FLUTE to generate a routing topology.
 	DBU generateSteinerTree(Rsyn::Net net, Rsyn::RoutingTopologyDescriptor<int> &topology);
 
+	// Same as generateSteinerTree(), but for nets with up to
+	// SteinerTopologyCache::MAX_DEGREE pins. Uses fixed-size buffers instead
+	// of allocating memory and looks up the topology in the cache, if
+	// enabled, before calling FLUTE.
+	DBU generateLowDegreeSteinerTree(Rsyn::Net net, Rsyn::RoutingTopologyDescriptor<int> &topology);
+
+	// Calls FLUTE for the pin pattern in the key.
+	void buildLowDegreeSteinerTopology(const SteinerTopologyCache::Key &key,
+			SteinerTopologyCache::Topology &result) const;
+
 public:
 
 	DefaultRoutingEstimationModel() {}
 
 	virtual void updateRoutingEstimation(Rsyn::Net net, Rsyn::RoutingTopologyDescriptor<int> &topology, DBU &wirelength);
 
+	// FLUTE (without its internal multi-threading) only reads its look-up
+	// tables after initialization.
+	virtual bool isThreadSafe() const override { return true; }
+
 	////////////////////////////////////////////////////////////////////////////
 	// Analysis: Flute
 	////////////////////////////////////////////////////////////////////////////
@@ -75,6 +94,31 @@ public:
 			const int largeStepStart = 100,
 			const int largeStep = 10);
 
+	// Regression check for Flute point sorting. Builds the Steiner tree of
+	// every net with at least minDegree pins using the default and the legacy
+	// (selection sort) algorithms and reports nets whose wirelength, tree or
+	// pin mapping differ. Returns the number of mismatches.
+
+	int checkFluteSorting(const int minDegree = 2);
+
+	// Writes the loaded Flute look-up tables in the binary format. The file
+	// is written to a temporary file and then renamed, so concurrent runs
+	// never map a partially written file. Returns false on failure.
+
+	bool writeFluteLUT(const std::string &filename);
+
+	////////////////////////////////////////////////////////////////////////////
+	// Topology Cache
+	////////////////////////////////////////////////////////////////////////////
+
+	void setTopologyCacheEnabled(const bool enable) { clsEnableTopologyCache = enable; }
+	bool isTopologyCacheEnabled() const { return clsEnableTopologyCache; }
+
+	void clearTopologyCache() { clsTopologyCache.clear(); }
+
+	// Reports the number of entries, hits and misses of the topology cache.
+	void reportTopologyCache(std::ostream &out = std::cout);
+
 }; // end class
 
 } // end namespace
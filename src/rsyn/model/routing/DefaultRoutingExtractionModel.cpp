@@ -13,6 +13,8 @@
  * limitations under the License.
  */
  
+#include <atomic>
+
 #include "rsyn/model/routing/DefaultRoutingExtractionModel.h"
 
 namespace Rsyn {
@@ -54,17 +56,43 @@ void DefaultRoutingExtractionModel::initialize(
 
 // -----------------------------------------------------------------------------
 
+std::unique_ptr<RoutingExtractionWorkspace>
+DefaultRoutingExtractionModel::createWorkspace() const {
+	return std::unique_ptr<RoutingExtractionWorkspace>(new Workspace);
+} // end method
+
+// -----------------------------------------------------------------------------
+
 void DefaultRoutingExtractionModel::extract(const Rsyn::RoutingTopologyDescriptor<int> &topology, RCTree &tree) {
+	Workspace workspace;
+	extract(topology, tree, &workspace);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void DefaultRoutingExtractionModel::extract(
+		const Rsyn::RoutingTopologyDescriptor<int> &topology,
+		RCTree &tree,
+		RoutingExtractionWorkspace *workspace
+) {
+	Workspace *ws = dynamic_cast<Workspace *>(workspace);
+	if (!ws) {
+		extract(topology, tree);
+		return;
+	} // end if
+
 	const Number wireCapPerDistanceUnit = getLocalWireCapPerUnitLength();
 	const Number wireResPerDistanceUnit = getLocalWireResPerUnitLength();
 	const DBU longWirelengthThreshold = MAX_WIRE_SEGMENT_LENGTH;
 
 	// Build RC tree.
-	RCTreeDescriptor dscp;
+	RCTreeDescriptor &dscp = ws->dscp;
+	dscp.clear();
 	dscp.applyDefaultNodeTag(RCTreeNodeTag(nullptr, 0, 0));
 
 	int sliceId = 0; // we use negative indexes for slicing points
-	std::deque<SlicingPoint> slicingPoints;
+	std::vector<SlicingPoint> &slicingPoints = ws->slicingPoints;
+	slicingPoints.clear();
 
 	Rsyn::Pin driver = nullptr;
 	int root = -1;
@@ -137,7 +165,7 @@ void DefaultRoutingExtractionModel::extract(const Rsyn::RoutingTopologyDescripto
 	} // end for
 
 	// Define the tag for slicing points.
-	for (auto sp : slicingPoints) {
+	for (const SlicingPoint &sp : slicingPoints) {
 		RCTreeNodeTag &tag = dscp.getNodeTag(sp.id);
 		tag.x = sp.x;
 		tag.y = sp.y;
@@ -145,8 +173,8 @@ void DefaultRoutingExtractionModel::extract(const Rsyn::RoutingTopologyDescripto
 
 	// Build the tree.
 	if (!tree.build(dscp, root, true)) {
-		static bool warned = false;
-		if (!warned) {
+		static std::atomic<bool> warned(false);
+		if (!warned.exchange(true)) {
 			std::cout << "\n[WARNING] A loop was detected (and removed) when building "
 					<< "the tree. "
 					<< "The tree returned by FLUTE may generate "
@@ -156,7 +184,6 @@ void DefaultRoutingExtractionModel::extract(const Rsyn::RoutingTopologyDescripto
 					<< "Note that this is not necessary a bug in the merging scheme, "
 					<< "but just a consequence of the tree topology returned by FLUTE. "
 					<< "Next warnings will be suppressed...\n";
-			warned = true;
 		} // end else
 	} // end else
 
@@ -211,7 +238,7 @@ int DefaultRoutingExtractionModel::generateSteinerTree_SliceLongWire(
 	const int index_j,
 	const DBU xi, const DBU yi,
 	const DBU xj, const DBU yj,
-	std::deque<SlicingPoint> &slicingPoints,
+	std::vector<SlicingPoint> &slicingPoints,
 	RCTreeDescriptor &dscp,
 	int &sliceId) const {
 
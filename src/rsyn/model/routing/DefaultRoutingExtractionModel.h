@@ -69,6 +69,13 @@ private:
 		DBU y;
 	}; // end struct
 
+	// Memory reused across extractions.
+	class Workspace : public RoutingExtractionWorkspace {
+	public:
+		RCTreeDescriptor dscp;
+		std::vector<SlicingPoint> slicingPoints;
+	}; // end class
+
 	int generateSteinerTree_SliceLongWire(
 			const DBU longWirelengthThreshold,
 			const Number wireCapPerMicron,
@@ -77,7 +84,7 @@ private:
 			const int index_j,
 			const DBU xi, const DBU yi,
 			const DBU xj, const DBU yj,
-			std::deque<SlicingPoint> &slicingPoints,
+			std::vector<SlicingPoint> &slicingPoints,
 			RCTreeDescriptor &dscp,
 			int &sliceId
 	) const;
@@ -87,10 +94,16 @@ public:
 	DefaultRoutingExtractionModel() {}
 
 	virtual void extract(const RoutingTopologyDescriptor<int> &topology, RCTree &tree) override;
+	virtual void extract(const RoutingTopologyDescriptor<int> &topology, RCTree &tree,
+			RoutingExtractionWorkspace *workspace) override;
+
+	virtual std::unique_ptr<RoutingExtractionWorkspace> createWorkspace() const override;
 	virtual void updateDownstreamCap(Rsyn::RCTree &tree) override;
+	virtual bool isThreadSafe() const override { return true; }
 
 	virtual Number getLocalWireResPerUnitLength() const override { return LOCAL_WIRE_RES_PER_UNIT_LENGTH; }
 	virtual Number getLocalWireCapPerUnitLength() const override { return LOCAL_WIRE_CAP_PER_UNIT_LENGTH; }
+	DBU getMaxWireSegmentLength() const { return MAX_WIRE_SEGMENT_LENGTH; }
 
 }; // end class
 
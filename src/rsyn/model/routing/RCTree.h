@@ -34,6 +34,7 @@ using std::queue;
 
 #include "rsyn/model/timing/types.h"
 #include "rsyn/model/timing/EdgeArray.h"
+#include "rsyn/model/routing/RoutingNodeMap.h"
 #include "rsyn/util/Exception.h"
 #include "rsyn/util/dbu.h"
 
@@ -114,12 +115,16 @@ public:
 	}; // end struct
 
 private:
-	map<NameType, int> clsNodeMap;
+	RoutingNodeMap<NameType> clsNodeMap;
 
 	std::vector<Node> clsNodes;
 	std::vector<Resistor> clsResistors;
 	std::vector<Capacitor> clsCapacitors;
 
+	// Resistor lists of the nodes removed by clear(), which are reused by new
+	// nodes so that a descriptor reused for several nets does not allocate.
+	std::vector<std::vector<int>> clsSpareResistorLists;
+
 	Number clsTotalTreeCapacitance;
 
 	// TODO: Add description.
@@ -130,6 +135,10 @@ public:
 	// TODO: Add description.
 	RCTreeDescriptorTemplate();
 
+	// Removes all nodes, resistors and capacitors, but keeps the memory
+	// allocated to them.
+	void clear();
+
 	// TODO: Add description.
 	void addResistor(const NameType &sourceNode, const NameType &targetNode, const Number resistance);
 
@@ -308,6 +317,7 @@ protected:
 	std::vector< EdgeArray<Number> > clsCeffs;
 
 	bool clsDirty : 1;
+	bool clsDownstreamCapDirty : 1; // only cleared by updateDownstreamCap()
 	bool clsLoopDetectedAndRemoved : 1;
 	bool clsIdeal : 1;
 	bool clsHasUserSpecifiedWireLoad : 1;
@@ -535,20 +545,42 @@ template<class NameType, class TagType>
 inline
 int
 RCTreeDescriptorTemplate<NameType, TagType>::createNode(const NameType &name) {
-	typename map<NameType, int>::iterator it = clsNodeMap.find(name);
-	if (it != clsNodeMap.end()) {
-		return it->second;
+	const int index = clsNodes.size();
+	const int existing = clsNodeMap.insert(name, index);
+	if (existing != -1) {
+		return existing;
 	} else {
-		const int index = clsNodes.size();
 		clsNodes.resize(clsNodes.size() + 1);
 		clsNodes.back().propName = name;
-		clsNodeMap[name] = index;
+		if (!clsSpareResistorLists.empty()) {
+			clsNodes.back().propResistors.swap(clsSpareResistorLists.back());
+			clsSpareResistorLists.pop_back();
+		} // end if
 		return index;
 	} // end if
 } // end method
 
 // -----------------------------------------------------------------------------
 
+template<class NameType, class TagType>
+inline
+void
+RCTreeDescriptorTemplate<NameType, TagType>::clear() {
+	for (Node &node : clsNodes) {
+		node.propResistors.clear();
+		clsSpareResistorLists.push_back(std::vector<int>());
+		clsSpareResistorLists.back().swap(node.propResistors);
+	} // end for
+
+	clsNodeMap.clear();
+	clsNodes.clear();
+	clsResistors.clear();
+	clsCapacitors.clear();
+	clsTotalTreeCapacitance = 0.0;
+} // end method
+
+// -----------------------------------------------------------------------------
+
 template<class NameType, class TagType>
 inline
 void
@@ -651,8 +683,7 @@ template<class NameType, class TagType>
 inline
 int
 RCTreeDescriptorTemplate<NameType, TagType>::findNode(const NameType &name) const {
-	typename map<NameType, int>::const_iterator it = clsNodeMap.find(name);
-	return ( it != clsNodeMap.end() ? it->second : -1);
+	return clsNodeMap.find(name);
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -661,11 +692,11 @@ template<class NameType, class TagType>
 inline
 int
 RCTreeDescriptorTemplate<NameType, TagType>::findNodeOrException(const NameType &name) {
-	typename std::map<NameType, int>::const_iterator it = clsNodeMap.find(name);
+	const int index = clsNodeMap.find(name);
 
-	if (it == clsNodeMap.end())
+	if (index == -1)
 		throw RCTreeNodeNotFoundException();
-	return it->second;
+	return index;
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -978,6 +1009,7 @@ template<class NameType, class TagType>
 inline
 void RCTreeBaseTemplate<NameType, TagType>::clear() {
 	clsDirty = false;
+	clsDownstreamCapDirty = true;
 	clsLoopDetectedAndRemoved = false;
 	clsIdeal = false;
 	clsHasUserSpecifiedWireLoad = false;
@@ -1064,10 +1096,22 @@ bool RCTreeBaseTemplate<NameType, TagType>::build(const RCTreeDescriptorTemplate
 ) {
 	const int numNodes = dscp.getNumNodes();
 
-	// Clean up
+	// Clean up, but keep the sink lists of the nodes as trees are typically
+	// rebuilt with a similar topology (e.g. after incremental placement
+	// changes).
+	std::vector<Node> nodes;
+	nodes.swap(clsNodes);
 	clear();
+	clsNodes.swap(nodes);
 
 	clsNodes.resize(numNodes);
+	for (Node &node : clsNodes) {
+		std::vector<int> sinks;
+		sinks.swap(node.propSinks);
+		sinks.clear();
+		node = Node();
+		node.propSinks.swap(sinks);
+	} // end for
 	clsNodeNames.resize(numNodes);
 	clsNodeTags.resize(numNodes);
 	clsCeffs.resize(numNodes);
@@ -1124,6 +1168,7 @@ void RCTreeBaseTemplate<NameType, TagType>::updateDownstreamCap() {
 	} // end for
 
 	clsDirty = false;
+	clsDownstreamCapDirty = false;
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -1214,7 +1259,7 @@ template<class RCTreeDriver>
 inline
 void
 RCTreeBaseTemplate<NameType, TagType>::simulate(const RCTreeDriver &driver, const Number epsilon, const int maxIterations) {
-	if (clsDirty)
+	if (clsDownstreamCapDirty)
 		updateDownstreamCap();
 
 	const int numNodes = clsNodes.size();
@@ -1222,7 +1267,7 @@ RCTreeBaseTemplate<NameType, TagType>::simulate(const RCTreeDriver &driver, cons
 	// Initially set effective capacitance equals to downstream capacitance.
 	for (int i = 0; i < numNodes; i++) {
 		Node &node = clsNodes[i];
-		node.propEffectiveCap = EdgeArray<Number>(clsNodes[i].propDownstreamCap, clsNodes[i].propDownstreamCap);
+		node.propEffectiveCap = node.propDownstreamCap;
 	} // end for
 
 	bool converged = false;
@@ -1394,7 +1439,7 @@ RCTreeBaseTemplate<NameType, TagType>::computeEffectiveCapacitanceBasedOnMenezes
 template<class NameType, class TagType>
 inline
 void RCTreeBaseTemplate<NameType, TagType>::reduceToPiModel(EdgeArray<Number> &C1, EdgeArray<Number> &R, EdgeArray<Number> &C2) {
-	if (clsDirty)
+	if (clsDownstreamCapDirty)
 		updateDownstreamCap();
 
 	updateDrivingPoint();
@@ -1412,27 +1457,28 @@ inline
 void RCTreeBaseTemplate<NameType, TagType>::elmore() {
 	const int numNodes = clsNodes.size();
 
-	updateDownstreamCap();
+	// The downstream caps only change when loads change, so the second call
+	// for the same net (e.g. late after early) reuses them.
+	if (clsDownstreamCapDirty)
+		updateDownstreamCap();
 
 	Node &rootState = clsNodes[0];
 	rootState.propDelay.set(0, 0);
 	rootState.propSecondMoment.set(0, 0);
+	rootState.propDownstreamCapDelay.set(0, 0); // root delay is zero
 
-	// Compute delay.
+	// Compute delay and, for the slew, the cap-delay of each node in the same
+	// pass, while the node is still in cache.
 	for (int n = 1; n < numNodes; n++) { // 1 => skips root node
 		Node &node = clsNodes[n];
 		const Node &parent = clsNodes[node.propParent];
 
 		node.propDelay = parent.propDelay +
 			node.propDrivingResistance * node.propDownstreamCap;
-	} // end for
-
-	// Compute slew - first pass: update downstream cap-delay
-	for (int i = 0; i < numNodes; i++) {
-		Node &node = clsNodes[i];
 		node.propDownstreamCapDelay = node.getTotalCap() * node.propDelay;
 	} // end for
 
+	// Compute slew - first pass: accumulate downstream cap-delay
 	for (int n = numNodes - 1; n > 0; n--) { // n > 0 skips root node
 		const Node &node = clsNodes[n];
 		clsNodes[node.propParent].propDownstreamCapDelay += node.propDownstreamCapDelay;
@@ -1466,6 +1512,7 @@ void RCTreeBaseTemplate<NameType, TagType>::setNodeLoadCap(const int index, cons
 	clsLoadCap += node.getPinCap();
 
 	clsDirty = true;
+	clsDownstreamCapDirty = true;
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -29,6 +29,10 @@ public:
 
 	virtual void updateRoutingEstimation(Rsyn::Net net, Rsyn::RoutingTopologyDescriptor<int> &topology, DBU &wirelength) = 0;
 
+	// Returns true if updateRoutingEstimation() can be called concurrently for
+	// different nets.
+	virtual bool isThreadSafe() const { return false; }
+
 }; // end class
 
 } // end namespace
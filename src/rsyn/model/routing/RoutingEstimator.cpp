@@ -13,16 +13,34 @@
  * limitations under the License.
  */
  
+#include <atomic>
+#include <algorithm>
+
 #include "rsyn/model/routing/RoutingEstimator.h"
 #include "rsyn/model/routing/DefaultRoutingEstimationModel.h"
 #include "rsyn/model/routing/DefaultRoutingExtractionModel.h"
 #include "rsyn/session/Session.h"
 #include "rsyn/phy/PhysicalService.h"
+#include "rsyn/util/ThreadPool.h"
 
 namespace Rsyn {
 
 // -----------------------------------------------------------------------------
 
+const int RoutingEstimator::PARALLEL_MIN_NETS = 64;
+
+// -----------------------------------------------------------------------------
+
+RoutingEstimator::RoutingEstimator() {
+} // end constructor
+
+// -----------------------------------------------------------------------------
+
+RoutingEstimator::~RoutingEstimator() {
+} // end destructor
+
+// -----------------------------------------------------------------------------
+
 void RoutingEstimator::start(const Json &params) {
 	Rsyn::Session session;
 
@@ -36,6 +54,8 @@ void RoutingEstimator::start(const Json &params) {
 
 	clsFullUpdateAlreadyPerformed = false;
 
+	setNumThreads(params.value("numThreads", clsNumThreads));
+
 	// TODO: Maybe we should not do this here as this create a soft dependency
 	// to physical layer
 	Rsyn::PhysicalService *physical =
@@ -69,10 +89,19 @@ void RoutingEstimator::start(const Json &params) {
 			ScriptParsing::PARAM_SPEC_OPTIONAL,
 			"Name o of the target net.",
 			"");
+
+		dscp.addNamedParam("numThreads",
+			ScriptParsing::PARAM_TYPE_INTEGER,
+			ScriptParsing::PARAM_SPEC_OPTIONAL,
+			"Number of threads (0 keeps the current setting).",
+			"0");
 		
 		session.registerCommand(dscp, [&](const ScriptParsing::Command &command) {
 			const bool full = command.getParam("full");
 			const std::string netName = command.getParam("net");
+			const int numThreads = command.getParam("numThreads");
+
+			if (numThreads > 0) setNumThreads(numThreads);
 			
 			if (full) {
 				updateRoutingFull();
@@ -117,12 +146,41 @@ void RoutingEstimator::onPostCellRemap(Rsyn::Cell cell, Rsyn::LibraryCell oldLib
 
 // -----------------------------------------------------------------------------
 
+void RoutingEstimator::onPostDesignEdit(const Rsyn::DesignChangeSet &changes) {
+	for (const std::tuple<Rsyn::Cell, Rsyn::LibraryCell> &remap : changes.remappedCells) {
+		dirtyInstance(std::get<0>(remap), NET_UPDATE_TYPE_DOWNSTREAM_CAP);
+	} // end for
+
+	if (!changes.createdNets.empty()) {
+		std::cout << "INFO: RoutingEstimator was notified about "
+				<< changes.createdNets.size() << " new net(s).\n";
+		for (Rsyn::Net net : changes.createdNets) {
+			clsDirtyNets[net] = NET_UPDATE_TYPE_FULL;
+		} // end for
+	} // end if
+} // end method
+
+// -----------------------------------------------------------------------------
+
 void RoutingEstimator::onPostMovedInstance(Rsyn::PhysicalInstance phInstance) {
 	dirtyInstance(phInstance.getInstance(), NET_UPDATE_TYPE_FULL);
 } // end method
 
 // -----------------------------------------------------------------------------
 
+void RoutingEstimator::setNumThreads(const int numThreads) {
+	clsNumThreads = std::max(1, numThreads);
+	if (clsNumThreads > 1) {
+		if (!clsThreadPool || (int) clsThreadPool->getNumThreads() != clsNumThreads) {
+			clsThreadPool.reset(new ThreadPool(clsNumThreads));
+		} // end if
+	} else {
+		clsThreadPool.reset();
+	} // end else
+} // end method
+
+// -----------------------------------------------------------------------------
+
 void RoutingEstimator::updateRoutingOfNet(Rsyn::Net net, const NetUpdateTypeEnum updateType) {
 	if (net.getNumPins() < 2 || net == clsScenario->getClockNet())
 		return;
@@ -131,30 +189,130 @@ void RoutingEstimator::updateRoutingOfNet(Rsyn::Net net, const NetUpdateTypeEnum
 
 	// Incrementally update the Steiner wirelength;
 	clsTotalWirelength -= timingNet.wirelength;
+	computeRoutingOfNet(net, updateType, timingNet, clsWorkspace);
+	clsTotalWirelength += timingNet.wirelength;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void RoutingEstimator::updateRoutingOfNets(const std::vector<Rsyn::Net> &nets) {
+	StopwatchGuard guard(clsStopwatchUpdateSteinerTrees);
+
+	std::vector<RoutingTask> tasks;
+	tasks.reserve(nets.size());
+	for (Rsyn::Net net : nets) {
+		addRoutingTask(tasks, net, NET_UPDATE_TYPE_FULL);
+	} // end for
+	runRoutingTasks(tasks);
 
+	for (Rsyn::Net net : nets) {
+		clsDirtyNets.erase(net);
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void RoutingEstimator::initRoutingWorkspace(RoutingWorkspace &workspace) const {
+	workspace.extraction = routingExtractionModel?
+			routingExtractionModel->createWorkspace() : nullptr;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void RoutingEstimator::computeRoutingOfNet(Rsyn::Net net, 
+		const NetUpdateTypeEnum updateType, RoutingNet &routingNet,
+		RoutingWorkspace &workspace) {
 	DBU netSteinerWirelength = 0;
 	if (routingEstimationModel) {
 
 		switch (updateType) {
 			case NET_UPDATE_TYPE_FULL: {
-				Rsyn::RoutingTopologyDescriptor<int> topology;
+				Rsyn::RoutingTopologyDescriptor<int> &topology = workspace.topology;
+				topology.clear();
 				routingEstimationModel->updateRoutingEstimation(net, topology, netSteinerWirelength);
 				if (routingExtractionModel) {
-					routingExtractionModel->extract(topology, timingNet.rctree);
+					routingExtractionModel->extract(topology, routingNet.rctree,
+							workspace.extraction.get());
 				} // end if
 				break;
 			} // end case
 
 			case NET_UPDATE_TYPE_DOWNSTREAM_CAP: {
-				routingExtractionModel->updateDownstreamCap(timingNet.rctree);
+				routingExtractionModel->updateDownstreamCap(routingNet.rctree);
 				break;
 			} // end case
 		} // end switch
 	} // end if
 
-	// Incrementally update the Steiner wirelength;
-	timingNet.wirelength = netSteinerWirelength;
-	clsTotalWirelength += netSteinerWirelength;
+	routingNet.wirelength = netSteinerWirelength;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void RoutingEstimator::addRoutingTask(std::vector<RoutingTask> &tasks, 
+		Rsyn::Net net, const NetUpdateTypeEnum updateType) {
+	if (net.getNumPins() < 2 || net == clsScenario->getClockNet())
+		return;
+
+	RoutingTask task;
+	task.net = net;
+	task.routingNet = &clsRoutingNets[net];
+	task.updateType = updateType;
+	task.previousWirelength = task.routingNet->wirelength;
+	tasks.push_back(task);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void RoutingEstimator::runRoutingTasks(std::vector<RoutingTask> &tasks) {
+	const int numTasks = (int) tasks.size();
+
+	const bool parallel = clsThreadPool && numTasks >= PARALLEL_MIN_NETS &&
+			(!routingEstimationModel || routingEstimationModel->isThreadSafe()) &&
+			(!routingExtractionModel || routingExtractionModel->isThreadSafe());
+
+	if (!parallel) {
+		for (RoutingTask &task : tasks) {
+			computeRoutingOfNet(task.net, task.updateType, *task.routingNet, clsWorkspace);
+		} // end for
+	} else {
+		// The cost of a net grows super-linearly with its degree, so a few
+		// large nets may dominate the runtime. Nets are therefore processed by
+		// decreasing degree and each thread grabs the next net as soon as it
+		// finishes the current one, so that large nets start first and the
+		// small ones fill in the gaps.
+		std::vector<int> order(numTasks);
+		std::vector<int> degrees(numTasks);
+		for (int i = 0; i < numTasks; i++) {
+			order[i] = i;
+			degrees[i] = tasks[i].net.getNumPins();
+		} // end for
+		std::stable_sort(order.begin(), order.end(), [&](const int a, const int b) {
+			return degrees[a] > degrees[b];
+		});
+
+		std::atomic<int> next(0);
+		const int numThreads = (int) clsThreadPool->getNumThreads();
+		std::vector<RoutingWorkspace> workspaces(numThreads);
+		for (int t = 0; t < numThreads; t++) {
+			RoutingWorkspace *workspace = &workspaces[t];
+			initRoutingWorkspace(*workspace);
+			clsThreadPool->addTask([&, workspace]() {
+				for (int i = next++; i < numTasks; i = next++) {
+					RoutingTask &task = tasks[order[i]];
+					computeRoutingOfNet(task.net, task.updateType, *task.routingNet, *workspace);
+				} // end for
+			});
+		} // end for
+		clsThreadPool->wait();
+	} // end else
+
+	// Update the total wirelength in the task order so that the result does
+	// not depend on the thread scheduling.
+	for (const RoutingTask &task : tasks) {
+		clsTotalWirelength -= task.previousWirelength;
+		clsTotalWirelength += task.routingNet->wirelength;
+	} // end for
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -163,60 +321,12 @@ void RoutingEstimator::updateRoutingFull() {
 	StopwatchGuard guard(clsStopwatchUpdateSteinerTrees);
 	
 	// Update steiner trees.
-#if !MULTI_THREADED_STEINER_TREE_UPDATE
-	// Single-Thread
+	std::vector<RoutingTask> tasks;
+	tasks.reserve(design.getNumNets());
 	for (Rsyn::Net net : module.allNets()) {
-		updateRoutingOfNet(net, NET_UPDATE_TYPE_FULL);
+		addRoutingTask(tasks, net, NET_UPDATE_TYPE_FULL);
 	} // end for
-#else
-	// Multi-Thread
-	// Why didn't it work? Looks straightforward, but even with 4 threads it
-	// takes the same amount of time compared to a single thread. Looking at
-	// processor usage, it looks only one is fully working. But I checked using
-	// debug messages and the threads seems actually working in parallel. I did
-	// not see the system using the swap memory.
-
-	// Answer: it was because a single net, the clock net, which is huge, was
-	// taking the most of runtime (~70% for leon3mp). So splitting the nets
-	// without taking into account their degree is not a good idea. But even
-	// doing a nice load balance, the clock tree would make the whole runtime
-	// not much faster. We found that the bulk of runtime (~75%) for large trees 
-	// in FLUTE is due to the sorting of node which is done using selection sort
-	// in the version provided in the ICCAD 2014 contest.
-
-	// For toy benchmarks in fact the number of cores may be greater than the 
-	// nets, so we need to cast to double.
-	const int numCores = max(2u, std::thread::hardware_concurrency());
-	const int numWorkPerThread = (int) ceil(
-		double(clsNumNets) / numCores
-		);
-
-	vector<std::thread> threads;
-
-	cout << "#nets: " << clsNumNets << "\n";
-
-	int n0 = 0;
-	int n1 = 0;
-	for (int i = 0; i < numCores; i++) {
-		n1 = min(clsNumNets, n0 + numWorkPerThread);
-		threads.push_back(std::thread([this, n0, n1]() { // don't use &, we need a copy here!
-			for (int n = n0; n < n1; n++)
-				updateRoutingOfNet(n, NET_UPDATE_TYPE_FULL);
-		}));
-		cout << "\tthread: " << n0 << " " << n1 << "\n";
-		n0 = n1;
-	} // end for
-
-	for (auto &thread : threads) {
-		thread.join();
-	} // end for
-
-	// Need to recompute Steiner WL due to race conditions in incremental 
-	// steiner wirelength update.
-	clsTotalWirelength = 0;
-	for (DBU wl : clsNetSteinerWirelengths)
-		clsTotalWirelength += wl;
-#endif
+	runRoutingTasks(tasks);
 	
 	// Clear dirty routing cells.
 	clsDirtyNets.clear();
@@ -233,11 +343,14 @@ void RoutingEstimator::updateRouting() {
 		updateRoutingFull();
 	} else {
 		clsStopwatchUpdateSteinerTrees.start();
+		std::vector<RoutingTask> tasks;
+		tasks.reserve(clsDirtyNets.size());
 		for (auto& t : clsDirtyNets) {
 			Rsyn::Net net = std::get<0>(t);
 			NetUpdateType updateType = std::get<1>(t);
-			updateRoutingOfNet(net, updateType.getType());
+			addRoutingTask(tasks, net, updateType.getType());
 		} // end for
+		runRoutingTasks(tasks);
 		clsStopwatchUpdateSteinerTrees.stop();
 
 		// Clear dirty routing cells.
@@ -17,6 +17,7 @@
 #define RSYN_ROUTING_ESTIMATOR_H
 
 #include <iostream>
+#include <memory>
 
 #include "rsyn/core/Rsyn.h"
 #include "rsyn/session/Service.h"
@@ -27,6 +28,8 @@
 #include "rsyn/model/scenario/Scenario.h"
 #include "rsyn/util/Stopwatch.h"
 
+class ThreadPool;
+
 namespace Rsyn {
 
 class Session;
@@ -86,14 +89,61 @@ private:
 	DBU clsTotalWirelength;
 	
 	Rsyn::Attribute<Rsyn::Net, RoutingNet> clsRoutingNets;
+
+	// A net to be updated. The routing net is resolved before the update
+	// starts so that workers do not touch the attribute storage.
+	struct RoutingTask {
+		Rsyn::Net net;
+		RoutingNet * routingNet;
+		NetUpdateTypeEnum updateType;
+		DBU previousWirelength;
+	}; // end struct
+
+	// Memory reused across nets by a thread.
+	struct RoutingWorkspace {
+		Rsyn::RoutingTopologyDescriptor<int> topology;
+		std::unique_ptr<RoutingExtractionWorkspace> extraction;
+	}; // end struct
+
+	// Minimum number of nets to use multiple threads.
+	static const int PARALLEL_MIN_NETS;
+
+	int clsNumThreads = 1;
+	std::unique_ptr<ThreadPool> clsThreadPool;
+
+	// Workspace used when nets are routed sequentially.
+	RoutingWorkspace clsWorkspace;
+
+	// Adds a task to update a net if the net is routed.
+	void addRoutingTask(std::vector<RoutingTask> &tasks, Rsyn::Net net, 
+			const NetUpdateTypeEnum updateType);
+
+	// Computes the routing of a net. Does not update the total wirelength and
+	// therefore can be called concurrently for different nets if the
+	// estimation and extraction models are thread safe.
+	void computeRoutingOfNet(Rsyn::Net net, const NetUpdateTypeEnum updateType,
+			RoutingNet &routingNet, RoutingWorkspace &workspace);
+
+	// Prepares a workspace for the current extraction model.
+	void initRoutingWorkspace(RoutingWorkspace &workspace) const;
+
+	// Runs the tasks, in parallel if possible, and then updates the total
+	// wirelength in the task order.
+	void runRoutingTasks(std::vector<RoutingTask> &tasks);
 	
 public:
+
+	RoutingEstimator();
+	~RoutingEstimator();
 	
 	virtual void start(const Json &params);
 	virtual void stop();
 
 	void setRoutingEstimationModel(RoutingEstimationModel *model) { routingEstimationModel = model; }
-	void setRoutingExtractionModel(RoutingExtractionModel *model) { routingExtractionModel = model; }
+	void setRoutingExtractionModel(RoutingExtractionModel *model) {
+		routingExtractionModel = model;
+		initRoutingWorkspace(clsWorkspace);
+	} // end method
 
 	virtual void
 	onPostNetCreate(Rsyn::Net net) override;
@@ -103,6 +153,9 @@ public:
 
 	virtual void
 	onPostCellRemap(Rsyn::Cell cell, Rsyn::LibraryCell oldLibraryCell) override;
+
+	virtual void
+	onPostDesignEdit(const Rsyn::DesignChangeSet &changes) override;
 	
 	virtual void
 	onPostMovedInstance(Rsyn::PhysicalInstance phInstance) override;
@@ -120,8 +173,19 @@ public:
 	} // end method
 	
 	void updateRoutingOfNet(Rsyn::Net net, const NetUpdateTypeEnum updateType);
+
+	// Fully updates the routing of several nets (e.g. the nets of the cells
+	// moved by a placement step), in parallel if possible. Each thread reuses
+	// the same memory for all its nets.
+	void updateRoutingOfNets(const std::vector<Rsyn::Net> &nets);
 	void updateRoutingFull();
 	void updateRouting();
+
+	// Sets the number of threads used to update the routing of nets. Nets are
+	// processed by decreasing degree and dynamically assigned to threads.
+	// The result is the same as in the serial update.
+	void setNumThreads(const int numThreads);
+	int getNumThreads() const { return clsNumThreads; }
 	
 	void dirtyInstance(Rsyn::Instance instance, const NetUpdateTypeEnum updateType) {
 		for (Rsyn::Pin pin : instance.allPins()) {
@@ -17,6 +17,7 @@
 #define ROUTING_EXTRACTOR_H
 
 #include <iostream>
+#include <memory>
 
 #include "rsyn/core/Rsyn.h"
 #include "rsyn/session/Service.h"
@@ -29,6 +30,16 @@
 
 namespace Rsyn {
 
+// Scratch memory that an extraction model may reuse across calls to extract()
+// to avoid allocating memory for each net. A workspace must not be shared by
+// threads running concurrently.
+class RoutingExtractionWorkspace {
+public:
+	virtual ~RoutingExtractionWorkspace() {}
+}; // end class
+
+// -----------------------------------------------------------------------------
+
 class RoutingExtractionModel {
 private:
 
@@ -42,6 +53,19 @@ public:
 	virtual void extract(const Rsyn::RoutingTopologyDescriptor<int> &topology, Rsyn::RCTree &tree) = 0;
 	virtual void updateDownstreamCap(Rsyn::RCTree &tree) = 0;
 
+	// Creates a workspace to be passed to extract(). Models that do not use
+	// workspaces return null.
+	virtual std::unique_ptr<RoutingExtractionWorkspace> createWorkspace() const { return nullptr; }
+
+	// Same as extract(), but reuses the memory of a workspace created by this
+	// model. The workspace may be null.
+	virtual void extract(const Rsyn::RoutingTopologyDescriptor<int> &topology, Rsyn::RCTree &tree,
+			RoutingExtractionWorkspace *workspace) { extract(topology, tree); }
+
+	// Returns true if extract() and updateDownstreamCap() can be called
+	// concurrently for different trees.
+	virtual bool isThreadSafe() const { return false; }
+
 	// TODO: Remove these.
 	virtual Number getLocalWireResPerUnitLength() const = 0;
 	virtual Number getLocalWireCapPerUnitLength() const = 0;
@@ -0,0 +1,119 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_ROUTING_NODE_MAP_H
+#define RSYN_ROUTING_NODE_MAP_H
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace Rsyn {
+
+// Maps node names to node indexes in routing topology and RC tree descriptors.
+// The generic version is a std::map.
+template<class NameType>
+class RoutingNodeMap {
+private:
+	std::map<NameType, int> clsMap;
+
+public:
+
+	// Removes all entries.
+	void clear() {
+		clsMap.clear();
+	} // end method
+
+	// Returns the index of a node or -1 if not found.
+	int find(const NameType &name) const {
+		typename std::map<NameType, int>::const_iterator it = clsMap.find(name);
+		return it != clsMap.end() ? it->second : -1;
+	} // end method
+
+	// Returns the index of a node. If not found, inserts the node with the
+	// given index and returns -1.
+	int insert(const NameType &name, const int index) {
+		std::pair<typename std::map<NameType, int>::iterator, bool> result =
+				clsMap.insert(std::make_pair(name, index));
+		return result.second ? -1 : result.first->second;
+	} // end method
+}; // end class
+
+// -----------------------------------------------------------------------------
+
+// Integer names are typically small (e.g. pin indexes and negative ids of
+// slicing points), so they are mapped through arrays indexed by the name,
+// one for non-negative and another for negative names. Clearing the map keeps
+// the arrays, so a map reused for several nets does not allocate memory after
+// the first few nets. Large names fall back to a std::map.
+
+template<>
+class RoutingNodeMap<int> {
+private:
+	static const int MAX_DENSE_NAME = 1 << 20;
+
+	std::vector<int> clsIndexes[2]; // [0] non-negative names, [1] negative names
+	std::vector<int> clsNames; // names stored in the arrays
+	std::map<int, int> clsMap; // large names
+
+	static int getSide(const int name) { return name < 0; }
+	static int getSlot(const int name) { return name < 0 ? -(name + 1) : name; }
+
+public:
+
+	// Removes all entries.
+	void clear() {
+		for (const int name : clsNames)
+			clsIndexes[getSide(name)][getSlot(name)] = -1;
+		clsNames.clear();
+		clsMap.clear();
+	} // end method
+
+	// Returns the index of a node or -1 if not found.
+	int find(const int name) const {
+		const int slot = getSlot(name);
+		if (slot < MAX_DENSE_NAME) {
+			const std::vector<int> &indexes = clsIndexes[getSide(name)];
+			return slot < (int) indexes.size() ? indexes[slot] : -1;
+		} else {
+			std::map<int, int>::const_iterator it = clsMap.find(name);
+			return it != clsMap.end() ? it->second : -1;
+		} // end else
+	} // end method
+
+	// Returns the index of a node. If not found, inserts the node with the
+	// given index and returns -1.
+	int insert(const int name, const int index) {
+		const int slot = getSlot(name);
+		if (slot < MAX_DENSE_NAME) {
+			std::vector<int> &indexes = clsIndexes[getSide(name)];
+			if (slot >= (int) indexes.size())
+				indexes.resize(std::max(slot + 1, 2 * (int) indexes.size()), -1);
+			if (indexes[slot] != -1)
+				return indexes[slot];
+			indexes[slot] = index;
+			clsNames.push_back(name);
+			return -1;
+		} else {
+			std::pair<std::map<int, int>::iterator, bool> result =
+					clsMap.insert(std::make_pair(name, index));
+			return result.second ? -1 : result.first->second;
+		} // end else
+	} // end method
+}; // end class
+
+} // end namespace
+
+#endif
@@ -32,6 +32,7 @@ using std::queue;
 
 #include "rsyn/util/Exception.h"
 #include "rsyn/util/dbu.h"
+#include "rsyn/model/routing/RoutingNodeMap.h"
 
 namespace Rsyn {
 
@@ -94,35 +95,49 @@ public:
 	}; // end struct
 
 private:
-	std::map<NameType, int> clsNodeMap;
+	RoutingNodeMap<NameType> clsNodeMap;
 
 	std::vector<Node> clsNodes;
 	std::vector<Segment> clsSegments;
 
+	// Segment lists of the nodes removed by clear(), which are reused by new
+	// nodes so that a descriptor reused for several nets does not allocate.
+	std::vector<std::vector<int>> clsSpareSegmentLists;
+
 public:
 
 	RoutingTopologyDescriptor() {
 		clear();
 	} // end constructor
 
+	// Removes all nodes and segments, but keeps the memory allocated to them.
 	void clear() {
+		for (Node &node : clsNodes) {
+			node.propSegments.clear();
+			clsSpareSegmentLists.push_back(std::vector<int>());
+			clsSpareSegmentLists.back().swap(node.propSegments);
+		} // end for
+
 		clsNodeMap.clear();
 		clsNodes.clear();
 		clsSegments.clear();
 	} // end method
 
 	int createNode(const NameType &name, const DBUxy pos = DBUxy(0, 0), Rsyn::Pin attachedPin = nullptr) {
-		typename std::map<NameType, int>::iterator it = clsNodeMap.find(name);
-		if (it != clsNodeMap.end()) {
-			return it->second;
+		const int index = clsNodes.size();
+		const int existing = clsNodeMap.insert(name, index);
+		if (existing != -1) {
+			return existing;
 		} else {
-			const int index = clsNodes.size();
 			clsNodes.resize(clsNodes.size() + 1);
 			clsNodes.back().propIndex = index;
 			clsNodes.back().propName = name;
 			clsNodes.back().propPosition = pos;
 			clsNodes.back().propPin = attachedPin;
-			clsNodeMap[name] = index;
+			if (!clsSpareSegmentLists.empty()) {
+				clsNodes.back().propSegments.swap(clsSpareSegmentLists.back());
+				clsSpareSegmentLists.pop_back();
+			} // end if
 			return index;
 		} // end if
 	} // end method
@@ -156,16 +171,15 @@ public:
 	}
 
 	int findNode(const NameType &name) const {
-		typename map<NameType, int>::const_iterator it = clsNodeMap.find(name);
-		return ( it != clsNodeMap.end() ? it->second : -1);
+		return clsNodeMap.find(name);
 	} // end method
 
-	int findNodeOrException(const NameType &name) {
-		typename std::map<NameType, int>::const_iterator it = clsNodeMap.find(name);
+	int findNodeOrException(const NameType &name) const {
+		const int index = clsNodeMap.find(name);
 
-		if (it == clsNodeMap.end())
+		if (index == -1)
 			throw RoutingTopologyNodeNotFoundException();
-		return it->second;
+		return index;
 	} // end method	
 
 	DBUxy getNodePosition(const NameType nodeName) const {
@@ -0,0 +1,174 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_STEINER_TOPOLOGY_CACHE_H
+#define RSYN_STEINER_TOPOLOGY_CACHE_H
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+
+#include "rsyn/util/dbu.h"
+
+namespace Rsyn {
+
+// Cache of the Steiner topologies of low-degree nets. The key is the position
+// of the pins, in the net pin order, relative to the lower-left corner of the
+// pin bounding box. Since the Steiner tree of a set of points is invariant
+// under translation, a net whose pins keep their relative positions (e.g. a
+// net whose cells were moved together or a net re-evaluated several times at
+// different positions during detailed placement) reuses the topology computed
+// for the first occurrence of that pin pattern.
+//
+// The cache is thread safe. Entries are split among shards, each protected by
+// its own mutex.
+
+class SteinerTopologyCache {
+public:
+
+	// FLUTE builds the trees of nets up to 9 pins from its look-up tables.
+	static const int MAX_DEGREE = 9;
+	static const int MAX_NODES = 2 * MAX_DEGREE - 2;
+
+	struct Key {
+		Key() {
+			propDegree = 0;
+			for (int i = 0; i < MAX_DEGREE; i++) {
+				propX[i] = 0;
+				propY[i] = 0;
+			} // end for
+		} // end constructor
+
+		int propDegree;
+		DBU propX[MAX_DEGREE];
+		DBU propY[MAX_DEGREE];
+
+		bool operator==(const Key &other) const {
+			if (propDegree != other.propDegree)
+				return false;
+			for (int i = 0; i < propDegree; i++) {
+				if (propX[i] != other.propX[i] || propY[i] != other.propY[i])
+					return false;
+			} // end for
+			return true;
+		} // end method
+
+		std::size_t getHash() const {
+			std::size_t hash = propDegree;
+			for (int i = 0; i < propDegree; i++) {
+				hash = hash * 1000003u ^ (std::size_t) propX[i];
+				hash = hash * 1000003u ^ (std::size_t) propY[i];
+			} // end for
+			hash ^= hash >> 31;
+			hash *= (std::size_t) 0x9e3779b97f4a7c15ull;
+			hash ^= hash >> 29;
+			return hash;
+		} // end method
+	}; // end struct
+
+	// A topology with positions relative to the same corner as the key.
+	struct Topology {
+		Topology() {
+			propDegree = 0;
+			propNumSegments = 0;
+			propNumPositions = 0;
+			propWirelength = 0;
+		} // end constructor
+
+		int propDegree;
+		int propNumSegments;
+		int propNumPositions;
+		DBU propWirelength;
+
+		int propSegments[MAX_NODES][2];
+		int propPositionNodes[MAX_NODES];
+		DBU propPositionX[MAX_NODES];
+		DBU propPositionY[MAX_NODES];
+		int propPinNodes[MAX_DEGREE];
+	}; // end struct
+
+	// Copies the topology associated to the key and returns true if found.
+	bool find(const Key &key, Topology &topology) {
+		Shard &shard = getShard(key);
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		auto it = shard.entries.find(key);
+		if (it == shard.entries.end()) {
+			clsNumMisses++;
+			return false;
+		} // end if
+		topology = it->second;
+		clsNumHits++;
+		return true;
+	} // end method
+
+	// Stores a topology. Shards are cleared when they get too large, so that
+	// the memory footprint is bounded.
+	void insert(const Key &key, const Topology &topology) {
+		Shard &shard = getShard(key);
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		if (shard.entries.size() >= MAX_ENTRIES_PER_SHARD)
+			shard.entries.clear();
+		shard.entries[key] = topology;
+	} // end method
+
+	void clear() {
+		for (Shard &shard : clsShards) {
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			shard.entries.clear();
+		} // end for
+		clsNumHits = 0;
+		clsNumMisses = 0;
+	} // end method
+
+	long long getNumHits() const { return clsNumHits; }
+	long long getNumMisses() const { return clsNumMisses; }
+
+	std::size_t getNumEntries() {
+		std::size_t numEntries = 0;
+		for (Shard &shard : clsShards) {
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			numEntries += shard.entries.size();
+		} // end for
+		return numEntries;
+	} // end method
+
+private:
+
+	static const int NUM_SHARDS = 16;
+	static const std::size_t MAX_ENTRIES_PER_SHARD = 1 << 16;
+
+	struct KeyHash {
+		std::size_t operator()(const Key &key) const { return key.getHash(); }
+	}; // end struct
+
+	struct Shard {
+		std::mutex mutex;
+		std::unordered_map<Key, Topology, KeyHash> entries;
+	}; // end struct
+
+	Shard clsShards[NUM_SHARDS];
+
+	std::atomic<long long> clsNumHits{0};
+	std::atomic<long long> clsNumMisses{0};
+
+	Shard &getShard(const Key &key) {
+		return clsShards[key.getHash() % NUM_SHARDS];
+	} // end method
+}; // end class
+
+} // end namespace
+
+#endif
@@ -57,6 +57,13 @@ void Scenario::init(
 	// Initialize net type tags.
 	init_NetTypeTags();
 	init_MissingLibraryCellTags();
+
+	if (Rsyn::Session::getSessionVariableAsBool("enableSnapshots", false)) {
+		clsHasDescriptors = true;
+		clsLibraryDescriptors[EARLY] = libInfosEarly;
+		clsLibraryDescriptors[LATE] = libInfosLate;
+		clsConstraintDescriptor = sdc;
+	} // end if
 } // end method
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -176,6 +183,7 @@ void Scenario::setTimingLibraryArcDelayModel(
 	const TimingTransition transition,
 	const ISPD13::LibParserLUT &lut) {
 	larc.luts[mode].delay[transition] = lut;
+	larc.luts[mode].delayTable[transition] = clsLookupTablePool.add(lut);
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -186,6 +194,7 @@ void Scenario::setTimingLibraryArcSlewModel(
 	const TimingTransition transition,
 	const ISPD13::LibParserLUT &lut) {
 	larc.luts[mode].oslew[transition] = lut;
+	larc.luts[mode].oslewTable[transition] = clsLookupTablePool.add(lut);
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -20,6 +20,7 @@
 #include "rsyn/session/Service.h"
 #include "rsyn/model/timing/types.h"
 #include "rsyn/model/timing/EdgeArray.h"
+#include "rsyn/model/timing/LookupTablePool.h"
 #include "rsyn/io/legacy/ispd13/global.h"
 
 namespace Rsyn {
@@ -54,6 +55,12 @@ public:
 		struct TimingInfo {
 			ISPD13::LibParserLUT delay[NUM_EDGE_TYPES];
 			ISPD13::LibParserLUT oslew[NUM_EDGE_TYPES];
+
+			// Handles of the compiled tables (see getLookupTablePool()).
+			int delayTable[NUM_EDGE_TYPES] = {
+				LookupTablePool::EMPTY_TABLE, LookupTablePool::EMPTY_TABLE};
+			int oslewTable[NUM_EDGE_TYPES] = {
+				LookupTablePool::EMPTY_TABLE, LookupTablePool::EMPTY_TABLE};
 		}; // end struct
 
 		TimingInfo luts[NUM_TIMING_MODES];
@@ -64,6 +71,8 @@ public:
 		TimingSense getSense() const { return sense; }
 		const ISPD13::LibParserLUT &getDelayLut(const TimingMode &mode, const EdgeType &edge) const { return luts[mode].delay[edge]; }
 		const ISPD13::LibParserLUT &getSlewLut(const TimingMode &mode, const EdgeType &edge) const { return luts[mode].oslew[edge]; }
+		int getDelayTable(const TimingMode &mode, const EdgeType &edge) const { return luts[mode].delayTable[edge]; }
+		int getSlewTable(const TimingMode &mode, const EdgeType &edge) const { return luts[mode].oslewTable[edge]; }
 	}; // end struct
 
 	class TimingLibraryPin {
@@ -140,6 +149,9 @@ private:
 	Rsyn::Attribute<Rsyn::LibraryCell, TimingLibraryCell> clsTimingLibraryCells;
 	Rsyn::Attribute<Rsyn::LibraryPin, TimingLibraryPin> clsTimingLibraryPins;
 	Rsyn::Attribute<Rsyn::LibraryArc, TimingLibraryArc> clsTimingLibraryArcs;	
+
+	// Compiled look-up tables.
+	LookupTablePool clsLookupTablePool;
 	
 public:
 
@@ -192,6 +204,9 @@ public:
 			const TimingTransition transition,
 			const ISPD13::LibParserLUT &lut);
 
+	//! @brief Returns the compiled look-up tables of the timing library arcs.
+	const LookupTablePool &getLookupTablePool() const { return clsLookupTablePool; }
+
 	inline TimingLibraryCell &getTimingLibraryCell(Rsyn::LibraryCell rsynLibraryCell) { return clsTimingLibraryCells[rsynLibraryCell]; }
 	inline const TimingLibraryCell &getTimingLibraryCell(Rsyn::LibraryCell rsynLibraryCell) const { return clsTimingLibraryCells[rsynLibraryCell]; }
 
@@ -277,6 +292,33 @@ public:
 	virtual void
 	onPrePinDisconnect(Rsyn::Pin pin) override;
 
+////////////////////////////////////////////////////////////////////////////////
+// Descriptors
+////////////////////////////////////////////////////////////////////////////////
+
+private:
+
+	// Copies of the Liberty and SDC descriptors used to initialize the
+	// scenario. They are only kept when the session variable
+	// "enableSnapshots" is true so that design snapshots can store them.
+	bool clsHasDescriptors = false;
+	ISPD13::LIBInfo clsLibraryDescriptors[NUM_TIMING_MODES];
+	ISPD13::SDCInfo clsConstraintDescriptor;
+
+public:
+
+	bool hasDescriptors() const {
+		return clsHasDescriptors;
+	} // end method
+
+	const ISPD13::LIBInfo &getLibraryDescriptor(const TimingMode mode) const {
+		return clsLibraryDescriptors[mode];
+	} // end method
+
+	const ISPD13::SDCInfo &getConstraintDescriptor() const {
+		return clsConstraintDescriptor;
+	} // end method
+
 }; // end class
 
 } // end namespace
@@ -13,9 +13,13 @@
  * limitations under the License.
  */
 
+#include <random>
+#include <cmath>
+
 #include "DefaultTimingModel.h"
 
 #include "rsyn/session/Session.h"
+#include "rsyn/util/Stopwatch.h"
 #include "rsyn/phy/PhysicalService.h"
 #include "rsyn/model/timing/Timer.h"
 
@@ -39,6 +43,23 @@ void DefaultTimingModel::start(const Json &params) {
 		phDesign = physical->getPhysicalDesign();
 		phDesign.registerObserver(this);
 	} // end if
+
+	{ // benchmarkLookupTables
+		ScriptParsing::CommandDescriptor dscp;
+		dscp.setName("benchmarkLookupTables");
+		dscp.setDescription("Measures the throughput of library look-up tables.");
+
+		dscp.addNamedParam("lookups",
+			ScriptParsing::PARAM_TYPE_INTEGER,
+			ScriptParsing::PARAM_SPEC_OPTIONAL,
+			"Number of look-ups.",
+			"1000000");
+
+		session.registerCommand(dscp, [&](const ScriptParsing::Command &command) {
+			const int numLookups = command.getParam("lookups");
+			benchmarkLookupTables(numLookups);
+		});
+	} // end block
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -55,4 +76,118 @@ void DefaultTimingModel::onPostMovedInstance(Rsyn::PhysicalInstance phInstance)
 
 // -----------------------------------------------------------------------------
 
+void DefaultTimingModel::benchmarkLookupTables(const int numLookups) {
+	struct Sample {
+		const ISPD13::LibParserLUT *delayLut;
+		const ISPD13::LibParserLUT *slewLut;
+		int delayTable;
+		int slewTable;
+		double load;
+		double slew;
+	}; // end struct
+
+	// Collect the delay and slew tables of all library arcs.
+	std::vector<Sample> tables;
+	for (Rsyn::LibraryCell lcell : clsDesign.allLibraryCells()) {
+		for (Rsyn::LibraryArc larc : lcell.allLibraryArcs()) {
+			const Scenario::TimingLibraryArc &timingLibraryArc =
+					clsScenario->getTimingLibraryArc(larc);
+			for (const TimingMode mode : clsTimer->allTimingModes()) {
+				for (const TimingTransition edge : clsTimer->allTimingTransitions()) {
+					Sample sample;
+					sample.delayLut = &timingLibraryArc.getDelayLut(mode, edge);
+					sample.slewLut = &timingLibraryArc.getSlewLut(mode, edge);
+					sample.delayTable = timingLibraryArc.getDelayTable(mode, edge);
+					sample.slewTable = timingLibraryArc.getSlewTable(mode, edge);
+					if (!sample.delayLut->loadIndices.empty() &&
+							!sample.delayLut->transitionIndices.empty() &&
+							!sample.slewLut->loadIndices.empty() &&
+							!sample.slewLut->transitionIndices.empty()) {
+						tables.push_back(sample);
+					} // end if
+				} // end for
+			} // end for
+		} // end for
+	} // end for
+
+	if (tables.empty() || numLookups <= 0) {
+		std::cout << "No look-up tables to benchmark.\n";
+		return;
+	} // end if
+
+	// Generate random look-up points including some extrapolation. A fixed
+	// seed is used so that runs are comparable.
+	std::mt19937 rng(0);
+	std::uniform_real_distribution<double> random(-0.25, 1.25);
+
+	std::vector<Sample> samples(numLookups);
+	for (int i = 0; i < numLookups; i++) {
+		Sample &sample = samples[i];
+		sample = tables[rng() % tables.size()];
+		sample.load = sample.delayLut->getMinLoad() + random(rng) *
+				(sample.delayLut->getMaxLoad() - sample.delayLut->getMinLoad());
+		sample.slew = sample.delayLut->getMinTransition() + random(rng) *
+				(sample.delayLut->getMaxTransition() - sample.delayLut->getMinTransition());
+	} // end for
+
+	const LookupTablePool &pool = clsScenario->getLookupTablePool();
+
+	std::vector<double> reference(2 * numLookups);
+	std::vector<double> compiled(2 * numLookups);
+	std::vector<double> batched(2 * numLookups);
+
+	Stopwatch watchReference;
+	watchReference.start();
+	for (int i = 0; i < numLookups; i++) {
+		const Sample &sample = samples[i];
+		reference[2*i + 0] = LookupTablePool::lookupReference(*sample.delayLut, sample.load, sample.slew);
+		reference[2*i + 1] = LookupTablePool::lookupReference(*sample.slewLut, sample.load, sample.slew);
+	} // end for
+	watchReference.stop();
+
+	Stopwatch watchCompiled;
+	watchCompiled.start();
+	for (int i = 0; i < numLookups; i++) {
+		const Sample &sample = samples[i];
+		compiled[2*i + 0] = pool.lookup(sample.delayTable, sample.load, sample.slew);
+		compiled[2*i + 1] = pool.lookup(sample.slewTable, sample.load, sample.slew);
+	} // end for
+	watchCompiled.stop();
+
+	Stopwatch watchBatched;
+	watchBatched.start();
+	for (int i = 0; i < numLookups; i++) {
+		const Sample &sample = samples[i];
+		pool.lookup(sample.delayTable, sample.slewTable, sample.load, sample.slew,
+				batched[2*i + 0], batched[2*i + 1]);
+	} // end for
+	watchBatched.stop();
+
+	// Check results. Note that results must be exactly the same.
+	int numMismatches = 0;
+	for (int i = 0; i < 2 * numLookups; i++) {
+		const double r = reference[i];
+		if (!(compiled[i] == r || (std::isnan(compiled[i]) && std::isnan(r))) ||
+				!(batched[i] == r || (std::isnan(batched[i]) && std::isnan(r)))) {
+			numMismatches++;
+		} // end if
+	} // end for
+
+	auto report = [&](const std::string &name, const Stopwatch &watch) {
+		const double seconds = watch.getElapsedTime();
+		std::cout << std::setw(12) << name << ": "
+				<< std::setw(12) << (seconds > 0? (2 * numLookups) / seconds : 0)
+				<< " lookups/s (" << seconds << " s)\n";
+	}; // end lambda
+
+	std::cout << "Look-up tables: " << pool.getNumTables() << " ("
+			<< pool.getMemoryUsage() << " bytes)\n";
+	report("reference", watchReference);
+	report("compiled", watchCompiled);
+	report("batched", watchBatched);
+	std::cout << "Mismatches: " << numMismatches << "\n";
+} // end method
+
+// -----------------------------------------------------------------------------
+
 } // end namespace
\ No newline at end of file
@@ -44,91 +44,9 @@ private:
 	Scenario * clsScenario = nullptr;
 	Timer * clsTimer = nullptr;
 	
-	// Look-up table.
-	double lookup(const ISPD13::LibParserLUT &lut, const double x, const double y) const {
-		const bool tweak = false;
-
-		double weightX, weightY;
-		double xLower, xUpper, yLower, yUpper;
-		int xLowerIndex, xUpperIndex, yLowerIndex, yUpperIndex, xLimit, yLimit;
-
-		// If the table is empty issue a warning and return 0. Something isn t
-		// right.
-		if (lut.loadIndices.empty() || lut.transitionIndices.empty()) {
-			std::cout <<  "WARNING: Empty look-up table. Prepare for things going wrong...\n";
-			return 0;
-		} // end if		
-
-		// We store the scalar delay/slew in a 1x1 lookup. 
-		if (lut.loadIndices.size() == 1 && lut.transitionIndices.size() == 1) {
-			return lut.tableVals[0][0];
-		} // end if
-
-		// If the input slew is uninitialized, return uninitialized value.
-		if (std::abs(y) == UNINITVALUE) {
-			return y;
-		} // end if
-
-		// Find x, y indices.
-		xLowerIndex = xUpperIndex = yLowerIndex = yUpperIndex = 0;
-		xLimit = lut.loadIndices.size() - 2;
-		yLimit = lut.transitionIndices.size() - 2;
-
-		while ((xLowerIndex < xLimit) && (lut.loadIndices[xLowerIndex + 1] <= x)) 
-			++xLowerIndex;
-		xUpperIndex = xLowerIndex + 1;
-
-		while ((yLowerIndex < yLimit) && (lut.transitionIndices[yLowerIndex + 1] <= y))
-			++yLowerIndex;
-		yUpperIndex = yLowerIndex + 1;
-
-		xLower = lut.loadIndices[xLowerIndex];
-		xUpper = lut.loadIndices[xUpperIndex];
-		yLower = lut.transitionIndices[yLowerIndex];
-		yUpper = lut.transitionIndices[yUpperIndex];
-
-		// Truncate values an warn the user if necessary.
-		double truncx = x;
-		double truncy = y;
-
-		if (tweak) {
-			if (x < xLower) {
-				truncx = xLower;
-				std::cout << "WARNING: Underflow in x-dimension of lookup table (" << x
-						<< " < " << xLower << "). Truncating...\n";
-			} else if (x > xUpper) {
-				truncx = xUpper;
-				std::cout << "WARNING: Overflow in x-dimension lookup table (" << x
-						<< " > " << xUpper << "). Truncating...\n";
-			} else {
-				truncx = x;
-			} // end else
-
-			if (y < yLower) {
-				truncy = yLower;
-				std::cout << "WARNING: Underflow in y-dimension of lookup table (" << y
-						<< " < " << yLower << "). Truncating...\n";
-			} else if (y > yUpper) {
-				truncy = yUpper;
-				std::cout << "WARNING: Overflow in y-dimension lookup table (" << y
-						<< " > " << yUpper << "). Truncating...\n";
-			} else {
-				truncy = y;
-			} // end else
-		} // end else
-
-		// Interpolate.
-		weightX = (truncx - xLower) / (xUpper - xLower);
-		weightY = (truncy - yLower) / (yUpper - yLower);		
-
-		double result;
-		result = (1.0 - weightX)*(1.0 - weightY)*(lut.tableVals[xLowerIndex][yLowerIndex]);
-		result += (weightX)*(1.0 - weightY)*(lut.tableVals[xUpperIndex][yLowerIndex]);
-		result += (1.0 - weightX)*(weightY)*(lut.tableVals[xLowerIndex][yUpperIndex]);
-		result += (weightX)*(weightY)*(lut.tableVals[xUpperIndex][yUpperIndex]);
-
-		return result;
-	} // end method
+	// Benchmarks the compiled look-up tables against the reference
+	// implementation. Also checks that both produce the same results.
+	void benchmarkLookupTables(const int numLookups);
 
 	EdgeArray<Number> computeNetPinLoad(Rsyn::Net net) {
 		Number load = 0;
@@ -203,8 +121,14 @@ public:
 	Number &slew) {
 		const Scenario::TimingLibraryArc &timingLibraryArc =
 				clsScenario->getTimingLibraryArc(larc);
-		delay = (Number) lookup(timingLibraryArc.getDelayLut(mode, oedge), load, islew);
-		slew  = (Number) lookup(timingLibraryArc.getSlewLut (mode, oedge), load, islew);
+		double delayValue;
+		double slewValue;
+		clsScenario->getLookupTablePool().lookup(
+				timingLibraryArc.getDelayTable(mode, oedge),
+				timingLibraryArc.getSlewTable (mode, oedge),
+				load, islew, delayValue, slewValue);
+		delay = (Number) delayValue;
+		slew  = (Number) slewValue;
 	} // end method
 
 	virtual
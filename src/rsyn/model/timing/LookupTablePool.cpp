@@ -0,0 +1,179 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LookupTablePool.h"
+
+namespace Rsyn {
+
+const int LookupTablePool::EMPTY_TABLE;
+const int LookupTablePool::ALIGNMENT;
+
+// -----------------------------------------------------------------------------
+
+int LookupTablePool::add(const ISPD13::LibParserLUT &lut) {
+	const int numX = (int) lut.loadIndices.size();
+	const int numY = (int) lut.transitionIndices.size();
+
+	// Check if the table values match the indices.
+	bool valid = (int) lut.tableVals.size() == numX;
+	for (int i = 0; valid && i < numX; i++) {
+		valid = (int) lut.tableVals[i].size() == numY;
+	} // end for
+
+	// Check if the indices are sorted as assumed by the index search.
+	const bool sorted =
+			std::is_sorted(lut.loadIndices.begin(), lut.loadIndices.end()) &&
+			std::is_sorted(lut.transitionIndices.begin(), lut.transitionIndices.end());
+
+	Table table;
+	table.numX = numX;
+	table.numY = numY;
+
+	if (numX == 0 || numY == 0) {
+		table.type = TABLE_EMPTY;
+	} else if (numX == 1 && numY == 1 && valid) {
+		table.type = TABLE_SCALAR;
+		table.values = addValues(1);
+		clsData[table.values] = lut.tableVals[0][0];
+	} else if (numX > 1 && numY > 1 && valid && sorted) {
+		table.type = TABLE_BILINEAR;
+		table.axisX = addAxis(lut.loadIndices);
+		table.axisY = addAxis(lut.transitionIndices);
+		table.values = addValues(numX * numY);
+		for (int i = 0; i < numX; i++) {
+			std::copy(lut.tableVals[i].begin(), lut.tableVals[i].end(),
+					clsData.begin() + table.values + i*numY);
+		} // end for
+	} else {
+		table.type = TABLE_REFERENCE;
+		table.values = (int) clsReferenceTables.size();
+		clsReferenceTables.push_back(lut);
+	} // end else
+
+	clsTables.push_back(table);
+	return (int) clsTables.size() - 1;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+int LookupTablePool::addAxis(const std::vector<double> &axis) {
+	auto it = clsAxes.find(axis);
+	if (it != clsAxes.end()) {
+		return it->second;
+	} // end if
+
+	const int offset = addValues((int) axis.size());
+	std::copy(axis.begin(), axis.end(), clsData.begin() + offset);
+	clsAxes[axis] = offset;
+	return offset;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+int LookupTablePool::addValues(const int size) {
+	const int offset =
+			(((int) clsData.size() + ALIGNMENT - 1) / ALIGNMENT) * ALIGNMENT;
+	clsData.resize(offset + size, 0.0);
+	return offset;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+double LookupTablePool::lookupReference(const ISPD13::LibParserLUT &lut, const double x, const double y) {
+	const bool tweak = false;
+
+	double weightX, weightY;
+	double xLower, xUpper, yLower, yUpper;
+	int xLowerIndex, xUpperIndex, yLowerIndex, yUpperIndex, xLimit, yLimit;
+
+	// If the table is empty issue a warning and return 0. Something isn t
+	// right.
+	if (lut.loadIndices.empty() || lut.transitionIndices.empty()) {
+		std::cout <<  "WARNING: Empty look-up table. Prepare for things going wrong...\n";
+		return 0;
+	} // end if
+
+	// We store the scalar delay/slew in a 1x1 lookup.
+	if (lut.loadIndices.size() == 1 && lut.transitionIndices.size() == 1) {
+		return lut.tableVals[0][0];
+	} // end if
+
+	// If the input slew is uninitialized, return uninitialized value.
+	if (std::abs(y) == UNINITVALUE) {
+		return y;
+	} // end if
+
+	// Find x, y indices.
+	xLowerIndex = xUpperIndex = yLowerIndex = yUpperIndex = 0;
+	xLimit = lut.loadIndices.size() - 2;
+	yLimit = lut.transitionIndices.size() - 2;
+
+	while ((xLowerIndex < xLimit) && (lut.loadIndices[xLowerIndex + 1] <= x))
+		++xLowerIndex;
+	xUpperIndex = xLowerIndex + 1;
+
+	while ((yLowerIndex < yLimit) && (lut.transitionIndices[yLowerIndex + 1] <= y))
+		++yLowerIndex;
+	yUpperIndex = yLowerIndex + 1;
+
+	xLower = lut.loadIndices[xLowerIndex];
+	xUpper = lut.loadIndices[xUpperIndex];
+	yLower = lut.transitionIndices[yLowerIndex];
+	yUpper = lut.transitionIndices[yUpperIndex];
+
+	// Truncate values an warn the user if necessary.
+	double truncx = x;
+	double truncy = y;
+
+	if (tweak) {
+		if (x < xLower) {
+			truncx = xLower;
+			std::cout << "WARNING: Underflow in x-dimension of lookup table (" << x
+					<< " < " << xLower << "). Truncating...\n";
+		} else if (x > xUpper) {
+			truncx = xUpper;
+			std::cout << "WARNING: Overflow in x-dimension lookup table (" << x
+					<< " > " << xUpper << "). Truncating...\n";
+		} else {
+			truncx = x;
+		} // end else
+
+		if (y < yLower) {
+			truncy = yLower;
+			std::cout << "WARNING: Underflow in y-dimension of lookup table (" << y
+					<< " < " << yLower << "). Truncating...\n";
+		} else if (y > yUpper) {
+			truncy = yUpper;
+			std::cout << "WARNING: Overflow in y-dimension lookup table (" << y
+					<< " > " << yUpper << "). Truncating...\n";
+		} else {
+			truncy = y;
+		} // end else
+	} // end else
+
+	// Interpolate.
+	weightX = (truncx - xLower) / (xUpper - xLower);
+	weightY = (truncy - yLower) / (yUpper - yLower);
+
+	double result;
+	result = (1.0 - weightX)*(1.0 - weightY)*(lut.tableVals[xLowerIndex][yLowerIndex]);
+	result += (weightX)*(1.0 - weightY)*(lut.tableVals[xUpperIndex][yLowerIndex]);
+	result += (1.0 - weightX)*(weightY)*(lut.tableVals[xLowerIndex][yUpperIndex]);
+	result += (weightX)*(weightY)*(lut.tableVals[xUpperIndex][yUpperIndex]);
+
+	return result;
+} // end method
+
+} // end namespace
@@ -0,0 +1,227 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_LOOKUP_TABLE_POOL_H
+#define RSYN_LOOKUP_TABLE_POOL_H
+
+#include <map>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+
+#include "rsyn/io/legacy/ispd13/global.h"
+#include "rsyn/model/timing/types.h"
+
+namespace Rsyn {
+
+// Stores library look-up tables (e.g. delay and slew) in a single contiguous
+// buffer. Tables are compiled once when the library is loaded. Breakpoints
+// (indices) are shared among tables with the same indices, which is the common
+// case for delay and slew tables of a same arc, so that the index search can
+// be done once for several tables.
+//
+// Lookups return exactly the same values as the reference bilinear
+// interpolation (see lookupReference()).
+
+class LookupTablePool {
+public:
+
+	//! @brief Handle of an empty table, which is always present in the pool.
+	static const int EMPTY_TABLE = 0;
+
+	LookupTablePool() { add(ISPD13::LibParserLUT()); }
+
+	//! @brief Compiles a look-up table and returns its handle.
+	int add(const ISPD13::LibParserLUT &lut);
+
+	//! @brief Returns the number of tables in this pool.
+	int getNumTables() const { return (int) clsTables.size(); }
+
+	//! @brief Returns the memory used by the compiled tables in bytes.
+	std::size_t getMemoryUsage() const { return clsData.size() * sizeof(double); }
+
+	//! @brief Evaluates the table at (x, y) where x is the load and y the
+	//!        input slew.
+	double lookup(const int table, const double x, const double y) const {
+		const Table &lut = clsTables[table];
+		switch (lut.type) {
+			case TABLE_BILINEAR: {
+				Weights weights;
+				computeWeights(lut, x, y, weights);
+				return weights.uninitialized? y : interpolate(lut, weights);
+			} // end case
+
+			case TABLE_SCALAR:
+				return clsData[lut.values];
+
+			case TABLE_EMPTY:
+				std::cout << "WARNING: Empty look-up table. Prepare for things going wrong...\n";
+				return 0;
+
+			default:
+				return lookupReference(clsReferenceTables[lut.values], x, y);
+		} // end switch
+	} // end method
+
+	//! @brief Evaluates two tables at (x, y). When the tables share the same
+	//!        indices, which is the common case for delay and slew tables of
+	//!        an arc and for rise and fall tables, the index search and
+	//!        interpolation weights are computed only once.
+	void lookup(const int table0, const int table1,
+			const double x, const double y,
+			double &result0, double &result1) const {
+		const Table &lut0 = clsTables[table0];
+		const Table &lut1 = clsTables[table1];
+		if (lut0.type == TABLE_BILINEAR && lut1.type == TABLE_BILINEAR &&
+				lut0.axisX == lut1.axisX && lut0.axisY == lut1.axisY) {
+			Weights weights;
+			computeWeights(lut0, x, y, weights);
+			if (weights.uninitialized) {
+				result0 = y;
+				result1 = y;
+			} else {
+				const double * values0 = &clsData[lut0.values];
+				const double * values1 = &clsData[lut1.values];
+				double result[2] = {
+					weights.w[0] * values0[weights.index[0]],
+					weights.w[0] * values1[weights.index[0]]
+				};
+				for (int k = 1; k < 4; k++) {
+					result[0] += weights.w[k] * values0[weights.index[k]];
+					result[1] += weights.w[k] * values1[weights.index[k]];
+				} // end for
+				result0 = result[0];
+				result1 = result[1];
+			} // end else
+		} else {
+			result0 = lookup(table0, x, y);
+			result1 = lookup(table1, x, y);
+		} // end else
+	} // end method
+
+	//! @brief Reference implementation of the table look-up, which operates
+	//!        directly on the parsed look-up table.
+	static double lookupReference(const ISPD13::LibParserLUT &lut, const double x, const double y);
+
+private:
+
+	enum TableType {
+		TABLE_EMPTY,
+		TABLE_SCALAR,
+		TABLE_BILINEAR,
+
+		// Tables not suitable for compilation (e.g. unsorted indices). The
+		// reference look-up is used.
+		TABLE_REFERENCE
+	}; // end enum
+
+	struct Table {
+		TableType type = TABLE_EMPTY;
+
+		// Offsets in the data buffer.
+		int axisX = -1;
+		int axisY = -1;
+		int values = -1; // or index of the reference table
+
+		int numX = 0;
+		int numY = 0;
+	}; // end struct
+
+	struct Weights {
+		bool uninitialized;
+		int index[4];
+		double w[4];
+	}; // end struct
+
+	// Tables and indices are padded to this number of doubles (a cache line).
+	static const int ALIGNMENT = 8;
+
+	std::vector<Table> clsTables;
+	std::vector<double> clsData;
+	std::vector<ISPD13::LibParserLUT> clsReferenceTables;
+	std::map<std::vector<double>, int> clsAxes;
+
+	int addAxis(const std::vector<double> &axis);
+	int addValues(const int size);
+
+	// Returns the lower index as the reference implementation does, i.e. the
+	// number of breakpoints in [1, n-2] not greater than the value. Requires
+	// non-decreasing breakpoints.
+	static int findLowerIndex(const double * axis, const int n, const double value) {
+		const int limit = n - 2;
+		if (n <= 16) {
+			// Branchless scan for the usual small tables.
+			int lower = 0;
+			for (int i = 1; i <= limit; i++) {
+				lower += axis[i] <= value;
+			} // end for
+			return lower;
+		} else {
+			return (int) (std::upper_bound(axis + 1, axis + 1 + limit, value) - (axis + 1));
+		} // end else
+	} // end method
+
+	// Computes the interpolation weights following the same floating-point
+	// operations as the reference implementation.
+	void computeWeights(const Table &lut, const double x, const double y, Weights &weights) const {
+		// If the input slew is uninitialized, return uninitialized value.
+		weights.uninitialized = std::abs(y) == UNINITVALUE;
+		if (weights.uninitialized) {
+			return;
+		} // end if
+
+		const double * axisX = &clsData[lut.axisX];
+		const double * axisY = &clsData[lut.axisY];
+
+		const int xLowerIndex = findLowerIndex(axisX, lut.numX, x);
+		const int yLowerIndex = findLowerIndex(axisY, lut.numY, y);
+		const int xUpperIndex = xLowerIndex + 1;
+		const int yUpperIndex = yLowerIndex + 1;
+
+		const double xLower = axisX[xLowerIndex];
+		const double xUpper = axisX[xUpperIndex];
+		const double yLower = axisY[yLowerIndex];
+		const double yUpper = axisY[yUpperIndex];
+
+		const double weightX = (x - xLower) / (xUpper - xLower);
+		const double weightY = (y - yLower) / (yUpper - yLower);
+
+		weights.w[0] = (1.0 - weightX)*(1.0 - weightY);
+		weights.w[1] = (weightX)*(1.0 - weightY);
+		weights.w[2] = (1.0 - weightX)*(weightY);
+		weights.w[3] = (weightX)*(weightY);
+
+		weights.index[0] = xLowerIndex*lut.numY + yLowerIndex;
+		weights.index[1] = xUpperIndex*lut.numY + yLowerIndex;
+		weights.index[2] = xLowerIndex*lut.numY + yUpperIndex;
+		weights.index[3] = xUpperIndex*lut.numY + yUpperIndex;
+	} // end method
+
+	// Note: The terms are summed in the same order as in the reference
+	// implementation to get the same rounding.
+	double interpolate(const Table &lut, const Weights &weights) const {
+		const double * values = &clsData[lut.values];
+		double result = weights.w[0] * values[weights.index[0]];
+		for (int k = 1; k < 4; k++) {
+			result += weights.w[k] * values[weights.index[k]];
+		} // end for
+		return result;
+	} // end method
+
+}; // end class
+
+} // end namespace
+
+#endif
@@ -15,8 +15,11 @@
  
 #include <queue>
 #include <vector>
+#include <mutex>
 #include <limits> 
 #include <iomanip> 
+#include <random>
+#include <sstream>
 
 #include "rsyn/session/Session.h"
 #include "rsyn/model/scenario/Scenario.h"
@@ -24,6 +27,7 @@
 #include "rsyn/model/timing/Timer.h"
 #include "rsyn/util/FloatingPoint.h"
 #include "rsyn/util/ThreadPool.h"
+#include "rsyn/util/Stopwatch.h"
 #include "rsyn/util/MD5.h"
 
 #define TIMER_DEBUG_PRUNING 0
@@ -44,6 +48,8 @@ const Number DEFAULT_UNINIT_VALUE[NUM_TIMING_MODES] = {
 const bool Timer::ENABLE_IITIMER_COMPATIBILITY_MODE = false;
 const bool Timer::ENABLE_UITIMER_COMPATIBILITY_MODE = true;
 
+const int Timer::PARALLEL_MIN_NETS_PER_TASK = 32;
+
 // -----------------------------------------------------------------------------	
 
 // [TODO] Use functors, not lambda.
@@ -105,6 +111,9 @@ Timer::TM_MODE_WORST_REQUIRED[NUM_TIMING_MODES] = {
 void Timer::start(const Json &params) {
 	Rsyn::Session session;
 
+	setNumThreads(params.value("numThreads", clsNumThreads));
+	setTimingStateStoreEnabled(params.value("timingStateStore", clsEnableTimingStateStore));
+
 	{ // updateTiming
 		ScriptParsing::CommandDescriptor dscp;
 		dscp.setName("updateTiming");
@@ -115,9 +124,18 @@ void Timer::start(const Json &params) {
 			ScriptParsing::PARAM_SPEC_OPTIONAL,
 			"Determines whether a full timing update is performed.",
 			"false");
+
+		dscp.addNamedParam("numThreads",
+			ScriptParsing::PARAM_TYPE_INTEGER,
+			ScriptParsing::PARAM_SPEC_OPTIONAL,
+			"Number of threads used in full timing updates (0 keeps the current setting).",
+			"0");
 		
 		session.registerCommand(dscp, [&](const ScriptParsing::Command &command) {
 			const bool full = command.getParam("full");
+			const int numThreads = command.getParam("numThreads");
+
+			if (numThreads > 0) setNumThreads(numThreads);
 
 			if (full) updateTimingFull();
 			else updateTimingIncremental();
@@ -126,6 +144,260 @@ void Timer::start(const Json &params) {
 		msgUnusualArcSense = session.getMessage("TIMER-001");
 		msgUnusualArcType = session.getMessage("TIMER-002");
 	} // end block
+
+	{ // benchmarkNetlistSnapshot
+		ScriptParsing::CommandDescriptor dscp;
+		dscp.setName("benchmarkNetlistSnapshot");
+		dscp.setDescription("Measures the throughput of netlist traversals.");
+
+		dscp.addNamedParam("iterations",
+			ScriptParsing::PARAM_TYPE_INTEGER,
+			ScriptParsing::PARAM_SPEC_OPTIONAL,
+			"Number of traversals.",
+			"10");
+
+		session.registerCommand(dscp, [&](const ScriptParsing::Command &command) {
+			const int numIterations = command.getParam("iterations");
+			benchmarkNetlistSnapshot(numIterations);
+		});
+	} // end block
+
+	{ // checkIncrementalTiming
+		ScriptParsing::CommandDescriptor dscp;
+		dscp.setName("checkIncrementalTiming");
+		dscp.setDescription("Checks that incremental timing updates match a full timing update after random cell remaps.");
+
+		dscp.addNamedParam("numSteps",
+			ScriptParsing::PARAM_TYPE_INTEGER,
+			ScriptParsing::PARAM_SPEC_OPTIONAL,
+			"Number of remaps.",
+			"1000");
+
+		dscp.addNamedParam("seed",
+			ScriptParsing::PARAM_TYPE_INTEGER,
+			ScriptParsing::PARAM_SPEC_OPTIONAL,
+			"Seed of the random number generator.",
+			"0");
+
+		dscp.addNamedParam("tolerance",
+			ScriptParsing::PARAM_TYPE_NUMBER,
+			ScriptParsing::PARAM_SPEC_OPTIONAL,
+			"Maximum absolute difference between incremental and full timing.",
+			"1e-3");
+
+		session.registerCommand(dscp, [&](const ScriptParsing::Command &command) {
+			const int numSteps = command.getParam("numSteps");
+			const int seed = command.getParam("seed");
+			const float tolerance = command.getParam("tolerance");
+			checkIncrementalTiming(numSteps, (unsigned) seed, tolerance);
+		});
+	} // end block
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Timer::benchmarkNetlistSnapshot(const int numIterations) {
+	// Each traversal visits the nets in topological order and, for each pin,
+	// the pins reached by its outgoing arcs, which is the access pattern of
+	// the timing propagation. A checksum is computed so that the traversals
+	// are not optimized away and can be compared.
+	const Index invalid = Rsyn::NetlistSnapshot::INVALID_INDEX;
+
+	Stopwatch watchBuild;
+	watchBuild.start();
+	std::shared_ptr<const Rsyn::NetlistSnapshot> snapshot =
+			design.getNetlistSnapshot();
+	watchBuild.stop();
+
+	std::size_t checksumObjects = 0;
+	std::size_t numVisits = 0;
+	Stopwatch watchObjects;
+	watchObjects.start();
+	for (int i = 0; i < numIterations; i++) {
+		for (Rsyn::Net net : module.allNetsInTopologicalOrder()) {
+			for (Rsyn::Pin pin : net.allPins()) {
+				for (Rsyn::Arc arc : pin.allOutgoingArcs()) {
+					Rsyn::Net toNet = arc.getToNet();
+					checksumObjects += toNet? snapshot->getNetIndex(toNet) : 1;
+					numVisits++;
+				} // end for
+			} // end for
+		} // end for
+	} // end for
+	watchObjects.stop();
+
+	std::size_t checksumSnapshot = 0;
+	Stopwatch watchSnapshot;
+	watchSnapshot.start();
+	for (int i = 0; i < numIterations; i++) {
+		for (Rsyn::Net net : snapshot->allNetsInTopologicalOrder()) {
+			for (const Index pin : snapshot->getNetPins(snapshot->getNetIndex(net))) {
+				for (const Index to : snapshot->getFanoutPins(pin)) {
+					const Index toNet = snapshot->getPinNet(to);
+					checksumSnapshot += toNet != invalid? toNet : 1;
+				} // end for
+			} // end for
+		} // end for
+	} // end for
+	watchSnapshot.stop();
+
+	auto report = [&](const std::string &name, const Stopwatch &watch) {
+		const double seconds = watch.getElapsedTime();
+		std::cout << std::setw(12) << name << ": "
+				<< std::setw(12) << (seconds > 0? numVisits / seconds : 0)
+				<< " arcs/s (" << seconds << " s)\n";
+	}; // end lambda
+
+	std::cout << "Netlist snapshot: "
+			<< snapshot->getNumPinRows() << " pins, "
+			<< snapshot->getNumNetRows() << " nets ("
+			<< snapshot->getMemoryUsage() << " bytes, built in "
+			<< watchBuild.getElapsedTime() << " s)\n";
+	report("objects", watchObjects);
+	report("snapshot", watchSnapshot);
+	std::cout << "Checksums match: "
+			<< (checksumObjects == checksumSnapshot? "yes" : "no") << "\n";
+} // end method
+
+// -----------------------------------------------------------------------------
+
+int Timer::checkIncrementalTiming(const int numSteps, const unsigned seed,
+		const Number tolerance) {
+	// Group library cells that can be remapped to each other, i.e. cells with
+	// the same pins and arcs.
+	std::map<std::string, std::vector<Rsyn::LibraryCell>> groups;
+	std::map<Rsyn::LibraryCell, const std::vector<Rsyn::LibraryCell> *> groupOfLibraryCell;
+	for (Rsyn::LibraryCell libraryCell : design.allLibraryCells()) {
+		std::set<std::string> names;
+		for (Rsyn::LibraryPin libraryPin : libraryCell.allLibraryPins())
+			names.insert(libraryPin.getName());
+		for (Rsyn::LibraryArc libraryArc : libraryCell.allLibraryArcs())
+			names.insert(libraryArc.getFromName() + "->" + libraryArc.getToName());
+
+		std::ostringstream key;
+		for (const std::string &name : names)
+			key << name << ";";
+		groups[key.str()].push_back(libraryCell);
+	} // end for
+	for (const std::pair<const std::string, std::vector<Rsyn::LibraryCell>> &group : groups) {
+		for (Rsyn::LibraryCell libraryCell : group.second)
+			groupOfLibraryCell[libraryCell] = &group.second;
+	} // end for
+
+	// Sequential cells are skipped so that the set of endpoints does not
+	// change.
+	std::vector<Rsyn::Cell> cells;
+	for (Rsyn::Instance instance : module.allInstances()) {
+		if (instance.getType() != Rsyn::CELL)
+			continue;
+		Rsyn::Cell cell = instance.asCell();
+		const std::vector<Rsyn::LibraryCell> *group =
+				groupOfLibraryCell[cell.getLibraryCell()];
+		if (sequentialCells.count(cell) || !group || group->size() < 2)
+			continue;
+		cells.push_back(cell);
+	} // end for
+	if (cells.empty()) {
+		std::cout << "[ERROR] The design has no cells that can be remapped.\n";
+		return -1;
+	} // end if
+
+	std::mt19937 rng(seed);
+	auto random = [&](const int max) {
+		return std::uniform_int_distribution<int>(0, max)(rng);
+	}; // end lambda
+
+	updateTimingFull();
+
+	// Edits are checked in batches. Every other batch is done inside an edit
+	// transaction.
+	const int batchSize = 100;
+	int numRemaps = 0;
+	int numChecks = 0;
+	int numMismatches = 0;
+	Number maxError = 0;
+	std::vector<Number> slacks;
+	for (int step = 0; step < numSteps; ) {
+		const bool transaction = (step / batchSize) % 2 == 1;
+		const int last = std::min(numSteps, step + batchSize);
+		if (transaction)
+			design.beginEdit();
+		for (; step < last; step++) {
+			Rsyn::Cell cell = cells[random((int) cells.size() - 1)];
+			const std::vector<Rsyn::LibraryCell> &group =
+					*groupOfLibraryCell[cell.getLibraryCell()];
+			try {
+				cell.remap(group[random((int) group.size() - 1)]);
+				numRemaps++;
+			} catch (const IncompatibleLibraryCellForRemapping &) {
+			} // end try-catch
+		} // end for
+		if (transaction)
+			design.commitEdit();
+
+		// Compare against a full update.
+		updateTimingIncremental();
+		const int numStoreMismatches = countTimingStateStoreMismatches();
+		slacks.clear();
+		for (Rsyn::Pin endpoint : endpoints) {
+			for (const TimingMode mode : allTimingModes())
+				slacks.push_back(getPinWorstSlack(endpoint, mode));
+		} // end for
+		Number wns[NUM_TIMING_MODES];
+		Number tns[NUM_TIMING_MODES];
+		for (const TimingMode mode : allTimingModes()) {
+			wns[mode] = getWns(mode);
+			tns[mode] = getTns(mode);
+		} // end for
+
+		updateTimingFull();
+		int numSlackMismatches = 0;
+		int index = 0;
+		for (Rsyn::Pin endpoint : endpoints) {
+			for (const TimingMode mode : allTimingModes()) {
+				const Number error = std::abs(slacks[index++] - getPinWorstSlack(endpoint, mode));
+				maxError = std::max(maxError, error);
+				if (error > tolerance)
+					numSlackMismatches++;
+			} // end for
+		} // end for
+		bool summaryMismatch = false;
+		for (const TimingMode mode : allTimingModes()) {
+			if (std::abs(wns[mode] - getWns(mode)) > tolerance ||
+					std::abs(tns[mode] - getTns(mode)) > tolerance)
+				summaryMismatch = true;
+		} // end for
+
+		if (numStoreMismatches) {
+			if (numMismatches < 10) {
+				std::cout << "[ERROR] Timing state store mismatch after "
+						<< step << " edits: " << numStoreMismatches
+						<< " pin(s) differ from the timing pins.\n";
+			} // end if
+			numMismatches++;
+		} // end if
+
+		if (numSlackMismatches || summaryMismatch) {
+			if (numMismatches < 10) {
+				std::cout << "[ERROR] Incremental timing mismatch after "
+						<< step << " edits: " << numSlackMismatches
+						<< " endpoint slack(s), WNS "
+						<< wns[LATE] << " (incremental) " << getWns(LATE)
+						<< " (full), TNS "
+						<< tns[LATE] << " (incremental) " << getTns(LATE)
+						<< " (full).\n";
+			} // end if
+			numMismatches++;
+		} // end if
+		numChecks++;
+	} // end for
+
+	std::cout << "Remaps: " << numRemaps << "\n";
+	std::cout << "Checks: " << numChecks << "\n";
+	std::cout << "Mismatches: " << numMismatches << "\n";
+	std::cout << "Max slack error: " << maxError << "\n";
+
+	return numMismatches;
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -136,6 +408,7 @@ void Timer::stop() {
 // -----------------------------------------------------------------------------
 
 void Timer::onPostInstanceCreate(Rsyn::Instance instance) {
+	clsNetLevelsDirty = true;
 	if (instance.getType() == Rsyn::CELL) {
 		initializeTimingCell(instance.asCell());
 		dirtyInstance(instance);
@@ -146,14 +419,62 @@ void Timer::onPostInstanceCreate(Rsyn::Instance instance) {
 
 // -----------------------------------------------------------------------------
 
+void Timer::onPreInstanceRemove(Rsyn::Instance instance) {
+	clsNetLevelsDirty = true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Timer::onPostNetCreate(Rsyn::Net net) {
+	clsNetLevelsDirty = true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Timer::onPreNetRemove(Rsyn::Net net) {
+	clsNetLevelsDirty = true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
 void Timer::onPostCellRemap(Rsyn::Cell cell, Rsyn::LibraryCell oldLibraryCell) {
 	//std::cout << "INFO: Timer was notified about a remap.\n";
+	// Note: Remapping keeps the pins and arcs of the cell, so net levels are
+	// still valid.
 	initializeTimingCell(cell);
 	dirtyInstance(cell);
 } // end method
 
 // -----------------------------------------------------------------------------
 
+void Timer::onPostPinConnect(Rsyn::Pin pin) {
+	clsNetLevelsDirty = true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Timer::onPrePinDisconnect(Rsyn::Pin pin) {
+	clsNetLevelsDirty = true;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Timer::onPostDesignEdit(const Rsyn::DesignChangeSet &changes) {
+	for (Rsyn::Instance instance : changes.createdInstances) {
+		onPostInstanceCreate(instance);
+	} // end for
+
+	for (const std::tuple<Rsyn::Cell, Rsyn::LibraryCell> &remap : changes.remappedCells) {
+		onPostCellRemap(std::get<0>(remap), std::get<1>(remap));
+	} // end for
+
+	if (!changes.createdNets.empty() || !changes.reconnectedPins.empty()) {
+		clsNetLevelsDirty = true;
+	} // end if
+} // end method
+
+// -----------------------------------------------------------------------------
+
 bool Timer::isUnusualTimingArc(const ISPD13::LibParserTimingInfo &libArc) const {
 	if (libArc.timingSense != "non_unate" &&
 			libArc.timingSense != "positive_unate" &&
@@ -206,6 +527,7 @@ void Timer::initializeTimingCell(Rsyn::Cell rsynCell) {
 			const TimingPin &timingPin = getTimingPin(pin);
 			if (timingPin.isDataPin()) {
 				endpoints.insert(pin);
+				clsTimingStateStore.invalidateEndpoints();
 			} // end if
 		} // end for
 	} // end if
@@ -246,6 +568,7 @@ void Timer::uninitializeTimingCell(Rsyn::Cell rsynCell) {
 			const TimingPin &timingPin = getTimingPin(pin);
 			if (timingPin.isDataPin()) {
 				endpoints.erase(pin);
+				clsTimingStateStore.invalidateEndpoints();
 			} // end if
 		} // end for
 	} // end if
@@ -322,6 +645,103 @@ void Timer::setTimingLibraryPinSetupConstraint(
 
 // -----------------------------------------------------------------------------
 
+void Timer::setNumThreads(const int numThreads) {
+	clsNumThreads = std::max(1, numThreads);
+	if (clsNumThreads > 1) {
+		if (!clsThreadPool || (int) clsThreadPool->getNumThreads() != clsNumThreads) {
+			clsThreadPool.reset(new ThreadPool(clsNumThreads));
+		} // end if
+	} else {
+		clsThreadPool.reset();
+	} // end else
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Timer::setTimingStateStoreEnabled(const bool enable) {
+	clsEnableTimingStateStore = enable;
+	clsTimingStateStore.clear();
+
+	// The store may be enabled before the timer is initialized (e.g. via
+	// parameters). In that case it is filled when the first full timing update
+	// writes the pins.
+	if (!enable || !module)
+		return;
+
+	clsTimingStateStore.resize(clsPinLayer.getNumObjects());
+	for (Rsyn::Instance instance : module.allInstances()) {
+		for (Rsyn::Pin pin : instance.allPins()) {
+			clsTimingStateStore.update(design.getId(pin), getTimingPin(pin));
+		} // end for
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+int Timer::countTimingStateStoreMismatches() const {
+	if (!clsEnableTimingStateStore)
+		return 0;
+
+	int numMismatches = 0;
+	for (Rsyn::Instance instance : module.allInstances()) {
+		for (Rsyn::Pin pin : instance.allPins()) {
+			if (!clsTimingStateStore.matches(design.getId(pin), getTimingPin(pin)))
+				numMismatches++;
+		} // end for
+	} // end for
+	return numMismatches;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Timer::runInParallel(const int numItems,
+		const std::function<void(const int begin, const int end)> &task) {
+	if (!clsThreadPool || numItems < 2*PARALLEL_MIN_NETS_PER_TASK) {
+		task(0, numItems);
+		return;
+	} // end if
+
+	// Use a few more tasks than threads to smooth out load imbalance as the
+	// cost of nets varies a lot (e.g. high fanout nets).
+	const int numThreads = (int) clsThreadPool->getNumThreads();
+	const int numTasks = std::min(4 * numThreads,
+			numItems / PARALLEL_MIN_NETS_PER_TASK);
+	const int numItemsPerTask = (numItems + numTasks - 1) / numTasks;
+
+	for (int begin = 0; begin < numItems; begin += numItemsPerTask) {
+		const int end = std::min(numItems, begin + numItemsPerTask);
+		clsThreadPool->addTask([&task, begin, end]() {
+			task(begin, end);
+		});
+	} // end for
+	clsThreadPool->wait();
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Timer::runInParallelDynamic(const int numItems,
+		const std::function<void(const int i)> &task) {
+	if (!clsThreadPool || numItems < 2) {
+		for (int i = 0; i < numItems; i++) {
+			task(i);
+		} // end for
+		return;
+	} // end if
+
+	std::atomic<int> next(0);
+	const int numThreads = std::min((int) clsThreadPool->getNumThreads(), numItems);
+	for (int t = 0; t < numThreads; t++) {
+		clsThreadPool->addTask([&]() {
+			for (int i = next++; i < numItems; i = next++) {
+				task(i);
+			} // end for
+		});
+	} // end for
+	clsThreadPool->wait();
+} // end method
+
+// -----------------------------------------------------------------------------
+
 void Timer::setClockUncertainty(const TimingMode mode, const Number uncertainty) {
 	clockUncertainty[mode] = uncertainty;
 
@@ -357,6 +777,7 @@ void Timer::init(
 	clsNetLayer = rsynDesign.createAttribute();
 	clsPinLayer = rsynDesign.createAttribute();
 	clsArcLayer = rsynDesign.createAttribute();
+	clsDirtyTimingCellSign = rsynDesign.createAttribute(0);
 	clsLibraryCellLayer = rsynDesign.createAttribute();
 	clsLibraryArcLayer = rsynDesign.createAttribute();
 	clsLibraryPinLayer = rsynDesign.createAttribute();
@@ -444,6 +865,7 @@ void Timer::init(
 			case Rsyn::PORT:
 				if (instance.isPort(Rsyn::OUT)) {
 					endpoints.insert(instance.asPort().getInnerPin());
+					clsTimingStateStore.invalidateEndpoints();
 				} // end if
 				break;
 			default:
@@ -820,24 +1242,152 @@ void Timer::updateTiming_Net(Rsyn::Net net) {
 			} // end for
 		} // end for	
 	} // end else
+
+	updateTimingStateStore(net);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Timer::updateTiming_Levelize() {
+	if (!clsNetLevelsDirty)
+		return;
+
+	// Levels are only dirty after the netlist changed, right before a full
+	// timing update, so the netlist snapshot is (re)built here. It is then
+	// reused by the other full timing passes and by path queries until the
+	// next netlist change.
+	std::shared_ptr<const Rsyn::NetlistSnapshot> snapshot =
+			design.getNetlistSnapshot();
+	const Index invalid = Rsyn::NetlistSnapshot::INVALID_INDEX;
+
+	// The level of a net is one plus the largest level among the nets driving
+	// the "from" pins of the arcs reaching the net driver. This captures all
+	// data dependencies of updateTiming_Net(). Nets are visited in 
+	// topological order, so the levels of the previous nets are up to date.
+	clsNetLevels.clear();
+
+	std::vector<int> levels(snapshot->getNumNetRows(), -1);
+	for (Rsyn::Net net : snapshot->allNetsInTopologicalOrder()) {
+		const Index netIndex = snapshot->getNetIndex(net);
+		int level = 0;
+
+		// [ASSUMPTION] Net has a single driver.
+		const Index driver = snapshot->getNetDriver(netIndex);
+		if (driver != invalid) {
+			for (const Index from : snapshot->getFaninPins(driver)) {
+				const Index previousNet = snapshot->getPinNet(from);
+				if (previousNet != invalid) {
+					level = std::max(level, levels[previousNet] + 1);
+				} // end if
+			} // end for
+		} // end if
+
+		levels[netIndex] = level;
+		getTimingNet(net).level = level;
+		if ((int) clsNetLevels.size() <= level) {
+			clsNetLevels.resize(level + 1);
+		} // end if
+		clsNetLevels[level].push_back(net);
+	} // end for
+
+	// The reverse level of a net is one plus the largest reverse level among
+	// the nets driven by the "to" pins of the arcs leaving the net sinks.
+	// Besides, the required time and centrality of a clock pin depends on 
+	// (and, in UI-Timer compatibility mode, is written when processing) the 
+	// data pins of the same sequential cell. Nets connected to the clock and
+	// data pins of a same cell are therefore placed in increasing levels 
+	// following the order in which they are visited in the serial traversal.
+	clsReverseNetLevels.clear();
+
+	std::vector<int> reverseLevels(snapshot->getNumNetRows(), -1);
+	Rsyn::Attribute<Rsyn::Instance, int> sequentialLevels = 
+			design.createAttribute(-1);
+	for (Rsyn::Net net : snapshot->allNetsInReverseTopologicalOrder()) {
+		const Index netIndex = snapshot->getNetIndex(net);
+		int level = 0;
+
+		for (const Index pin : snapshot->getNetPins(netIndex)) {
+			Rsyn::Pin sink = snapshot->getPin(pin);
+			if (sink.getDirection() != Rsyn::SINK)
+				continue;
+
+			for (const Index to : snapshot->getFanoutPins(pin)) {
+				const Index nextNet = snapshot->getPinNet(to);
+				if (nextNet != invalid) {
+					level = std::max(level, reverseLevels[nextNet] + 1);
+				} // end if
+			} // end for
+
+			const TimingPin &timingPin = getTimingPin(sink);
+			if (timingPin.isClockPin() || timingPin.isDataPin()) {
+				level = std::max(level, 
+						sequentialLevels[sink.getInstance()] + 1);
+			} // end if
+		} // end for
+
+		reverseLevels[netIndex] = level;
+		getTimingNet(net).reverseLevel = level;
+		for (Rsyn::Pin sink : net.allPins(Rsyn::SINK)) {
+			const TimingPin &timingPin = getTimingPin(sink);
+			if (timingPin.isClockPin() || timingPin.isDataPin()) {
+				int &sequentialLevel = sequentialLevels[sink.getInstance()];
+				sequentialLevel = std::max(sequentialLevel, level);
+			} // end if
+		} // end for
+
+		if ((int) clsReverseNetLevels.size() <= level) {
+			clsReverseNetLevels.resize(level + 1);
+		} // end if
+		clsReverseNetLevels[level].push_back(net);
+	} // end for
+
+	clsNetLevelsDirty = false;
 } // end method
 
 // -----------------------------------------------------------------------------
 
 void Timer::updateTiming_PropagateArrivalTimes() {
-	for (Rsyn::Net net : module.allNetsInTopologicalOrder()) {
+	if (clsThreadPool) {
+		updateTiming_PropagateArrivalTimesParallel();
+		return;
+	} // end if
+
+	// The snapshot is not rebuilt here as the module keeps the same ordering.
+	std::shared_ptr<const Rsyn::NetlistSnapshot> snapshot =
+			design.getCachedNetlistSnapshot();
+	const std::vector<Rsyn::Net> &nets = snapshot?
+			snapshot->allNetsInTopologicalOrder() :
+			module.allNetsInTopologicalOrder();
+	for (Rsyn::Net net : nets) {
 		updateTiming_Net(net);
 	} // end for
 } // end method
 
 // -----------------------------------------------------------------------------
 
+void Timer::updateTiming_PropagateArrivalTimesParallel() {
+	updateTiming_Levelize();
+
+	// Nets in the same level only write to their own driver, sinks and the
+	// arcs reaching the driver, so they can be safely updated concurrently.
+	for (const std::vector<Rsyn::Net> &nets : clsNetLevels) {
+		runInParallel((int) nets.size(), [&](const int begin, const int end) {
+			for (int i = begin; i < end; i++) {
+				updateTiming_Net(nets[i]);
+			} // end for
+		});
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
 void Timer::updateTiming_HandleFloatingPins() {
 	for (Rsyn::Pin pin : floatingStartpoints){
 		TimingPin & timingPin = getTimingPin(pin);
 		timingPin.state[EARLY].a.setBoth(+UNINITVALUE);
 		timingPin.state[LATE ].a.setBoth(-UNINITVALUE);
 		timingPin.skip = true;
+		updateTimingStateStore(pin);
 	} // end for
 	
 	for (Rsyn::Pin pin : floatingEndpoints){
@@ -847,6 +1397,7 @@ void Timer::updateTiming_HandleFloatingPins() {
 		timingPin.state[EARLY].wsq.setBoth(-UNINITVALUE);
 		timingPin.state[LATE ].wsq.setBoth(+UNINITVALUE);
 		timingPin.skip = true;
+		updateTimingStateStore(pin);
 	} // end for	
 } // end method
 
@@ -868,6 +1419,8 @@ void Timer::updateTiming_UpdateTimingTests_SetupHold_DataPin(Rsyn::Pin pin) {
 	// Hold
 	EdgeArray<Number> thold = timingModel->getHoldTime(pin);
 	timingPin.state[EARLY].q = (clk.state[LATE].a[RISE] + clockUncertainty[EARLY]) + thold;
+
+	updateTimingStateStore(pin);
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -896,6 +1449,7 @@ void Timer::updateTiming_UpdateTimingTests() {
 			timingPin.state[mode].wsq = timingPin.state[mode].q;
 		} // end for		
 		
+		updateTimingStateStore(pin);
 	} // end for
 } // end method
 
@@ -998,7 +1552,8 @@ void Timer::updateTiming_PropagateRequiredTimes_Net(Rsyn::Net net) {
 			//of the clock pin was not yet processed.
 			
 			const TimingPin &data = from; // just an alias
-			TimingPin &ck =  getTimingPin(sink.getInstance().getPinByIndex(from.getClockPinIndex()));
+			Rsyn::Pin clock = sink.getInstance().getPinByIndex(from.getClockPinIndex());
+			TimingPin &ck =  getTimingPin(clock);
 
 			ck.state[EARLY].q[RISE] = 
 					ck.state[EARLY].a[RISE] - data.getWorstSlack(LATE);
@@ -1007,6 +1562,7 @@ void Timer::updateTiming_PropagateRequiredTimes_Net(Rsyn::Net net) {
 			ck.state[LATE ].q[RISE] = 
 					data.getWorstSlack(EARLY) + ck.state[LATE].a[RISE];
 			ck.state[LATE ].q[FALL] = +UNINITVALUE;
+			updateTimingStateStore(clock);
 		} // end else		
 
 		// Update required time of the driver.
@@ -1023,20 +1579,49 @@ void Timer::updateTiming_PropagateRequiredTimes_Net(Rsyn::Net net) {
 			} // end for
 		} // end for
 	} // end for each
+
+	updateTimingStateStore(net);
 } // end method
 
 // -----------------------------------------------------------------------------
 
 void Timer::updateTiming_PropagateRequiredTimes() {
+	if (clsThreadPool) {
+		updateTiming_PropagateRequiredTimesParallel();
+		return;
+	} // end if
+
 	// Traverse the circuit from outputs to inputs.
-	for (Rsyn::Net net : module.allNetsInReverseTopologicalOrder()) {
+	std::shared_ptr<const Rsyn::NetlistSnapshot> snapshot =
+			design.getCachedNetlistSnapshot();
+	const std::vector<Rsyn::Net> &nets = snapshot?
+			snapshot->allNetsInReverseTopologicalOrder() :
+			module.allNetsInReverseTopologicalOrder();
+	for (Rsyn::Net net : nets) {
 		updateTiming_PropagateRequiredTimes_Net(net);
 	} // end for
 } // end method
 
 // -----------------------------------------------------------------------------
 
-void Timer::updateTiming_PropagateRequiredTimesIncremental(const std::set<Rsyn::Net> &nets) {
+void Timer::updateTiming_PropagateRequiredTimesParallel() {
+	updateTiming_Levelize();
+
+	// Nets in the same reverse level only write to their own driver and sinks
+	// and to the clock pin of sequential cells whose nets are never in the
+	// same level (see updateTiming_Levelize()).
+	for (const std::vector<Rsyn::Net> &nets : clsReverseNetLevels) {
+		runInParallel((int) nets.size(), [&](const int begin, const int end) {
+			for (int i = begin; i < end; i++) {
+				updateTiming_PropagateRequiredTimes_Net(nets[i]);
+			} // end for
+		});
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Timer::updateTiming_PropagateRequiredTimesIncremental(const std::vector<Rsyn::Net> &nets) {
 	const bool pruningEnable = false;
 	const Number pruningPrecision = 0;
 	
@@ -1062,20 +1647,23 @@ void Timer::updateTiming_PropagateRequiredTimesIncremental(const std::set<Rsyn::
 	const int arrivalTimePropagationSign = getSign();
 	generateNextSign();
 
-	typedef std::pair<Rsyn::TopologicalIndex, Rsyn::Net> T;
-	priority_queue<T, std::deque<T>> queue;
+	TimingLevelQueue &queue = clsLevelQueue;
+	resetIncrementalQueue(true);
 	
 	// Update all timing arcs driving the seed net.
 	for (Rsyn::Net net : nets) {
 		if (net) {
-			queue.push(std::make_pair(net.getTopologicalIndex(), net));
+			TimingNet &timingNet = getTimingNet(net);
+			if (timingNet.queueSign != getSign()) {
+				timingNet.queueSign = getSign();
+				queue.push(getIncrementalQueueKey(net, timingNet, true), net);
+			} // end if
 		} // end if
 	} // end for
 
 	// Propagate arrival times.
 	while (!queue.empty()) {
-		Rsyn::Net net = queue.top().second;
-		queue.pop();
+		Rsyn::Net net = queue.pop();
 		
 		TimingNet &timingNet = getTimingNet(net);
 
@@ -1128,7 +1716,8 @@ void Timer::updateTiming_PropagateRequiredTimesIncremental(const std::set<Rsyn::
 						hasStateChangedSignificantlyForRequiredTimePropagation(sinkStates[index],
 						getTimingPin(from).state, pruningPrecision);
 
-				const bool isSeed = nets.count(net);
+				const bool isSeed = 
+						std::find(nets.begin(), nets.end(), net) != nets.end();
 
 				if (counter && ((counter - counterPruned) == 0) && changed && !isSeed) {
 					std::cout << from.getFullName() << "\n" << net.getName()
@@ -1169,9 +1758,10 @@ void Timer::updateTiming_PropagateRequiredTimesIncremental(const std::set<Rsyn::
 				for (Rsyn::Arc arc : driver.allIncomingArcs()) {
 					Rsyn::Net previousNet = arc.getFromNet();
 					if (previousNet) {
-						const TimingNet &previousTimingNet = getTimingNet(previousNet);
-						if (previousTimingNet.sign != getSign()) {
-							queue.push(std::make_pair(previousNet.getTopologicalIndex(), previousNet));
+						TimingNet &previousTimingNet = getTimingNet(previousNet);
+						if (previousTimingNet.queueSign != getSign()) {
+							previousTimingNet.queueSign = getSign();
+							queue.push(getIncrementalQueueKey(previousNet, previousTimingNet, true), previousNet);
 						} // end if
 					} // end if
 				} // end for
@@ -1183,50 +1773,125 @@ void Timer::updateTiming_PropagateRequiredTimesIncremental(const std::set<Rsyn::
 // -----------------------------------------------------------------------------
 
 void Timer::updateTiming_UpdateTimingViolations() {
-	// Compute slacks for endpoints.
+	// Accumulate in local variables, which the compiler can keep in registers,
+	// and store the results once at the end. Values are accumulated in the 
+	// same order as the endpoints are visited, so results do not change.
+	Number tns[NUM_TIMING_MODES];
+	Number aggregatedTns[NUM_TIMING_MODES];
+	Number worstWns[NUM_TIMING_MODES];
+	Number worstSlack[NUM_TIMING_MODES];
+	Number maxArrivalTime[NUM_TIMING_MODES];
+	Number minArrivalTime[NUM_TIMING_MODES];
+	int numCriticalEndpoints[NUM_TIMING_MODES];
 	for (const TimingMode mode : allTimingModes()) {
-		clsTNS[mode] = 0;
-		clsAggregatedTNS[mode] = 0;
-		clsWNS[mode] = 0;
-		clsWorstSlack[mode] = +std::numeric_limits<Number>::max();
-		clsMaxArrivalTime[mode] = -std::numeric_limits<Number>::infinity();
-		clsMinArrivalTime[mode] = +std::numeric_limits<Number>::infinity();
-		clsNumCriticalEndpoints[mode] = 0;
+		tns[mode] = 0;
+		aggregatedTns[mode] = 0;
+		worstWns[mode] = 0;
+		worstSlack[mode] = +std::numeric_limits<Number>::max();
+		maxArrivalTime[mode] = -std::numeric_limits<Number>::infinity();
+		minArrivalTime[mode] = +std::numeric_limits<Number>::infinity();
+		numCriticalEndpoints[mode] = 0;
 	} // end for
-	clsSlackChecksum = 0;
+	Number slackChecksum = 0;
+
+	if (clsEnableTimingStateStore) {
+		// Same computation streaming thru the slack and arrival arrays of the
+		// store. Endpoints are visited in the same order, so the results are
+		// exactly the same.
+		TimingStateStore &store = clsTimingStateStore;
+		if (store.isEndpointListDirty()) {
+			store.setEndpoints(design, allEndpoints());
+		} // end if
+
+		const std::vector<Index> &ids = store.allEndpointIds();
+		const int numEndpoints = (int) ids.size();
 
-	for (Rsyn::Pin pin : allEndpoints()) {
-		TimingPin &timingPin = getTimingPin(pin);
-		
 		for (const TimingMode mode : allTimingModes()) {
-			Number wns = 0; // must be zero so that positive slack are ignored
-			for (const TimingTransition edge : allTimingTransitions()) {
-				const Number slack = timingPin.getSlack(mode, edge);
-				if (slack < clsWorstSlack[mode]) {
-					clsCriticalPathEndpoint[mode] = std::make_pair(pin, edge);
-					clsWorstSlack[mode] = slack;
-				} // end method
-
-				wns = std::min(wns, slack);
-				clsSlackChecksum += slack;
-				clsAggregatedTNS[mode] += std::min(0.0f, slack);
+			const Number * slacks[NUM_EDGE_TYPES] = {
+					store.getSlacks(mode, RISE), store.getSlacks(mode, FALL)};
+			const Number * arrivalRise = store.getArrivals(mode, RISE);
+			const Number * arrivalFall = store.getArrivals(mode, FALL);
+
+			for (int i = 0; i < numEndpoints; i++) {
+				const Index id = ids[i];
+
+				Number wns = 0; // must be zero so that positive slack are ignored
+				for (const TimingTransition edge : allTimingTransitions()) {
+					const Number slack = slacks[edge][id];
+					if (slack < worstSlack[mode]) {
+						clsCriticalPathEndpoint[mode] = 
+								std::make_pair(store.allEndpointPins()[i], edge);
+						worstSlack[mode] = slack;
+					} // end if
+
+					wns = std::min(wns, slack);
+					aggregatedTns[mode] += std::min(0.0f, slack);
+				} // end for
+
+				worstWns[mode] = std::min(worstWns[mode], wns);
+				tns[mode] += wns;
+				numCriticalEndpoints[mode] += wns < 0;
+
+				maxArrivalTime[mode] = std::max(maxArrivalTime[mode], 
+						std::max(arrivalRise[id], arrivalFall[id]));
+				minArrivalTime[mode] = std::min(minArrivalTime[mode], 
+						std::min(arrivalRise[id], arrivalFall[id]));
 			} // end for
+		} // end for
 
-			if (wns < clsWNS[mode]) { //keep the wns pin for early and late violations;
-				clsWNS[mode] = wns;
-			} // end if
-			clsTNS[mode] += wns;
-			if(wns < 0)
-				clsNumCriticalEndpoints[mode]++;
-			
-			clsMaxArrivalTime[mode] = std::max(clsMaxArrivalTime[mode], timingPin.getMaxArrivalTime(mode));
-			clsMinArrivalTime[mode] = std::min(clsMinArrivalTime[mode], timingPin.getMinArrivalTime(mode));
+		// The checksum interleaves modes, so it is summed in a separate pass
+		// to keep the order of the additions.
+		for (int i = 0; i < numEndpoints; i++) {
+			const Index id = ids[i];
+			for (const TimingMode mode : allTimingModes()) {
+				for (const TimingTransition edge : allTimingTransitions()) {
+					slackChecksum += store.getSlack(id, mode, edge);
+				} // end for
+			} // end for
+		} // end for
+	} else {
+		for (Rsyn::Pin pin : allEndpoints()) {
+			const TimingPin &timingPin = getTimingPin(pin);
+
+			for (const TimingMode mode : allTimingModes()) {
+				Number wns = 0; // must be zero so that positive slack are ignored
+				for (const TimingTransition edge : allTimingTransitions()) {
+					const Number slack = timingPin.getSlack(mode, edge);
+					if (slack < worstSlack[mode]) {
+						clsCriticalPathEndpoint[mode] = std::make_pair(pin, edge);
+						worstSlack[mode] = slack;
+					} // end method
+
+					wns = std::min(wns, slack);
+					slackChecksum += slack;
+					aggregatedTns[mode] += std::min(0.0f, slack);
+				} // end for
+
+				worstWns[mode] = std::min(worstWns[mode], wns);
+				tns[mode] += wns;
+				numCriticalEndpoints[mode] += wns < 0;
+
+				maxArrivalTime[mode] = std::max(maxArrivalTime[mode], timingPin.getMaxArrivalTime(mode));
+				minArrivalTime[mode] = std::min(minArrivalTime[mode], timingPin.getMinArrivalTime(mode));
+			} // end for
 		} // end for
+	} // end else
+
+	for (const TimingMode mode : allTimingModes()) {
+		clsTNS[mode] = tns[mode];
+		clsAggregatedTNS[mode] = aggregatedTns[mode];
+		clsWNS[mode] = worstWns[mode];
+		clsWorstSlack[mode] = worstSlack[mode];
+		clsMaxArrivalTime[mode] = maxArrivalTime[mode];
+		clsMinArrivalTime[mode] = minArrivalTime[mode];
+		clsNumCriticalEndpoints[mode] = numCriticalEndpoints[mode];
 	} // end for
+	clsSlackChecksum = slackChecksum;
 } // end method
+
 // -----------------------------------------------------------------------------
 
-void Timer::updateTiming_Centrality_Net(Rsyn::Net net) {
+void Timer::updateTiming_Centrality_Net(Rsyn::Net net, Number maxCentrality[NUM_TIMING_MODES]) {
 	const bool dontPropagateThruClockNetwork = true;
 	
 	Number sumSinkCentralities[NUM_TIMING_MODES] = {0, 0};
@@ -1269,7 +1934,7 @@ void Timer::updateTiming_Centrality_Net(Rsyn::Net net) {
 	// an upper bound of the sink's centralities, it is not necessary to update
 	// the maximum centrality for each sink.
 	for (const TimingMode mode : allTimingModes()) {
-		clsMaxCentrality[mode] = std::max(clsMaxCentrality[mode], 
+		maxCentrality[mode] = std::max(maxCentrality[mode], 
 				sumSinkCentralities[mode]);
 	} // end for
 	
@@ -1320,19 +1985,54 @@ void Timer::updateTiming_Centrality() {
 	for (const TimingMode mode : allTimingModes()) {
 		clsMaxCentrality[mode] = 0;
 	} // end for
+
+	if (clsThreadPool) {
+		updateTiming_CentralityParallel();
+		return;
+	} // end if
 	
-	for (Rsyn::Net net : module.allNetsInReverseTopologicalOrder()) {
-		updateTiming_Centrality_Net(net);
+	std::shared_ptr<const Rsyn::NetlistSnapshot> snapshot =
+			design.getCachedNetlistSnapshot();
+	const std::vector<Rsyn::Net> &nets = snapshot?
+			snapshot->allNetsInReverseTopologicalOrder() :
+			module.allNetsInReverseTopologicalOrder();
+	for (Rsyn::Net net : nets) {
+		updateTiming_Centrality_Net(net, clsMaxCentrality);
 	} // end for
 } // end method
 
 // -----------------------------------------------------------------------------
 
-void Timer::updateTiming_CentralityIncremental(const std::set<Rsyn::Net>& nets) {
+void Timer::updateTiming_CentralityParallel() {
+	updateTiming_Levelize();
+
+	// Each chunk computes its own maximum centrality, which is then merged
+	// into the global one.
+	std::mutex mutexMaxCentrality;
+
+	for (const std::vector<Rsyn::Net> &nets : clsReverseNetLevels) {
+		runInParallel((int) nets.size(), [&](const int begin, const int end) {
+			Number maxCentrality[NUM_TIMING_MODES] = {0, 0};
+			for (int i = begin; i < end; i++) {
+				updateTiming_Centrality_Net(nets[i], maxCentrality);
+			} // end for
+
+			std::lock_guard<std::mutex> lock(mutexMaxCentrality);
+			for (const TimingMode mode : allTimingModes()) {
+				clsMaxCentrality[mode] = std::max(clsMaxCentrality[mode],
+						maxCentrality[mode]);
+			} // end for
+		});
+	} // end for
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Timer::updateTiming_CentralityIncremental(const std::vector<Rsyn::Net>& nets) {
 	generateNextSign();
-	
-	typedef std::pair<Rsyn::TopologicalIndex, Rsyn::Net> T;
-	priority_queue<T, std::deque<T>> queue;
+
+	TimingLevelQueue &queue = clsLevelQueue;
+	resetIncrementalQueue(true);
 
 	for (const TimingMode mode : allTimingModes()) {
 		clsMaxCentrality[mode] = 0;
@@ -1341,14 +2041,17 @@ void Timer::updateTiming_CentralityIncremental(const std::set<Rsyn::Net>& nets)
 	// Update all timing arcs driving the seed net.
 	for (Rsyn::Net net : nets) {
 		if (net) {
-			queue.push(std::make_pair(net.getTopologicalIndex(), net));
+			TimingNet &timingNet = getTimingNet(net);
+			if (timingNet.queueSign != getSign()) {
+				timingNet.queueSign = getSign();
+				queue.push(getIncrementalQueueKey(net, timingNet, true), net);
+			} // end if
 		} // end if
 	} // end for
 
 	// Propagate criticalities.
 	while (!queue.empty()) {
-		Rsyn::Net net = queue.top().second;
-		queue.pop();
+		Rsyn::Net net = queue.pop();
 		
 		TimingNet &timingNet = getTimingNet(net);
 
@@ -1363,7 +2066,7 @@ void Timer::updateTiming_CentralityIncremental(const std::set<Rsyn::Net>& nets)
 		timingNet.sign = getSign();
 
 		// Update timing of the current net.
-		updateTiming_Centrality_Net(net);
+		updateTiming_Centrality_Net(net, clsMaxCentrality);
 
 		// Add predecessor nets to the queue.
 		// [ASSUMPTION] Net has a single driver.
@@ -1372,7 +2075,11 @@ void Timer::updateTiming_CentralityIncremental(const std::set<Rsyn::Net>& nets)
 			for (Rsyn::Arc arc : driver.allIncomingArcs()) {
 				Rsyn::Net previousNet = arc.getFromNet();
 				if (previousNet) {
-					queue.push(std::make_pair(previousNet.getTopologicalIndex(), previousNet));
+					TimingNet &previousTimingNet = getTimingNet(previousNet);
+					if (previousTimingNet.queueSign != getSign()) {
+						previousTimingNet.queueSign = getSign();
+						queue.push(getIncrementalQueueKey(previousNet, previousTimingNet, true), previousNet);
+					} // end if
 				} // end if
 			} // end for
 		} // end if
@@ -1412,6 +2119,10 @@ void Timer::updateTimingFull() {
 	
 	clsStopwatchUpdateTiming.start();
 	
+	// Levels are repaired here rather than in the incremental updates, which
+	// fall back to topological indexes while levels are dirty.
+	updateTiming_Levelize();
+	reserveTimingStateStore();
 	updateTiming_HandleFloatingPins();
 	updateTiming_PropagateArrivalTimes();
 	updateTiming_UpdateTimingTests();
@@ -1420,8 +2131,7 @@ void Timer::updateTimingFull() {
 	updateTiming_Centrality();
 	updateTiming_CriticalEndpoints();
 	
-	dirtyNets.clear();
-	clsDirtyTimingCells.clear();
+	clearDirtyNetsAndInstances();
 	clsForceFullTimingUpdate = false;
 	
 	clsStopwatchUpdateTiming.start();
@@ -1429,8 +2139,11 @@ void Timer::updateTimingFull() {
 
 // -----------------------------------------------------------------------------
 
-void Timer::updateTiming_PropagateArrivalTimesIncremental(std::set<Rsyn::Net> &endpoints) {
-	const bool pruningEnable = false;
+void Timer::updateTiming_PropagateArrivalTimesIncremental(std::vector<Rsyn::Net> &endpoints) {
+	// Propagation stops at sinks whose arrival time and slew did not change.
+	// Note that a zero precision is used so that pruning does not change the
+	// timing results.
+	const bool pruningEnable = !TIMER_DEBUG_PRUNING;
 	const Number pruningPrecision = 0;
 	
 	#if TIMER_DEBUG_PRUNING	
@@ -1450,29 +2163,31 @@ void Timer::updateTiming_PropagateArrivalTimesIncremental(std::set<Rsyn::Net> &e
 	endpoints.clear();
 	
 	generateNextSign();
-	
+
 	std::vector<std::array<TimingPinState, 2>> sinkStates;
 	int index;
 	int enqueued;
 	
-	// Priority queue.
-	typedef std::pair<Rsyn::TopologicalIndex, Rsyn::Net> T;
-	std::priority_queue< T, std::deque<T>, std::greater<T> > queue;
+	// Level queue.
+	TimingLevelQueue &queue = clsLevelQueue;
+	resetIncrementalQueue(false);
 
 	// Update all timing arcs driving the seed net.
 	for (Rsyn::Net net : dirtyNets) {
 		if (net != getClockNet()) {
-			queue.push(std::make_pair(net.getTopologicalIndex(), net));
-			
 			TimingNet &timingNet = getTimingNet(net);
 			timingNet.dirty = true;
+			
+			if (timingNet.queueSign != getSign()) {
+				timingNet.queueSign = getSign();
+				queue.push(getIncrementalQueueKey(net, timingNet, false), net);
+			} // end if
 		} // end if
 	} // end for	
 	
 	// Propagate arrival times.
 	while (!queue.empty()) {
-		Rsyn::Net net = queue.top().second;
-		queue.pop();
+		Rsyn::Net net = queue.pop();
 		
 		TimingNet &timingNet = getTimingNet(net);
 
@@ -1528,7 +2243,7 @@ void Timer::updateTiming_PropagateArrivalTimesIncremental(std::set<Rsyn::Net> &e
 					counter++;
 				} // end if
 
-				if (counter && ((counter - counterPruned) == 0) && !dirtyNets.count(net)) {
+				if (counter && ((counter - counterPruned) == 0) && !isDirtyNet(net)) {
 					const TimingPin &timingPin = getTimingPin(driver);
 
 					const bool changed = hasStateChangedSignificantlyForArrivalTimePropagation(driverState,
@@ -1536,7 +2251,7 @@ void Timer::updateTiming_PropagateArrivalTimesIncremental(std::set<Rsyn::Net> &e
 					if (changed) {
 						std::cout << "Pruning mismatch:\n";
 						std::cout << "pin: " << driver.getFullName() << "\n";
-						std::cout << "net: " << net.getName() << " dirty=" <<  dirtyNets.count(net) << "\n";
+						std::cout << "net: " << net.getName() << " dirty=" <<  isDirtyNet(net) << "\n";
 						std::cout << "old state:\n";
 						printState(std::cout, driverState);
 						std::cout << "new state:\n";
@@ -1567,9 +2282,10 @@ void Timer::updateTiming_PropagateArrivalTimesIncremental(std::set<Rsyn::Net> &e
 				for (Rsyn::Arc arc : from.allOutgoingArcs()) {
 					Rsyn::Net nextNet = arc.getToNet();
 					if (nextNet) {
-						const TimingNet &nextTimingNet = getTimingNet(nextNet);
-						if (nextTimingNet.sign != getSign()) {
-							queue.push(std::make_pair(nextNet.getTopologicalIndex(), nextNet));
+						TimingNet &nextTimingNet = getTimingNet(nextNet);
+						if (nextTimingNet.queueSign != getSign()) {
+							nextTimingNet.queueSign = getSign();
+							queue.push(getIncrementalQueueKey(nextNet, nextTimingNet, false), nextNet);
 							enqueued++;
 						} // end if
 					} // end if
@@ -1583,7 +2299,7 @@ void Timer::updateTiming_PropagateArrivalTimesIncremental(std::set<Rsyn::Net> &e
 			if (timingPin.isClockPin()) {
 				Rsyn::Pin data = from.getInstance().getPinByIndex(timingPin.getDataPinIndex());
 				if (data && data.getNet()) {
-					endpoints.insert(data.getNet());
+					endpoints.push_back(data.getNet());
 				} // end if
 			} // end if
 			
@@ -1592,7 +2308,7 @@ void Timer::updateTiming_PropagateArrivalTimesIncremental(std::set<Rsyn::Net> &e
 
 		// If this net did not expanded any neighbors, add it as a final net.			
 		if (enqueued == 0) {
-			endpoints.insert(net);
+			endpoints.push_back(net);
 		} // end if
 	} // end while
 } // end method
@@ -1611,13 +2327,14 @@ void Timer::updateTimingIncremental() {
 			for (Rsyn::Pin pin : cell.allPins()) {
 				Rsyn::Net net = pin.getNet();
 				if (net) {
-					dirtyNets.insert(net);
+					dirtyNet(net);
 				} // end if
 			} // end for
 		} // end for
 
-		// Store nets were the required time need to be propagated back.
-		std::set<Rsyn::Net> endpoints;
+		// Store nets were the required time need to be propagated back. Nets
+		// may appear more than once.
+		std::vector<Rsyn::Net> endpoints;
 
 		updateTiming_HandleFloatingPins();
 		updateTiming_PropagateArrivalTimesIncremental(endpoints);
@@ -1628,8 +2345,7 @@ void Timer::updateTimingIncremental() {
 		updateTiming_CriticalEndpoints();
 
 		// Clear dirty cells and nets.
-		dirtyNets.clear();
-		clsDirtyTimingCells.clear();
+		clearDirtyNetsAndInstances();
 		
 		clsStopwatchUpdateTiming.stop();
 	} // end else
@@ -1668,7 +2384,7 @@ void Timer::updateTimingLocally(Rsyn::Instance cell, const bool includeSecondFan
 	for (std::tuple<TopologicalIndex, Rsyn::Net> &t : nets) {
 		Rsyn::Net net = std::get<1>(t);
 		updateTiming_Net(net);
-		dirtyNets.insert(net);
+		dirtyNet(net);
 	} // end for
 
 	// If this is a sequential cell update the required time at the data pin.
@@ -1679,7 +2395,7 @@ void Timer::updateTimingLocally(Rsyn::Instance cell, const bool includeSecondFan
 
 			Rsyn::Net net = dataPin.getNet();
 			if (net) {
-				dirtyNets.insert(net);
+				dirtyNet(net);
 			} // end if
 		} else {
 			std::cout << "[BUG] Sequential cell without a data pin.\n";
@@ -1693,7 +2409,7 @@ void Timer::updateTimingLocally(Rsyn::Instance cell, const bool includeSecondFan
 
 void Timer::updateTimingOfNet(Rsyn::Net net) { 
 	updateTiming_Net(net);
-	dirtyNets.insert(net);
+	dirtyNet(net);
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -2097,234 +2813,348 @@ void Timer::writeTimingFile(ostream &out) {
 // Top Critical Paths
 ////////////////////////////////////////////////////////////////////////////////
 
-void Timer::queryTopCriticalPaths_Queue_AddCriticalEndpoint(CriticalPathQueue &queue,
-		Rsyn::Pin endpoint,
-		const TimingMode mode,
+Timer::PathEnumerator::PathEnumerator(Timer * timer, const TimingMode mode,
 		const Number slackThreshold,
-		const bool checkSign,
-		const int sign,
-		const bool debug
+		std::shared_ptr<const Rsyn::NetlistSnapshot> snapshot) :
+		clsTimer(timer),
+		clsMode(mode),
+		clsSlackThreshold(slackThreshold),
+		clsSnapshot(snapshot) {
+} // end constructor
+
+// -----------------------------------------------------------------------------
+
+bool Timer::PathEnumerator::isAllowed(Rsyn::Pin pin) const {
+	if (clsAllowedNets.empty())
+		return true;
+	Rsyn::Net net = pin.getNet();
+	if (!net)
+		return true;
+	const Index id = clsTimer->design.getId(net);
+	return id < (Index) clsAllowedNets.size() && clsAllowedNets[id];
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Timer::PathEnumerator::allowNet(Rsyn::Net net) {
+	const Index id = clsTimer->design.getId(net);
+	if (id >= (Index) clsAllowedNets.size()) {
+		clsAllowedNets.resize(id + 1, 0);
+	} // end if
+	clsAllowedNets[id] = 1;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+Rsyn::Arc Timer::PathEnumerator::getFaninArc(Rsyn::Pin pin, const int slot) const {
+	return clsSnapshot?
+			clsSnapshot->getFaninArcs(clsSnapshot->getPinIndex(pin))[slot] :
+			pin.allIncomingArcs()[slot];
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Timer::PathEnumerator::push(Rsyn::Pin pin, Rsyn::Pin endpoint,
+		const int parent, const Number required, const std::uint16_t arcSlot,
+		const TimingTransition transition,
+		const TimingTransition transitionAtParent
 ) {
+	const Number arrival = clsTimer->getPinArrivalTime(pin, clsMode, transition);
+
+	Hop hop;
+	hop.propPin = pin;
+	hop.propEndpoint = endpoint;
+	hop.propParent = parent;
+	hop.propRequired = required;
+	hop.propArcSlot = arcSlot;
+	hop.propTransition = (std::int8_t) transition;
+	hop.propTransitionAtParent = (std::int8_t) transitionAtParent;
+
+	Entry entry;
+	entry.propSlack = clsTimer->computeSlack(clsMode, arrival, required);
+	entry.propHop = (int) clsHops.size();
+
+	clsHops.push_back(hop);
+	clsQueue.push(entry);
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Timer::PathEnumerator::addEndpoint(Rsyn::Pin endpoint) {
 	Rsyn::Net net = endpoint.getNet();
 	
-	TimingPin &timingPin = getTimingPin(endpoint);
+	TimingPin &timingPin = clsTimer->getTimingPin(endpoint);
 	std::tuple<Number, TimingTransition> slackTransitionPair 
-			= getPinWorstSlackWithTransition(timingPin, mode);
+			= clsTimer->getPinWorstSlackWithTransition(timingPin, clsMode);
 
 	const Number slack = std::get<0>(slackTransitionPair);
 	const TimingTransition transition = std::get<1>(slackTransitionPair);
-	const Number required = getPinRequiredTime(timingPin, mode, transition);
+	const Number required = clsTimer->getPinRequiredTime(timingPin, clsMode, transition);
 
-	if (slack < slackThreshold && (!checkSign || (net && getTimingNet(net).sign == sign))) {
-		Reference reference(endpoint, nullptr, nullptr, required, slack, transition, -1, transition);
-		queue.push(reference);
-		if (debug) {
-			reference.print("queuing endpoint", std::cout, design);
-		} // end if
+	if (slack < clsSlackThreshold && (clsAllowedNets.empty() || (net && isAllowed(endpoint)))) {
+		push(endpoint, endpoint, -1, required, NO_ARC, transition, transition);
 	} // end if	
 } // end method
 
 // -----------------------------------------------------------------------------
 
-void Timer::queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(CriticalPathQueue &queue,
-		const TimingMode mode,
-		const Number slackThreshold,
-		const bool checkSign,
-		const int sign,
-		const bool debug
-) {
+void Timer::PathEnumerator::addAllEndpoints() {
 	// Insert the all critical endpoints in the queue. Note that even if we
 	// want just a limited number of paths (e.g. 100) we still need to add all
 	// critical endpoints as they need to be sorted.
-	
-	for (Rsyn::Pin endpoint : allEndpoints()) {
-		queryTopCriticalPaths_Queue_AddCriticalEndpoint(queue, endpoint, mode, slackThreshold, checkSign, sign, debug);
+	for (Rsyn::Pin endpoint : clsTimer->allEndpoints()) {
+		addEndpoint(endpoint);
 	} // end for
 } // end method
 
 // -----------------------------------------------------------------------------
 
-bool Timer::queryTopCriticalPaths_Internal(CriticalPathQueue &queue,
-		const TimingMode mode, 
-		const int maxNumPaths,
-		std::vector<std::vector<Timer::PathHop>> &paths, 
-		const Number slackThreshold,
-		const bool checkSign,
-		const int sign,
-		const bool debug
-) {
-	
-	// Clear old paths.
-	paths.clear();
-	
-	// Nothing to be done if the worst slack is zero or positive.
-	if (getWns(mode) >= slackThreshold)
-		return false; // no critical paths
-	
-	// Used to store partial paths (backtrack).
-	std::deque<Reference> partialPaths;
+bool Timer::PathEnumerator::next() {
+	clsCurrent = -1;
+	clsCurrentSlack = 0;
 
-	// Used to store path startpoint reference in partial paths vector.
-	std::vector<int> startpoints;
-	
-	// Process path by worst slack.
-	int pathCounter = 0;
-	while (!queue.empty()) {
-		if (debug) {
-			queue.top().print("adding pin", std::cout, design);
-		} // end if			
+	while (!clsQueue.empty()) {
+		const int current = clsQueue.top().propHop;
+		clsQueue.pop();
 
-		Reference currentReference = queue.top(); // must be copy
-		Rsyn::Pin currentPin = queue.top().propPin;
-		Rsyn::Net currentNet = currentPin.getNet();
-		const TimingTransition currentTransition = queue.top().propTransition;
-		const Number currentRequired = queue.top().propRequired;
-		const TimingPin &currentTimingPin = getTimingPin(currentPin);
-		const int current = partialPaths.size();
-		
-		queue.pop();
+		// Copy as the hop vector may be reallocated.
+		const Hop hop = clsHops[current];
+		const TimingTransition currentTransition = (TimingTransition) hop.propTransition;
+		const Number currentRequired = hop.propRequired;
+		Rsyn::Pin currentPin = hop.propPin;
 
-		if (getPinSlack(currentPin, mode, currentTransition) >= slackThreshold)
+		if (clsTimer->getPinSlack(currentPin, clsMode, currentTransition) >= clsSlackThreshold)
 			continue;
 		
-		if (checkSign && (currentNet && getTimingNet(currentNet).sign != sign))
+		if (!isAllowed(currentPin))
 			continue;
 		
-		partialPaths.push_back(currentReference);
-		
 		if (currentPin.isPort(Rsyn::IN)) {
-			// Startpoint.
-			startpoints.push_back(current);
-			pathCounter++;
-			if (pathCounter == maxNumPaths) {
-				break;
+			// Startpoint. Since hops are processed by increasing slack, no
+			// other path is critical if this one is not.
+			const Number arrival = clsTimer->getPinArrivalTime(currentPin, clsMode, currentTransition);
+			const Number slack = clsTimer->computeSlack(clsMode, arrival, currentRequired);
+			if (slack >= clsSlackThreshold) {
+				clsQueue = decltype(clsQueue)();
+				return false;
 			} // end if
-		} else {
-			switch (currentPin.getDirection()) {
-				case Rsyn::IN: {
-					// Put the net's driver into the queue.
-					// [ASSUMPTION] Assuming only a single driver per net.
-					if (currentNet) {
-						Rsyn::Pin driver = currentNet.getAnyDriver();
-						if (driver) {
-							const Number required = currentRequired - 
-									currentTimingPin.state[mode].wdelay[currentTransition];
-							const Number arrival = getPinArrivalTime(driver, mode, currentTransition);
-							const Number slack = computeSlack(mode, arrival, required);
-
-							Reference reference(driver, nullptr, nullptr, required, slack, 
-									currentTransition, current, currentTransition);
-							queue.push(reference);
-							
-							if (debug) {
-								reference.print("queuing driver", std::cout, design);
-							} // end if
-						} // end if
-					} // end if
-					
-					break;
-				} // end case
 
-				case Rsyn::OUT: {
-					// Put all from pins driven this pin in the queue.
-					for (Rsyn::Arc arc : currentPin.allIncomingArcs()) {
-						TimingArc &timingArc = getTimingArc(arc);
-						
-						Rsyn::Pin from = arc.getFromPin();
-						
-						const TimingTransition transition =
-								timingArc.state[mode].backtrack[currentTransition];
+			clsCurrent = current;
+			clsCurrentSlack = slack;
+			clsNumPaths++;
+			return true;
+		} // end if
+
+		switch (currentPin.getDirection()) {
+			case Rsyn::IN: {
+				// Put the net's driver into the queue.
+				// [ASSUMPTION] Assuming only a single driver per net.
+				Rsyn::Net net = currentPin.getNet();
+				if (net) {
+					Rsyn::Pin driver = net.getAnyDriver();
+					if (driver) {
+						const TimingPin &currentTimingPin = clsTimer->getTimingPin(currentPin);
 						const Number required = currentRequired - 
-								timingArc.state[mode].delay[currentTransition];						
-						const Number arrival = getPinArrivalTime(from, mode, transition);
-						const Number slack = computeSlack(mode, arrival, required);
-						
-						Reference reference(from, &timingArc, arc, required, slack, 
-								transition, current, currentTransition);
-						queue.push(reference);						
+								currentTimingPin.state[clsMode].wdelay[currentTransition];
+						push(driver, hop.propEndpoint, current, required, NO_ARC,
+								currentTransition, currentTransition);
+					} // end if
+				} // end if
+				break;
+			} // end case
 
-						if (debug) {
-							reference.print("queuing sink", std::cout, design);
-						} // end if						
+			case Rsyn::OUT: {
+				// Put all from pins driven this pin in the queue.
+				auto pushFromPin = [&](Rsyn::Arc arc, Rsyn::Pin from, const int slot) {
+					const TimingArc &timingArc = clsTimer->getTimingArc(arc);
+
+					const TimingTransition transition =
+							timingArc.state[clsMode].backtrack[currentTransition];
+					const Number required = currentRequired - 
+							timingArc.state[clsMode].delay[currentTransition];
+					push(from, hop.propEndpoint, current, required,
+							(std::uint16_t) slot, transition, currentTransition);
+				}; // end lambda
+
+				if (clsSnapshot) {
+					const NetlistSnapshot &snapshot = *clsSnapshot;
+					const Index pin = snapshot.getPinIndex(currentPin);
+					const NetlistSnapshot::Span<Rsyn::Arc> arcs = snapshot.getFaninArcs(pin);
+					const NetlistSnapshot::Span<Index> fromPins = snapshot.getFaninPins(pin);
+					const int numArcs = arcs.size();
+					for (int i = 0; i < numArcs; i++) {
+						pushFromPin(arcs[i], snapshot.getPin(fromPins[i]), i);
 					} // end for
-					
-					break;
-				} // end case
-				
-				default:
-					assert(false);
-			} // end switch
-			
+				} else {
+					const std::vector<Rsyn::Arc> &arcs = currentPin.allIncomingArcs();
+					const int numArcs = (int) arcs.size();
+					for (int i = 0; i < numArcs; i++) {
+						pushFromPin(arcs[i], arcs[i].getFromPin(), i);
+					} // end for
+				} // end else
+				break;
+			} // end case
+
+			default:
+				assert(false);
+		} // end switch
+	} // end while
+
+	return false;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+int Timer::PathEnumerator::next(const int maxNumPaths,
+		std::vector<std::vector<PathHop>> &paths) {
+	int counter = 0;
+	while ((maxNumPaths <= 0 || counter < maxNumPaths) && next()) {
+		paths.resize(paths.size() + 1);
+		getPath(paths.back());
+		counter++;
+	} // end while
+	return counter;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+Rsyn::Pin Timer::PathEnumerator::getStartpoint() const {
+	return clsCurrent != -1? clsHops[clsCurrent].propPin : nullptr;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+Rsyn::Pin Timer::PathEnumerator::getEndpoint() const {
+	return clsCurrent != -1? clsHops[clsCurrent].propEndpoint : nullptr;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+void Timer::PathEnumerator::getPath(std::vector<PathHop> &path) const {
+	path.clear();
+	if (clsCurrent == -1)
+		return;
+
+	const TimingMode mode = clsMode;
+
+	int index = clsCurrent;
+
+	Number previousArrival = 0;
+	Number arrival = clsTimer->getPinArrivalTime(clsHops[index].propPin,
+			mode, (TimingTransition) clsHops[index].propTransition);
+	Rsyn::Arc arc = nullptr;
+	Rsyn::Pin previousPin = nullptr;
+	Rsyn::TimingTransition previousTransition = Rsyn::TIMING_TRANSITION_INVALID;
+
+	while (index >= 0) {
+		const Hop &reference = clsHops[index];
+		Rsyn::Pin pin = reference.propPin;
+		const TimingTransition transition = (TimingTransition) reference.propTransition;
+		const TimingPin &timingPin = clsTimer->getTimingPin(pin);
+
+		Rsyn::Arc arcFromThisPin = nullptr;
+		if (reference.propArcSlot != NO_ARC) {
+			arcFromThisPin = getFaninArc(clsHops[reference.propParent].propPin,
+					reference.propArcSlot);
+		} // end if
+
+		arrival += timingPin.state[mode].wdelay[transition];
+
+		PathHop hop;
+		hop.arrival = arrival;
+		hop.delay = arrival - previousArrival;
+		hop.required = reference.propRequired;
+		hop.pin = pin;
+		hop.transition = transition;
+		hop.mode = mode;
+		hop.rsynArcFromThisPin = arcFromThisPin;
+
+		hop.rsynArcToThisPin = arc;
+		hop.previousPin = previousPin;
+		hop.previousTransition = previousTransition;
+		if (reference.propParent != -1) {
+			const Hop &parent = clsHops[reference.propParent];
+			hop.nextPin = parent.propPin;
+			hop.nextTransition = (TimingTransition) parent.propTransition;
+		} else {
+			hop.nextPin = nullptr;
+			hop.nextTransition = Rsyn::TIMING_TRANSITION_INVALID;
+		} // end else
+
+		path.push_back(hop);
+
+		previousArrival = arrival;
+		if (arcFromThisPin) {
+			// arc a->o: a is this pin, o is the parent pin
+			arrival += clsTimer->getTimingArc(arcFromThisPin).state[mode].delay[
+					(TimingTransition) reference.propTransitionAtParent];
 		} // end if
 
+		arc = arcFromThisPin;
+		previousPin = pin;
+		previousTransition = transition;
+
+		index = reference.propParent;
 	} // end while
+} // end method
 
-	// Construct paths from partial results.
-	const int numPaths = startpoints.size();
-	
-	paths.resize(numPaths);
-	int countPaths = 0;
-	for (int i = 0; i < numPaths; i++) {
-		int index = startpoints[i];
+// -----------------------------------------------------------------------------
 
-		const Reference &startpoint = partialPaths[index];
-				
-		Number previousArrival = 0;
-		Number arrival = getPinArrivalTime(startpoint.propPin, mode, startpoint.propTransition);
-		Rsyn::Arc arc = nullptr;
-		Rsyn::Pin previousPin = nullptr;
-		Rsyn::TimingTransition previousTransition = Rsyn::TIMING_TRANSITION_INVALID;
-		
-		if (computeSlack(mode, arrival, startpoint.propRequired) >= slackThreshold)
-			break;
-		
-		countPaths++;
-		
-		while (index >= 0) {
-			const Reference &reference = partialPaths[index];
-			const TimingPin &timingPin = getTimingPin(reference.propPin);
-			
-			arrival += timingPin.state[mode].wdelay[reference.propTransition];
-			
-			PathHop hop;
-			hop.arrival = arrival;
-			hop.delay = arrival - previousArrival;
-			hop.required = reference.propRequired;
-			hop.pin = reference.propPin;
-			hop.transition = reference.propTransition;
-			hop.mode = mode;
-			hop.rsynArcFromThisPin = reference.propRsynArcFromThisPin;
-			
-			hop.rsynArcToThisPin = arc;
-			hop.previousPin = previousPin;
-			hop.previousTransition = previousTransition;
-			if (reference.propParentPartialPath != -1) {
-				hop.nextPin = partialPaths[reference.propParentPartialPath].propPin;
-				hop.nextTransition = partialPaths[reference.propParentPartialPath].propTransition;
-			} else {
-				hop.nextPin = nullptr;
-				hop.nextTransition = Rsyn::TIMING_TRANSITION_INVALID;
-			} // end else
-			
-			paths[i].push_back(hop);
+Timer::PathEnumerator Timer::enumerateCriticalPaths(
+		const TimingMode mode,
+		const Number slackThreshold
+) {
+	PathEnumerator enumerator(this, mode, slackThreshold,
+			design.getCachedNetlistSnapshot());
+	if (getWns(mode) < slackThreshold) {
+		enumerator.addAllEndpoints();
+	} // end if
+	return enumerator;
+} // end method
 
-			previousArrival = arrival;
-			if (reference.propArcPointerFromThisPin) {
-				// arc a->o: a is this pin, o is the parent pin
-				arrival += reference.propArcPointerFromThisPin->state[mode].delay[
-						reference.propTransitionAtParent];
-			} // end if
-			
-			arc = hop.getArcFromThisPin();
-			previousPin = hop.getPin();
-			previousTransition = hop.getTransition();
-			
-			index = reference.propParentPartialPath;
-		} // end while
-	} // end method
-	paths.resize(countPaths);
+// -----------------------------------------------------------------------------
+
+Timer::PathEnumerator Timer::enumerateCriticalPathsFromEndpoint(
+		const TimingMode mode,
+		const Rsyn::Pin endpoint,
+		const Number slackThreshold
+) {
+	PathEnumerator enumerator(this, mode, slackThreshold,
+			design.getCachedNetlistSnapshot());
+	if (getWns(mode) < slackThreshold) {
+		enumerator.addEndpoint(endpoint);
+	} // end if
+	return enumerator;
+} // end method
+
+// -----------------------------------------------------------------------------
+
+Timer::PathEnumerator Timer::enumerateCriticalPathsPassingThruPin(
+		const TimingMode mode,
+		const Rsyn::Pin referencePin,
+		const Number slackThreshold
+) {
+	PathEnumerator enumerator(this, mode, slackThreshold,
+			design.getCachedNetlistSnapshot());
+	if (getWns(mode) >= slackThreshold)
+		return enumerator;
+
+	// Net ids may exceed the number of nets after removals, so allowNet()
+	// grows the vector as needed.
+	enumerator.clsAllowedNets.assign(design.getNumNets(), 0);
+
+	// Mark nets in the fan-in of the reference pin.
+	for (Rsyn::Net net : module.getFaninConeNetsInBreadthFirstOrder(referencePin)) {
+		enumerator.allowNet(net);
+	} // end for
 	
-	return paths.size() > 0;
+	// Mark nets in the fan-out of the reference pin.
+	for (Rsyn::Net net : module.getFanoutConeNetsInBreadthFirstOrder(referencePin)) {
+		enumerator.allowNet(net);
+	} // end for
+
+	enumerator.addAllEndpoints();
+	return enumerator;
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -2335,11 +3165,9 @@ bool Timer::queryTopCriticalPaths(
 		std::vector<std::vector<PathHop>> &paths, 
 		const Number slackThreshold
 ) {
-	const bool debug = false;
-	
-	CriticalPathQueue queue;
-	queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(queue, mode, slackThreshold, false, -1, debug);
-	return queryTopCriticalPaths_Internal(queue, mode, maxNumPaths, paths, slackThreshold, false, -1, debug);
+	PathEnumerator enumerator = enumerateCriticalPaths(mode, slackThreshold);
+	paths.clear();
+	return enumerator.next(maxNumPaths, paths) > 0;
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -2350,48 +3178,25 @@ int Timer::queryTopCriticalPathFromTopCriticalEndpoints(
     std::vector<std::vector<PathHop>> &paths, 
     const Number slackThreshold
 ) {
+	// Select endpoints.
+	std::vector<std::tuple<Number, Rsyn::Pin>> endpoints;
+	selectCriticalEndpoints(mode, slackThreshold, maxNumEndpoints, endpoints);
 	
-	const bool debug = false;
-	
-	// Sort endpoints.
-	std::deque<std::tuple<Number, Rsyn::Pin>> sortedEndpoint;
-	
-	for (Rsyn::Pin pin : allEndpoints()) {
-		TimingPin &timingPin = getTimingPin(pin);
-		std::tuple<Number, TimingTransition> slackTransitionPair 
-				= getPinWorstSlackWithTransition(timingPin, mode);
-		
-		const Number slack = std::get<0>(slackTransitionPair);
-		if (slack < slackThreshold) {
-			sortedEndpoint.push_back(std::make_tuple(slack, pin));
-		} // end if
-	} // end for
-	
-	std::sort(sortedEndpoint.begin(), sortedEndpoint.end());
-	
-	// Generate paths.
-	const int numEndpoints = std::min((size_t) maxNumEndpoints, 
-			sortedEndpoint.size());
+	// Generate paths. Each endpoint writes to its own slot.
+	const int numEndpoints = endpoints.size();
 	
 	paths.clear();
 	paths.resize(numEndpoints);
 	
-	for (int i = 0; i < numEndpoints; i++) {
-		CriticalPathQueue queue;
-		std::vector<std::vector<PathHop>> endpointPaths;
-		
-		queryTopCriticalPaths_Queue_AddCriticalEndpoint(queue,
-				std::get<1>(sortedEndpoint[i]),
-				mode,
-				slackThreshold,
-				false,
-				-1,
-				debug);
-		
-		if (queryTopCriticalPaths_Internal(queue, mode, 1, endpointPaths, slackThreshold, false, -1, debug)) {
-			paths[i].swap(endpointPaths[0]);
+	std::shared_ptr<const Rsyn::NetlistSnapshot> snapshot =
+			design.getCachedNetlistSnapshot();
+	runInParallelDynamic(numEndpoints, [&](const int i) {
+		PathEnumerator enumerator(this, mode, slackThreshold, snapshot);
+		enumerator.addEndpoint(std::get<1>(endpoints[i]));
+		if (enumerator.next()) {
+			enumerator.getPath(paths[i]);
 		} // end if
-	} // end for
+	});
 	
 	return numEndpoints;
 } // end method
@@ -2405,54 +3210,27 @@ int Timer::queryTopCriticalPathsFromTopCriticalEndpoints(
 		std::vector<std::vector<std::vector<PathHop>>> &paths, 
 		const Number slackThreshold
 ) {
+	// Select endpoints.
+	std::vector<std::tuple<Number, Rsyn::Pin>> endpoints;
+	selectCriticalEndpoints(mode, slackThreshold, maxNumEndpoints, endpoints);
 	
-	const bool debug = false;
-	
-	// Sort endpoints.
-	std::deque<std::tuple<Number, Rsyn::Pin>> sortedEndpoint;
-	
-	for (Rsyn::Pin pin : allEndpoints()) {
-		TimingPin &timingPin = getTimingPin(pin);
-		std::tuple<Number, TimingTransition> slackTransitionPair 
-				= getPinWorstSlackWithTransition(timingPin, mode);
-		
-		const Number slack = std::get<0>(slackTransitionPair);
-		if (slack < slackThreshold) {
-			sortedEndpoint.push_back(std::make_tuple(slack, pin));
-		} // end if
-	} // end for
-	
-	std::sort(sortedEndpoint.begin(), sortedEndpoint.end());
-	
-	// Generate paths.
-	const int numEndpoints = std::min((size_t) maxNumEndpoints, 
-			sortedEndpoint.size());
+	// Generate paths. Each endpoint writes to its own slot.
+	const int numEndpoints = endpoints.size();
 	
 	paths.clear();
 	paths.resize(numEndpoints);
 	
+	std::shared_ptr<const Rsyn::NetlistSnapshot> snapshot =
+			design.getCachedNetlistSnapshot();
+	runInParallelDynamic(numEndpoints, [&](const int i) {
+		PathEnumerator enumerator(this, mode, slackThreshold, snapshot);
+		enumerator.addEndpoint(std::get<1>(endpoints[i]));
+		enumerator.next(maxNumPathsPerEndpoint, paths[i]);
+	});
+	
 	int pathCounter = 0;
 	for (int i = 0; i < numEndpoints; i++) {
-		CriticalPathQueue queue;
-		std::vector<std::vector<PathHop>> endpointPaths;
-		
-		queryTopCriticalPaths_Queue_AddCriticalEndpoint(queue,
-				std::get<1>(sortedEndpoint[i]),
-				mode,
-				slackThreshold,
-				false,
-				-1,
-				debug);
-		
-		if (queryTopCriticalPaths_Internal(queue, mode, maxNumPathsPerEndpoint, endpointPaths, slackThreshold, false, -1, debug)) {
-			const int numEndpointPaths = endpointPaths.size();
-			paths[i].resize(numEndpointPaths);
-			for (int k = 0; k < numEndpointPaths; k++) {
-				paths[i][k].swap(endpointPaths[k]);
-			} // end for
-			
-			pathCounter += numEndpointPaths;
-		} // end if
+		pathCounter += paths[i].size();
 	} // end for
 	
 	return pathCounter;
@@ -2467,18 +3245,10 @@ int Timer::queryTopCriticalPathsFromEndpoint(
 		std::vector<std::vector<PathHop>> &paths, 
 		const Number slackThreshold
 ) {
-	
-	const bool debug = false;
-	
-	CriticalPathQueue queue;
-	
-	queryTopCriticalPaths_Queue_AddCriticalEndpoint(queue, endpoint, mode, 
-			slackThreshold, false, -1, debug);
-
-	queryTopCriticalPaths_Internal(queue, mode, maxNumPaths, paths, 
-			slackThreshold, false, -1, debug);
-
-	return paths.size();
+	PathEnumerator enumerator = enumerateCriticalPathsFromEndpoint(mode,
+			endpoint, slackThreshold);
+	paths.clear();
+	return enumerator.next(maxNumPaths, paths);
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -2490,29 +3260,10 @@ int Timer::queryTopCriticalPathsPassingThruPin(
 		std::vector<std::vector<PathHop>> &paths, 
 		const Number slackThreshold
 ) {
-	const bool debug = false;
-	const int sign = generateNextSign();
-	
-	// Mark nets in the fan-in of the reference pin.
-	for (Rsyn::Net net : module.getFaninConeNetsInBreadthFirstOrder(referencePin)) {
-		getTimingNet(net).sign = sign;
-	} // end for
-	
-	// Mark nets in the fan-out of the reference pin.
-	for (Rsyn::Net net : module.getFanoutConeNetsInBreadthFirstOrder(referencePin)) {
-		getTimingNet(net).sign = sign;
-	} // end for
-	
-	// Generate paths.
-	CriticalPathQueue queue;
-	
-	queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(queue, mode, 
-			slackThreshold, true, sign, debug);
-
-	queryTopCriticalPaths_Internal(queue, mode, maxNumPaths, paths, 
-			slackThreshold, true, sign, debug);
-	
-	return paths.size();
+	PathEnumerator enumerator = enumerateCriticalPathsPassingThruPin(mode,
+			referencePin, slackThreshold);
+	paths.clear();
+	return enumerator.next(maxNumPaths, paths);
 } // end method
 
 // -----------------------------------------------------------------------------
@@ -2762,23 +3513,71 @@ std::string Timer::getPathHash(const std::vector<PathHop> &path, const bool igno
 // Endpoints
 ////////////////////////////////////////////////////////////////////////////////
 
+void Timer::selectCriticalEndpoints(
+		const TimingMode mode,
+		const Number slackThreshold,
+		const int maxNumEndpoints,
+		std::vector<std::tuple<Number, Rsyn::Pin>> &sortedEndpoints
+) {
+	sortedEndpoints.clear();
+
+	if (clsEnableTimingStateStore) {
+		if (clsTimingStateStore.isEndpointListDirty()) {
+			clsTimingStateStore.setEndpoints(design, allEndpoints());
+		} // end if
+
+		const std::vector<Index> &ids = clsTimingStateStore.allEndpointIds();
+		const std::vector<Rsyn::Pin> &pins = clsTimingStateStore.allEndpointPins();
+		const Number * riseSlacks = clsTimingStateStore.getSlacks(mode, RISE);
+		const Number * fallSlacks = clsTimingStateStore.getSlacks(mode, FALL);
+		for (int i = 0; i < (int) ids.size(); i++) {
+			const Number riseSlack = riseSlacks[ids[i]];
+			const Number fallSlack = fallSlacks[ids[i]];
+			const Number slack = riseSlack < fallSlack? riseSlack : fallSlack;
+			if (slack < slackThreshold) {
+				sortedEndpoints.push_back(std::make_tuple(slack, pins[i]));
+			} // end if
+		} // end for
+	} else {
+		for (Rsyn::Pin pin : allEndpoints()) {
+			TimingPin &timingPin = getTimingPin(pin);
+			std::tuple<Number, TimingTransition> slackTransitionPair 
+					= getPinWorstSlackWithTransition(timingPin, mode);
+
+			const Number slack = std::get<0>(slackTransitionPair);
+			if (slack < slackThreshold) {
+				sortedEndpoints.push_back(std::make_tuple(slack, pin));
+			} // end if
+		} // end for
+	} // end else
+	
+	// Partially sort the endpoints as typically only a few of them are
+	// requested.
+	if (maxNumEndpoints >= 0 && maxNumEndpoints < (int) sortedEndpoints.size()) {
+		std::nth_element(sortedEndpoints.begin(),
+				sortedEndpoints.begin() + maxNumEndpoints,
+				sortedEndpoints.end());
+		sortedEndpoints.resize(maxNumEndpoints);
+	} // end if
+	std::sort(sortedEndpoints.begin(), sortedEndpoints.end());
+} // end method
+
+// -----------------------------------------------------------------------------
+
 bool Timer::queryTopCriticalEndpoints(
 		const TimingMode mode, 
 		const int maxNumEndpoints,
 		std::vector<Rsyn::Pin> &endpoints, 
 		const Number slackThreshold
 ) {
-	const bool debug = false;
-	
-	CriticalPathQueue queue;
-	queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(queue, mode, slackThreshold, false, -1, debug);
+	std::vector<std::tuple<Number, Rsyn::Pin>> sortedEndpoints;
+	selectCriticalEndpoints(mode, slackThreshold, maxNumEndpoints, sortedEndpoints);
 	
 	endpoints.clear();
-	endpoints.reserve(maxNumEndpoints);
-	while (!queue.empty() && endpoints.size() < maxNumEndpoints) {
-		endpoints.push_back(queue.top().propPin);
-		queue.pop();
-	} // end method
+	endpoints.reserve(sortedEndpoints.size());
+	for (const std::tuple<Number, Rsyn::Pin> &endpoint : sortedEndpoints) {
+		endpoints.push_back(std::get<1>(endpoint));
+	} // end for
 	
 	return !endpoints.empty();
 } // end method
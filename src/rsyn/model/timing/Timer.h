@@ -17,12 +17,16 @@
 #define RSYN_TIMER_H_
 
 #include <cmath>
+#include <cstdint>
+#include <limits>
 #include <algorithm>
 #include <string>
 #include <map>
 #include <set>
 #include <vector>
 #include <queue>
+#include <memory>
+#include <functional>
 
 #include <ctime>
 
@@ -35,8 +39,11 @@
 #include "rsyn/util/RangeBasedLoop.h"
 #include "rsyn/util/dbu.h"
 #include "rsyn/util/FloatingPoint.h"
+#include "rsyn/util/ThreadPool.h"
 
 #include "TimingNet.h"
+#include "TimingLevelQueue.h"
+#include "TimingStateStore.h"
 #include "TimingPin.h"
 #include "TimingArc.h"
 #include "TimingLibraryCell.h"
@@ -90,8 +97,26 @@ public:
 	virtual void
 	onPostInstanceCreate(Rsyn::Instance instance) override;
 
+	virtual void
+	onPreInstanceRemove(Rsyn::Instance instance) override;
+
+	virtual void
+	onPostNetCreate(Rsyn::Net net) override;
+
+	virtual void
+	onPreNetRemove(Rsyn::Net net) override;
+
 	virtual void
 	onPostCellRemap(Rsyn::Cell cell, Rsyn::LibraryCell oldLibraryCell) override;
+
+	virtual void
+	onPostPinConnect(Rsyn::Pin pin) override;
+
+	virtual void
+	onPrePinDisconnect(Rsyn::Pin pin) override;
+
+	virtual void
+	onPostDesignEdit(const Rsyn::DesignChangeSet &changes) override;
 	
 	////////////////////////////////////////////////////////////////////////////
 	// Timing Properties
@@ -233,8 +258,120 @@ private:
 	std::set<Rsyn::Pin> floatingEndpoints;
 	std::set<Rsyn::Pin> floatingStartpoints;
 	
-	std::set<Rsyn::Net> dirtyNets;
-	std::set<Rsyn::Instance> clsDirtyTimingCells;	
+	// Nets and instances requiring timing update. Dirty flags are stored as 
+	// signatures (epochs), which are invalidated at once by incrementing the
+	// current dirty signature after a timing update.
+	std::vector<Rsyn::Net> dirtyNets;
+	std::vector<Rsyn::Instance> clsDirtyTimingCells;
+	Rsyn::Attribute<Rsyn::Instance, int> clsDirtyTimingCellSign;
+	int clsDirtySign = 1;
+
+	bool isDirtyNet(Rsyn::Net net) const {
+		return getTimingNet(net).dirtySign == clsDirtySign;
+	} // end method
+
+	void clearDirtyNetsAndInstances() {
+		dirtyNets.clear();
+		clsDirtyTimingCells.clear();
+		clsDirtySign++;
+	} // end method
+
+	// Queue used by incremental timing propagation. Kept as a member to reuse
+	// memory among timing updates.
+	TimingLevelQueue clsLevelQueue;
+
+	// Incremental propagation never levelizes the netlist as that would cost
+	// O(N) after each netlist edit. While levels are dirty, nets are ordered
+	// by their topological index instead. Levels are recomputed at the next
+	// full timing update.
+	void resetIncrementalQueue(const bool reverse) {
+		clsLevelQueue.reset(!clsNetLevelsDirty, reverse);
+	} // end method
+
+	int getIncrementalQueueKey(Rsyn::Net net, const TimingNet &timingNet, 
+			const bool reverse) const {
+		if (clsNetLevelsDirty)
+			return net.getTopologicalIndex();
+		return reverse? timingNet.reverseLevel : timingNet.level;
+	} // end method
+
+	// Optional struct-of-arrays layout of the pin timing state. When enabled,
+	// every change to the arrival, required time or slew of a pin is written
+	// thru to the store, which then backs the pin getters and the endpoint
+	// scans (WNS, TNS, critical endpoints).
+	bool clsEnableTimingStateStore = false;
+	TimingStateStore clsTimingStateStore;
+
+	bool isTimingStateStored(const Index pin) const {
+		return clsEnableTimingStateStore && pin < clsTimingStateStore.getNumPins();
+	} // end method
+
+	void updateTimingStateStore(Rsyn::Pin pin) {
+		if (clsEnableTimingStateStore) {
+			clsTimingStateStore.update(design.getId(pin), getTimingPin(pin));
+		} // end if
+	} // end method
+
+	void updateTimingStateStore(Rsyn::Net net) {
+		if (clsEnableTimingStateStore) {
+			for (Rsyn::Pin pin : net.allPins()) {
+				clsTimingStateStore.update(design.getId(pin), getTimingPin(pin));
+			} // end for
+		} // end if
+	} // end method
+
+	// Makes room for all pins so that the store is not resized while pins
+	// are updated concurrently.
+	void reserveTimingStateStore() {
+		if (clsEnableTimingStateStore) {
+			clsTimingStateStore.resize(clsPinLayer.getNumObjects());
+		} // end if
+	} // end method
+
+	// Returns the number of pins whose timing state in the store does not
+	// match their timing pins.
+	int countTimingStateStoreMismatches() const;
+
+	// Collects endpoints with worst slack smaller than the threshold and
+	// returns the maxNumEndpoints (all if negative) most critical ones sorted
+	// by increasing slack. Only the returned endpoints are sorted.
+	void selectCriticalEndpoints(const TimingMode mode, const Number slackThreshold,
+			const int maxNumEndpoints,
+			std::vector<std::tuple<Number, Rsyn::Pin>> &endpoints);
+
+	////////////////////////////////////////////////////////////////////////////
+	// Multi-Threading
+	////////////////////////////////////////////////////////////////////////////
+
+	// Minimum number of nets assigned to a task. Levels with fewer nets than
+	// twice this value are processed by the calling thread.
+	static const int PARALLEL_MIN_NETS_PER_TASK;
+
+	int clsNumThreads = 1;
+	std::unique_ptr<ThreadPool> clsThreadPool;
+
+	// Nets grouped by topological level. A net in level i only depends on nets
+	// in levels smaller than i, so nets in the same level can be processed
+	// concurrently.
+	std::vector<std::vector<Rsyn::Net>> clsNetLevels;
+
+	// Same as above, but for backward propagation (required times and
+	// centralities). Level i only depends on levels smaller than i.
+	std::vector<std::vector<Rsyn::Net>> clsReverseNetLevels;
+
+	// Levels are only recomputed when the netlist changes.
+	bool clsNetLevelsDirty = true;
+
+	// Splits [0, numItems) in chunks and runs the task for each chunk using
+	// the thread pool. Returns only after all chunks were processed.
+	void runInParallel(const int numItems,
+			const std::function<void(const int begin, const int end)> &task);
+
+	// Calls task(i) for all i in [0, numItems) using the thread pool, if any.
+	// Items are handed out one at a time, in order, to the next idle thread,
+	// which suits items with very different costs (e.g. tracing paths).
+	void runInParallelDynamic(const int numItems,
+			const std::function<void(const int i)> &task);
 	
 	void timingBuildTimingArcs_SetupBacktrackEdge(
 			TimingArc &arc, 
@@ -253,9 +390,14 @@ private:
 
 	void updateTiming_HandleFloatingPins();
 	
+	// Group nets into topological levels. Does nothing if the netlist has not
+	// changed since the last call.
+	void updateTiming_Levelize();
+
 	// Propagate arrival times.
 	void updateTiming_PropagateArrivalTimes();
-	void updateTiming_PropagateArrivalTimesIncremental(std::set<Rsyn::Net> &endpoints);		
+	void updateTiming_PropagateArrivalTimesParallel();
+	void updateTiming_PropagateArrivalTimesIncremental(std::vector<Rsyn::Net> &endpoints);		
 	
 	// Update requited time at endpoints.
 	void updateTiming_UpdateTimingTests_SetupHold_DataPin(Rsyn::Pin pin);
@@ -267,12 +409,14 @@ private:
 	// Propagate required times.
 	void updateTiming_PropagateRequiredTimes_Net(Rsyn::Net net);
 	void updateTiming_PropagateRequiredTimes();
-	void updateTiming_PropagateRequiredTimesIncremental(const std::set<Rsyn::Net> &nets);
+	void updateTiming_PropagateRequiredTimesParallel();
+	void updateTiming_PropagateRequiredTimesIncremental(const std::vector<Rsyn::Net> &nets);
 
 	// Propagate endpoint's criticalities to compute centralities.
-	void updateTiming_Centrality_Net(Rsyn::Net net);
+	void updateTiming_Centrality_Net(Rsyn::Net net, Number maxCentrality[NUM_TIMING_MODES]);
 	void updateTiming_Centrality();
-	void updateTiming_CentralityIncremental(const std::set<Rsyn::Net> &nets);
+	void updateTiming_CentralityParallel();
+	void updateTiming_CentralityIncremental(const std::vector<Rsyn::Net> &nets);
 	
 	// Update the sorted list of critical endpoints.
 	void updateTiming_CriticalEndpoints();
@@ -491,6 +635,44 @@ public:
 		clsForceFullTimingUpdate = true;
 	} // end method
 
+	//! @brief Sets the number of threads used during full timing updates. If
+	//!        set to one (default), the timing is propagated serially.
+	//! @note  The parallel propagation computes exactly the same timing as
+	//!        the serial one.
+	void setNumThreads(const int numThreads);
+
+	//! @brief Returns the number of threads used during full timing updates.
+	int getNumThreads() const { return clsNumThreads; }
+
+	//! @brief Enables or disables the struct-of-arrays timing state store.
+	//!        When enabled, pin arrival, required time, slew and slack
+	//!        getters and the endpoint scans read contiguous per mode and
+	//!        transition arrays indexed by pin id.
+	void setTimingStateStoreEnabled(const bool enable);
+
+	//! @brief Returns true if the struct-of-arrays timing state store is
+	//!        enabled.
+	bool isTimingStateStoreEnabled() const { return clsEnableTimingStateStore; }
+
+	//! @brief Returns the struct-of-arrays timing state store. Empty if the
+	//!        store is disabled.
+	const TimingStateStore &getTimingStateStore() const {
+		return clsTimingStateStore;
+	} // end method
+
+	//! @brief Measures the throughput of read-only netlist traversals (fanout
+	//!        cone visit in topological order) using the object API and the
+	//!        netlist snapshot.
+	void benchmarkNetlistSnapshot(const int numIterations);
+
+	//! @brief Regression check for incremental timing. Randomly remaps cells,
+	//!        alternating between batches of edits done directly and inside
+	//!        an edit transaction, and after each batch compares the
+	//!        incremental timing (endpoint slacks, WNS and TNS) against a full
+	//!        timing update. Returns the number of mismatches.
+	int checkIncrementalTiming(const int numSteps, const unsigned seed,
+			const Number tolerance);
+
 	//! @brief Sets the input driver delay mode.
 	void setInputDriverDelayMode(const InputDriverDelayMode mode) {
 		inputDriverDelayMode = mode;
@@ -503,14 +685,26 @@ public:
 	//! @note  Changes observed via Rsyn::Design do not need to be notified as
 	//!        the timer already handle that internally. A typical change that
 	//!        the timer is unaware of is a placement change.
-	void dirtyInstance(Rsyn::Instance instance) { clsDirtyTimingCells.insert(instance); }
+	void dirtyInstance(Rsyn::Instance instance) {
+		int &sign = clsDirtyTimingCellSign[instance];
+		if (sign != clsDirtySign) {
+			sign = clsDirtySign;
+			clsDirtyTimingCells.push_back(instance);
+		} // end if
+	} // end method
 	
 	//! @brief Notifies the timer about a change in a net.
 	//! @note  If you mark an instance as dirty automatically all nets connected
 	//!        to it are marked as dirty, so no need to notify the timer again.
 	//!        A typical change that must be notified to the timer is layer
 	//!        promotion.
-	void dirtyNet(Rsyn::Net net) { dirtyNets.insert(net); }
+	void dirtyNet(Rsyn::Net net) {
+		TimingNet &timingNet = getTimingNet(net);
+		if (timingNet.dirtySign != clsDirtySign) {
+			timingNet.dirtySign = clsDirtySign;
+			dirtyNets.push_back(net);
+		} // end if
+	} // end method
 	
 	//! @brief Performs a full timing update.
 	//! @note  Usually this is not necessary as the timer keeps track of each
@@ -582,6 +776,9 @@ public:
 
 	//! @brief Returns the arrival time at a timing pin.
 	Number getPinArrivalTime(Rsyn::Pin pin, const TimingMode mode, const TimingTransition transition) const {
+		const Index id = design.getId(pin);
+		if (isTimingStateStored(id))
+			return clsTimingStateStore.getArrival(id, mode, transition);
 		return getPinArrivalTime(getTimingPin(pin), mode, transition);
 	} // end method
 
@@ -600,6 +797,9 @@ public:
 
 	//! @brief Returns the required time at this pin.
 	Number getPinRequiredTime(Rsyn::Pin pin, const TimingMode mode, const TimingTransition transition) const {
+		const Index id = design.getId(pin);
+		if (isTimingStateStored(id))
+			return clsTimingStateStore.getRequired(id, mode, transition);
 		return getPinRequiredTime(getTimingPin(pin), mode, transition);
 	} // end method
 
@@ -611,6 +811,9 @@ public:
 
 	//! @brief Returns the slack at a pin.
 	Number getPinSlack(Rsyn::Pin pin, const TimingMode mode, const TimingTransition transition) const {
+		const Index id = design.getId(pin);
+		if (isTimingStateStored(id))
+			return clsTimingStateStore.getSlack(id, mode, transition);
 		return getTimingPin(pin).getSlack(mode, transition);
 	} // end method
 
@@ -641,6 +844,9 @@ public:
 
 	//! @brief Returns the slew at a pin.
 	Number getPinSlew(Rsyn::Pin pin, const TimingMode mode, const TimingTransition transition) const {
+		const Index id = design.getId(pin);
+		if (isTimingStateStored(id))
+			return clsTimingStateStore.getSlew(id, mode, transition);
 		return getPinSlew(getTimingPin(pin), mode, transition);
 	} // end method	
 
@@ -695,6 +901,14 @@ public:
 	//!        at a pin.
 	std::tuple<Number, TimingTransition> 
 	getPinWorstSlackWithTransition(Rsyn::Pin pin, const TimingMode mode) const {
+		const Index id = design.getId(pin);
+		if (isTimingStateStored(id)) {
+			const Number riseSlack = clsTimingStateStore.getSlack(id, mode, RISE);
+			const Number fallSlack = clsTimingStateStore.getSlack(id, mode, FALL);
+			return (riseSlack < fallSlack)?
+				std::make_tuple(riseSlack, RISE) :
+				std::make_tuple(fallSlack, FALL);
+		} // end if
 		const TimingPin &timingPin = getTimingPin(pin);
 		return getPinWorstSlackWithTransition(timingPin, mode);
 	} // end method	
@@ -1482,95 +1696,128 @@ public:
 		Rsyn::Arc getArcToThisPin() const { return rsynArcToThisPin; }
 	}; // end class	
 	
-private:
+	//! @brief Enumerates critical paths lazily by increasing slack. Paths are
+	//!        found by a best-first backward search from the endpoints, which
+	//!        is suspended after each path, so requesting more paths resumes
+	//!        the search instead of restarting it. Partial paths are stored
+	//!        as compact hops (pin, parent hop and fan-in arc slot) and a
+	//!        path is only converted to PathHop objects by getPath().
+	//!        Fan-in arcs are read from the netlist snapshot if it is up to
+	//!        date, otherwise from the pins themselves, so enumerating paths
+	//!        after a netlist edit does not rebuild the snapshot.
+	//! @note  An enumerator must not be used after the timing or the netlist
+	//!        changes.
+	class PathEnumerator {
+	friend class Timer;
+	public:
 
-	// Helper structure used to generate critical paths.
-	struct Reference {
-		Rsyn::Pin propPin;
-		TimingArc * propArcPointerFromThisPin;
-		Rsyn::Arc propRsynArcFromThisPin;
-		TimingTransition propTransition;
-		Number propRequired;
-		int propParentPartialPath;
-		TimingTransition propTransitionAtParent;
-		
-		// This is not the actual slack in the current path. This is computed
-		// using the path required (maybe different from the worst required seen
-		// at this pin) and the worst arrival time.
-		// The actual slack in this path will be computed later during the 
-		// backtracking.
-		Number propSlack; 
-		
-		// Constructor.
-		Reference() :
-			propPin(nullptr),
-			propArcPointerFromThisPin(nullptr),
-			propRsynArcFromThisPin(nullptr),
-			propRequired(std::numeric_limits<Number>::quiet_NaN()),
-			propSlack(std::numeric_limits<Number>::quiet_NaN()),
-			propParentPartialPath(-1),
-			propTransition(Rsyn::TIMING_TRANSITION_INVALID)
-		{}
-		
-		Reference(Rsyn::Pin pin, 
-				TimingArc * arc,
-				Rsyn::Arc rsynArc,
-				const Number required,
-				const Number slack, 
+		//! @brief Moves to the next path. Returns false if there is no other
+		//!        path with slack less than the threshold.
+		bool next();
+
+		//! @brief Appends up to maxNumPaths next paths (all if maxNumPaths
+		//!        <= 0) to the vector. Returns the number of paths appended.
+		int next(const int maxNumPaths, std::vector<std::vector<PathHop>> &paths);
+
+		//! @brief Returns the slack of the current path.
+		Number getSlack() const { return clsCurrentSlack; }
+
+		//! @brief Returns the startpoint of the current path.
+		Rsyn::Pin getStartpoint() const;
+
+		//! @brief Returns the endpoint of the current path.
+		Rsyn::Pin getEndpoint() const;
+
+		//! @brief Returns the current path.
+		void getPath(std::vector<PathHop> &path) const;
+
+		//! @brief Returns the number of paths enumerated so far.
+		int getNumPaths() const { return clsNumPaths; }
+
+		TimingMode getTimingMode() const { return clsMode; }
+
+	private:
+
+		// A hop of a partial path. The arc slot is the position of the arc
+		// from this pin in the fan-in arcs of the parent pin.
+		struct Hop {
+			Rsyn::Pin propPin;
+			Rsyn::Pin propEndpoint;
+			int propParent;
+			Number propRequired;
+			std::uint16_t propArcSlot;
+			std::int8_t propTransition;
+			std::int8_t propTransitionAtParent;
+		}; // end struct
+
+		static const std::uint16_t NO_ARC = std::numeric_limits<std::uint16_t>::max();
+
+		// This is not necessarily the actual slack of the path, but a lower
+		// bound computed using the path required time and the worst arrival
+		// time at the hop pin. The actual slack is known when the startpoint
+		// is reached. Ties are broken by the hop index.
+		struct Entry {
+			Number propSlack;
+			int propHop;
+
+			bool operator>(const Entry &rhs) const {
+				return propSlack > rhs.propSlack ||
+						(propSlack == rhs.propSlack && propHop > rhs.propHop);
+			} // end method
+		}; // end struct
+
+		Timer * clsTimer = nullptr;
+		TimingMode clsMode;
+		Number clsSlackThreshold = 0;
+		// Null if the netlist snapshot was outdated when the enumerator was
+		// created.
+		std::shared_ptr<const Rsyn::NetlistSnapshot> clsSnapshot;
+
+		std::vector<Hop> clsHops;
+		std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> clsQueue;
+
+		// Nets that paths may go thru indexed by net id. Empty if there is no
+		// restriction.
+		std::vector<char> clsAllowedNets;
+
+		int clsCurrent = -1;
+		Number clsCurrentSlack = 0;
+		int clsNumPaths = 0;
+
+		PathEnumerator(Timer * timer, const TimingMode mode,
+				const Number slackThreshold,
+				std::shared_ptr<const Rsyn::NetlistSnapshot> snapshot);
+
+		bool isAllowed(Rsyn::Pin pin) const;
+		void allowNet(Rsyn::Net net);
+		Rsyn::Arc getFaninArc(Rsyn::Pin pin, const int slot) const;
+		void addEndpoint(Rsyn::Pin endpoint);
+		void addAllEndpoints();
+		void push(Rsyn::Pin pin, Rsyn::Pin endpoint, const int parent,
+				const Number required, const std::uint16_t arcSlot,
 				const TimingTransition transition,
-				const int parent,
-				const TimingTransition transitionAtParent) :
-				
-				propPin(pin),
-				propArcPointerFromThisPin(arc),
-				propRsynArcFromThisPin(rsynArc),
-				propRequired(required),
-				propSlack(slack),
-				propTransition(transition),
-				propParentPartialPath(parent),
-				propTransitionAtParent(transitionAtParent) {}
-					
-		bool operator>(const Reference &rhs) const {
-			return (propSlack > rhs.propSlack);
-		} // end if
-		
-		void print(const std::string &caption, ostream &out, Rsyn::Design design) const {
-			out << caption << ": "
-				<< propPin.getFullName() << " "
-				<< "q=" << propRequired << " "
-				<< "slack=" << propSlack << " "
-				<< "transition=" << (propTransition==RISE?"rise" : "fall") << " "
-				<< "parent=" << propParentPartialPath << " "
-				<< "parent_transition=" << propTransitionAtParent << "\n";			
-		} // end operator
-	}; // end struct    
-	
-	typedef std::priority_queue<
-		Reference, std::deque<Reference>, std::greater<Reference>> CriticalPathQueue;
-	
-	void queryTopCriticalPaths_Queue_AddCriticalEndpoint(CriticalPathQueue &queue,
-			Rsyn::Pin endpoint,
+				const TimingTransition transitionAtParent);
+	}; // end class
+
+	//! @brief Returns an enumerator of the critical paths with slack less
+	//!        than slackThreshold.
+	PathEnumerator enumerateCriticalPaths(
 			const TimingMode mode,
-			const Number slackThreshold,
-			const bool checkSign,
-			const int sign,			
-			const bool debug);
+			const Number slackThreshold = 0);
 
-	void queryTopCriticalPaths_Queue_AddAllCriticalEndpoints(CriticalPathQueue &queue,
+	//! @brief Returns an enumerator of the critical paths ending at a given
+	//!        endpoint.
+	PathEnumerator enumerateCriticalPathsFromEndpoint(
 			const TimingMode mode,
-			const Number slackThreshold,
-			const bool checkSign,
-			const int sign,
-			const bool debug);
-	
-	bool queryTopCriticalPaths_Internal(CriticalPathQueue &queue,
-			const TimingMode mode, 
-			const int maxNumPaths,
-			std::vector<std::vector<PathHop>> &paths, 
-			const Number slackThreshold,
-			const bool checkSign,
-			const int sign,
-			const bool debug);
+			const Rsyn::Pin endpoint,
+			const Number slackThreshold = 0);
+
+	//! @brief Returns an enumerator of the critical paths passing thru nets
+	//!        in the fan-in or fan-out cone of a pin.
+	PathEnumerator enumerateCriticalPathsPassingThruPin(
+			const TimingMode mode,
+			const Rsyn::Pin referencePin,
+			const Number slackThreshold = 0);
 
 public:
 
@@ -1607,6 +1854,8 @@ public:
 	//! @brief Returns one critical path per endpoint. The path from the most
 	//!        critical endpoint is at index 0. Returns the number of paths
 	//!        found.
+	//! @note  Endpoints are traced concurrently if the timer uses multiple
+	//!        threads. The result does not depend on the number of threads.
 	int queryTopCriticalPathFromTopCriticalEndpoints(
 			const TimingMode mode, 
 			const int maxNumEndpoints,
@@ -1619,6 +1868,8 @@ public:
 	//!        criticality. That is, the top most critical path is at index
 	//!        [0][0] and the top 3 critical path of top 5 endpoint is at index
 	//!        [4][2]. Returns the number of paths found.
+	//! @note  Endpoints are traced concurrently if the timer uses multiple
+	//!        threads. The result does not depend on the number of threads.
 	int queryTopCriticalPathsFromTopCriticalEndpoints(
 		const TimingMode mode, 
 		const int maxNumEndpoints,
@@ -0,0 +1,129 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_TIMING_LEVEL_QUEUE_H
+#define RSYN_TIMING_LEVEL_QUEUE_H
+
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include "rsyn/core/Rsyn.h"
+
+namespace Rsyn {
+
+// A monotone priority queue of nets bucketed by topological level. Nets are
+// popped in non-decreasing level order. Pushing a net to a level smaller than
+// the level currently being popped puts it in the current level.
+//
+// Levels are only valid while the netlist does not change. After netlist
+// edits, and until nets are levelized again, the queue can be switched to a
+// heap keyed by the net topological indexes (see reset()), which are kept up
+// to date by the netlist.
+//
+// The queue does not prevent duplicates, this must be handled by the caller
+// (e.g. via signatures). Bucket memory is kept between uses to avoid
+// reallocations in incremental timing updates.
+
+class TimingLevelQueue {
+public:
+
+	//! @brief Removes all nets and sets how keys are interpreted. If
+	//! useLevels is true, keys are levels. Otherwise keys are topological
+	//! indexes and nets are popped in increasing order (or decreasing order,
+	//! if reverse is true).
+	void reset(const bool useLevels, const bool reverse) {
+		clear();
+		clsUseLevels = useLevels;
+		clsReverse = reverse;
+	} // end method
+
+	//! @brief Adds a net with the given key (see reset()).
+	void push(const int key, Rsyn::Net net) {
+		if (!clsUseLevels) {
+			clsHeap.push_back(std::make_pair(clsReverse ? -key : key, net));
+			std::push_heap(clsHeap.begin(), clsHeap.end(), std::greater<HeapEntry>());
+			clsSize++;
+			return;
+		} // end if
+
+		const int bucket = std::max(key, clsCurrentLevel);
+		if (bucket >= (int) clsBuckets.size()) {
+			clsBuckets.resize(bucket + 1);
+		} // end if
+		clsBuckets[bucket].push_back(net);
+		clsSize++;
+	} // end method
+
+	//! @brief Removes and returns a net with the lowest key in the queue.
+	//! @note  The queue must not be empty.
+	Rsyn::Net pop() {
+		if (!clsUseLevels) {
+			std::pop_heap(clsHeap.begin(), clsHeap.end(), std::greater<HeapEntry>());
+			Rsyn::Net net = clsHeap.back().second;
+			clsHeap.pop_back();
+			clsSize--;
+			return net;
+		} // end if
+
+		while (clsCurrentIndex >= (int) clsBuckets[clsCurrentLevel].size()) {
+			clsBuckets[clsCurrentLevel].clear();
+			clsCurrentLevel++;
+			clsCurrentIndex = 0;
+		} // end while
+		clsSize--;
+
+		Rsyn::Net net = clsBuckets[clsCurrentLevel][clsCurrentIndex++];
+		if (clsSize == 0) {
+			clear();
+		} // end if
+		return net;
+	} // end method
+
+	//! @brief Returns true if there are no nets in the queue.
+	bool empty() const { return clsSize == 0; }
+
+	//! @brief Returns the number of nets in the queue.
+	int size() const { return clsSize; }
+
+	//! @brief Removes all nets from the queue.
+	void clear() {
+		for (int i = clsCurrentLevel; i < (int) clsBuckets.size(); i++) {
+			clsBuckets[i].clear();
+		} // end for
+		clsHeap.clear();
+		clsCurrentLevel = 0;
+		clsCurrentIndex = 0;
+		clsSize = 0;
+	} // end method
+
+private:
+
+	typedef std::pair<int, Rsyn::Net> HeapEntry;
+
+	std::vector<std::vector<Rsyn::Net>> clsBuckets;
+	std::vector<HeapEntry> clsHeap;
+	int clsCurrentLevel = 0;
+	int clsCurrentIndex = 0;
+	int clsSize = 0;
+	bool clsUseLevels = true;
+	bool clsReverse = false;
+
+}; // end class
+
+} // end namespace
+
+#endif
@@ -47,6 +47,17 @@ struct TimingNet {
 	// it was not propagated, therefore we should not prune. So we need a flag 
 	// to avoid pruning in such cases.
 	bool dirty;
+
+	// Signatures used as epoch flags to indicate that the net was marked as
+	// dirty or was already pushed to the propagation queue. The flag is set
+	// if the signature matches the respective timer signature.
+	int dirtySign;
+	int queueSign;
+
+	// Topological levels for arrival (level) and required time (reverseLevel)
+	// propagation. See Timer::updateTiming_Levelize().
+	int level;
+	int reverseLevel;
 	
 	// State
 	TimingNetState state[NUM_TIMING_MODES];
@@ -55,6 +66,10 @@ struct TimingNet {
 	TimingNet() {
 		sign = 0;
 		dirty = false;
+		dirtySign = 0;
+		queueSign = 0;
+		level = 0;
+		reverseLevel = 0;
 	} // end constructor
 	
 }; // end struct
@@ -0,0 +1,199 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_TIMING_STATE_STORE_H
+#define RSYN_TIMING_STATE_STORE_H
+
+#include <vector>
+#include <set>
+#include <algorithm>
+
+#include "rsyn/core/Rsyn.h"
+#include "rsyn/model/timing/types.h"
+#include "rsyn/model/timing/TimingPin.h"
+
+namespace Rsyn {
+
+// Struct-of-arrays layout of the pin timing state indexed by pin id. Arrival,
+// required time, slew and slack are stored in one contiguous array per timing
+// mode and transition, so scans touching a few fields of many pins (e.g. WNS
+// and TNS over the endpoints) stream through memory instead of loading whole
+// timing pins.
+//
+// The timer writes thru the store whenever it changes the arrival, required
+// time or slew of a pin, so the store always matches the timing pins. Rows of
+// pins that were never written hold the default timing pin state (zeros).
+
+class TimingStateStore {
+public:
+
+	//! @brief Removes all rows and endpoints.
+	void clear() {
+		clsNumPins = 0;
+		for (int mode = 0; mode < NUM_TIMING_MODES; mode++) {
+			for (int edge = 0; edge < NUM_EDGE_TYPES; edge++) {
+				clsArrival[mode][edge].clear();
+				clsRequired[mode][edge].clear();
+				clsSlew[mode][edge].clear();
+				clsSlack[mode][edge].clear();
+			} // end for
+		} // end for
+		clsEndpointIds.clear();
+		clsEndpointPins.clear();
+		clsEndpointsDirty = true;
+	} // end method
+
+	//! @brief Makes room for pins with id smaller than numPins. Never shrinks.
+	//! @note  Must be called before pins are updated concurrently as update()
+	//!        is not thread-safe when it needs to grow the arrays.
+	void resize(const Index numPins) {
+		if (numPins <= clsNumPins)
+			return;
+		clsNumPins = numPins;
+		for (int mode = 0; mode < NUM_TIMING_MODES; mode++) {
+			for (int edge = 0; edge < NUM_EDGE_TYPES; edge++) {
+				clsArrival[mode][edge].resize(numPins, 0);
+				clsRequired[mode][edge].resize(numPins, 0);
+				clsSlew[mode][edge].resize(numPins, 0);
+				clsSlack[mode][edge].resize(numPins, 0);
+			} // end for
+		} // end for
+	} // end method
+
+	//! @brief Returns the number of rows, i.e. pins with id smaller than this
+	//!        value are stored.
+	Index getNumPins() const { return clsNumPins; }
+
+	//! @brief Copies the timing state of a pin to its row.
+	void update(const Index pin, const TimingPin &timingPin) {
+		if (pin >= clsNumPins) {
+			resize(std::max(pin + 1, 2 * clsNumPins));
+		} // end if
+
+		for (int mode = 0; mode < NUM_TIMING_MODES; mode++) {
+			const TimingPinState &state = timingPin.state[mode];
+			for (int edge = 0; edge < NUM_EDGE_TYPES; edge++) {
+				clsArrival[mode][edge][pin] = state.a[edge];
+				clsRequired[mode][edge][pin] = state.q[edge];
+				clsSlew[mode][edge][pin] = state.slew[edge];
+				clsSlack[mode][edge][pin] = timingPin.getSlack(
+						(TimingMode) mode, (TimingTransition) edge);
+			} // end for
+		} // end for
+	} // end method
+
+	//! @brief Returns true if the row of a pin matches its timing pin.
+	bool matches(const Index pin, const TimingPin &timingPin) const {
+		if (pin >= clsNumPins)
+			return false;
+
+		for (int mode = 0; mode < NUM_TIMING_MODES; mode++) {
+			const TimingPinState &state = timingPin.state[mode];
+			for (int edge = 0; edge < NUM_EDGE_TYPES; edge++) {
+				if (clsArrival[mode][edge][pin] != state.a[edge] ||
+						clsRequired[mode][edge][pin] != state.q[edge] ||
+						clsSlew[mode][edge][pin] != state.slew[edge] ||
+						clsSlack[mode][edge][pin] != timingPin.getSlack(
+								(TimingMode) mode, (TimingTransition) edge))
+					return false;
+			} // end for
+		} // end for
+		return true;
+	} // end method
+
+	Number getArrival(const Index pin, const TimingMode mode, const TimingTransition edge) const {
+		return clsArrival[mode][edge][pin];
+	} // end method
+
+	Number getRequired(const Index pin, const TimingMode mode, const TimingTransition edge) const {
+		return clsRequired[mode][edge][pin];
+	} // end method
+
+	Number getSlew(const Index pin, const TimingMode mode, const TimingTransition edge) const {
+		return clsSlew[mode][edge][pin];
+	} // end method
+
+	Number getSlack(const Index pin, const TimingMode mode, const TimingTransition edge) const {
+		return clsSlack[mode][edge][pin];
+	} // end method
+
+	//! @brief Returns a pointer to the contiguous array of arrival times.
+	const Number *getArrivals(const TimingMode mode, const TimingTransition edge) const {
+		return clsArrival[mode][edge].data();
+	} // end method
+
+	//! @brief Returns a pointer to the contiguous array of required times.
+	const Number *getRequireds(const TimingMode mode, const TimingTransition edge) const {
+		return clsRequired[mode][edge].data();
+	} // end method
+
+	//! @brief Returns a pointer to the contiguous array of slews.
+	const Number *getSlews(const TimingMode mode, const TimingTransition edge) const {
+		return clsSlew[mode][edge].data();
+	} // end method
+
+	//! @brief Returns a pointer to the contiguous array of slacks.
+	const Number *getSlacks(const TimingMode mode, const TimingTransition edge) const {
+		return clsSlack[mode][edge].data();
+	} // end method
+
+	////////////////////////////////////////////////////////////////////////////
+	// Endpoints
+	////////////////////////////////////////////////////////////////////////////
+
+	//! @brief Marks the endpoint list as outdated.
+	void invalidateEndpoints() { clsEndpointsDirty = true; }
+
+	//! @brief Returns true if the endpoint list needs to be set again.
+	bool isEndpointListDirty() const { return clsEndpointsDirty; }
+
+	//! @brief Sets the endpoints. Pins are kept in the set order, which is
+	//!        the order of their ids, so endpoint scans visit the arrays
+	//!        front to back.
+	void setEndpoints(Rsyn::Design design, const std::set<Rsyn::Pin> &endpoints) {
+		clsEndpointIds.clear();
+		clsEndpointPins.clear();
+		clsEndpointIds.reserve(endpoints.size());
+		clsEndpointPins.reserve(endpoints.size());
+		for (Rsyn::Pin pin : endpoints) {
+			clsEndpointIds.push_back(design.getId(pin));
+			clsEndpointPins.push_back(pin);
+		} // end for
+		clsEndpointsDirty = false;
+	} // end method
+
+	//! @brief Returns the ids of the endpoints.
+	const std::vector<Index> &allEndpointIds() const { return clsEndpointIds; }
+
+	//! @brief Returns the endpoints in the same order as allEndpointIds().
+	const std::vector<Rsyn::Pin> &allEndpointPins() const { return clsEndpointPins; }
+
+private:
+
+	Index clsNumPins = 0;
+	std::vector<Number> clsArrival[NUM_TIMING_MODES][NUM_EDGE_TYPES];
+	std::vector<Number> clsRequired[NUM_TIMING_MODES][NUM_EDGE_TYPES];
+	std::vector<Number> clsSlew[NUM_TIMING_MODES][NUM_EDGE_TYPES];
+	std::vector<Number> clsSlack[NUM_TIMING_MODES][NUM_EDGE_TYPES];
+
+	std::vector<Index> clsEndpointIds;
+	std::vector<Rsyn::Pin> clsEndpointPins;
+	bool clsEndpointsDirty = true;
+
+}; // end class
+
+} // end namespace
+
+#endif
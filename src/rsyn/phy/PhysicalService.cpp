@@ -22,7 +22,15 @@ void PhysicalService::start(const Rsyn::Json &params) {
 	Rsyn::Session session;
 	
 	clsDesign = session.getDesign();
-	clsPhysicalDesign.initPhysicalDesign(clsDesign, params);
+
+	// Snapshots may be enabled for the whole session, e.g. via "set
+	// enableSnapshots true" before loading the design.
+	Rsyn::Json physicalDesignParams = params;
+	if (physicalDesignParams.is_null() || !physicalDesignParams.count("clsEnableSnapshots")) {
+		physicalDesignParams["clsEnableSnapshots"] =
+				session.getSessionVariableAsBool("enableSnapshots", false);
+	} // end if
+	clsPhysicalDesign.initPhysicalDesign(clsDesign, physicalDesignParams);
 	// Observe changes in the design.
 	clsDesign.registerObserver(this);
 } // end method
@@ -114,4 +122,25 @@ void PhysicalService::onPostInstanceCreate(Rsyn::Instance instance) {
 	DBU area = width * height;
 	data->clsTotalAreas[PHYSICAL_MOVABLE] += area;
 } // end method
+
+// -----------------------------------------------------------------------------
+
+void PhysicalService::onPostDesignEdit(const Rsyn::DesignChangeSet &changes) {
+	PhysicalDesignData *data = clsPhysicalDesign.data;
+
+	// Instances that already have physical data were loaded during the edit
+	// (e.g. when the DEF is streamed) and are skipped. Remaps are handled
+	// first, so that cells created in the edit are initialized with their
+	// final library cell.
+	for (const std::tuple<Rsyn::Cell, Rsyn::LibraryCell> &remap : changes.remappedCells) {
+		Rsyn::Cell cell = std::get<0>(remap);
+		if (data->clsPhysicalInstances[cell].clsInstance)
+			onPostCellRemap(cell, std::get<1>(remap));
+	} // end for
+
+	for (Rsyn::Instance instance : changes.createdInstances) {
+		if (!data->clsPhysicalInstances[instance].clsInstance)
+			onPostInstanceCreate(instance);
+	} // end for
+} // end method
 } // end namespace
\ No newline at end of file
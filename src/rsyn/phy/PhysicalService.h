@@ -53,6 +53,9 @@ public:
 	
 	virtual void 
 	onPostInstanceCreate(Rsyn::Instance instance) override;
+
+	virtual void
+	onPostDesignEdit(const Rsyn::DesignChangeSet &changes) override;
 }; // end class
 
 } // end namespace
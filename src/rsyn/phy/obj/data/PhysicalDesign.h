@@ -66,6 +66,12 @@ public:
 
 	Rsyn::PhysicalDieData clsPhysicalDie; // total area of the circuit including core bound. 
 
+	// Descriptors of the loaded technology libraries and of the design sections
+	// that are not stored elsewhere (e.g. vias, special nets, regions). They
+	// are only kept when snapshots are enabled (clsEnableSnapshots).
+	std::vector<LefDscp> clsLibraryDscps;
+	DefDscp clsStaticDesignDscp;
+
 	DBU clsTotalAreas[NUM_PHYSICAL_TYPES];
 	int clsNumElements[NUM_PHYSICAL_TYPES];
 	int clsNumLayers[NUM_PHY_LAYER];
@@ -77,6 +83,7 @@ public:
 	bool clsEnablePhysicalPins : 1;
 	bool clsEnableMergeRectangles : 1;
 	bool clsEnableNetPinBoundaries : 1;
+	bool clsEnableSnapshots : 1;
 
 	Rsyn::Net clsClkNet;
 
@@ -102,6 +109,7 @@ public:
 		clsEnablePhysicalPins = false;
 		clsEnableMergeRectangles = false;
 		clsEnableNetPinBoundaries = false;
+		clsEnableSnapshots = false;
 		for (int index = 0; index < NUM_DBU; index++) {
 			clsDBUs[index] = 0;
 		} // end for 
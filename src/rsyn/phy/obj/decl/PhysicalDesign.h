@@ -72,16 +72,26 @@ public:
 	//! @param	design is a DefDscp reference to the descriptor of the design inspired in DEF architecture.
 	void loadDesign(const DefDscp & design);
 
+	//! @brief	loading a batch of DEF components to the PhysicalDesign. The cells must have been already created in Rsyn::Design.
+	//! @details	Used when the DEF is streamed (components are not kept in the DefDscp passed to loadDesign). 
+	//! It may be called before or after loadDesign. 
+	//! @param	components is a reference to the component descriptors inspired in DEF architecture.
+	void loadDesignComponents(const std::vector<DefComponentDscp> & components);
+
 	//! @brief	Initializes the Rsyn::PhysicalDesignData, the attributes to the Rsyn::Design elements and control parameters.
 	//! @param	Json &params may be: 1) "clsEnablePhysicalPins" true enables Rsyn::PhysicalPin, 
 	//! 2) "clsEnableMergeRectangles" true enables merging rectangle bounds to be merged. It does not work to bounds defined as polygon, and 
 	//! 3) "clsEnableNetPinBoundaries" true enables storing the pins (Rsyn::Pin) that defines the Bound box boundaries of the nets.
 	//! 4) "clsContestMode" {NONE, ICCAD15} enables legacy support to the contest benchmark.
+	//! 5) "clsEnableSnapshots" true keeps the library and design descriptors required to write snapshots.
 	void initPhysicalDesign(Rsyn::Design dsg, const Json &params = {});
 
 	//! @brief	Setting the net clock. Otherwise, it is defined as nullptr.
 	void setClockNet(Rsyn::Net net);
 
+	//! @brief	Returns the net clock set by setClockNet(). Otherwise, it returns nullptr.
+	Rsyn::Net getClockNet() const;
+
 	//! @brief	Updating the Bound Box of all design nets. 
 	//! @param	skipClockNet default is value false. Otherwise, the Bound Box of the clock network is skipped to update and is not added to total HPWL.
 	void updateAllNetBounds(const bool skipClockNet = false);
@@ -136,6 +146,19 @@ public:
 	//! is irrelevant to store the pins that defined the boundaries of the bound box of the net. 
 	//! It will only consume memory and runtime.
 	bool isEnableNetPinBoundaries() const;
+	//! @brief Returns true if the descriptors required to write snapshots are kept. Otherwise, it returns false.
+	//! @details The descriptors are a copy of the LEF libraries and of a few DEF sections. 
+	//! They are only useful to save the physical design and would otherwise only consume memory.
+	bool isEnableSnapshots() const;
+
+	//! @brief Returns the descriptors of the technology libraries loaded by loadLibrary().
+	//! @warning Empty unless snapshots were enabled (see isEnableSnapshots()).
+	const std::vector<LefDscp> &getLibraryDescriptors() const;
+	//! @brief Returns the sections of the design loaded by loadDesign() that are not stored in Rsyn::PhysicalDesign objects.
+	//! @details Header data, vias, special nets, regions and groups. 
+	//! Everything else (e.g. rows, tracks, ports, components, nets) is rebuilt from the current design when saving it.
+	//! @warning Empty unless snapshots were enabled (see isEnableSnapshots()).
+	const DefDscp &getStaticDesignDescriptor() const;
 
 	//! @brief Rsyn::PhysicalLibraryPin related to the Rsyn::LibraryPin libPin.
 	Rsyn::PhysicalLibraryPin getPhysicalLibraryPin(Rsyn::LibraryPin libPin) const;
@@ -287,6 +310,8 @@ protected:
 	//! @brief TODO
 	void addPhysicalTrack(const DefTrackDscp &track);
 	void addPhysicalDesignVia(const DefViaDscp & via);
+	//! @brief Keeps a copy of the design sections that are not stored in Rsyn::Design.
+	void storeStaticDesignDescriptor(const DefDscp & design);
 	//! @brief initializes the Rsyn::PhysicalSpacing objects into Rsyn::PhysicalDesign.
 	void addPhysicalSpacing(const LefSpacingDscp & spacing);
 	//! @brief initializes the Rsyn::PhysicalPin objects into Rsyn::PhysicalDesign.
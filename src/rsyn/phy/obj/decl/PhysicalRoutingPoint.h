@@ -53,6 +53,7 @@ public:
 	DBU getPosition(const Dimension dim) const;
 	DBU getExtension() const;
 	Rsyn::PhysicalVia getVia() const;
+	PhysicalOrientation getOrientation() const;
 	
 	/*! @details
 	 "RECT ( deltax1 deltay1 deltax2 deltay2 )
@@ -41,6 +41,9 @@ public:
 	//! @brief Returns physical layer object related to wire
 	Rsyn::PhysicalLayer getLayer() const;
 
+	//! @brief Returns true if the segment starts a new wire path (DEF NEW statement).
+	bool isNew() const;
+
 	//! @brief Returns number of points in segment (clsPoints.size())
 	const std::size_t getNumRoutingPoints() const;
 	const std::vector<PhysicalRoutingPoint> & allRoutingPoints() const;
@@ -49,6 +49,9 @@ void PhysicalDesign::loadLibrary(const LefDscp & library) {
 		} // end if-else
 	} // end if 
 
+	if (data->clsEnableSnapshots)
+		data->clsLibraryDscps.push_back(library);
+
 	// Initializing physical sites
 	data->clsPhysicalSites.reserve(library.clsLefSiteDscps.size());
 	for (const LefSiteDscp & lefSite : library.clsLefSiteDscps) {
@@ -108,6 +111,9 @@ void PhysicalDesign::loadDesign(const DefDscp & design) {
 	// LEF/DEF specifications prohibit division that results in a real number factor.
 	data->clsDBUs[MULT_FACTOR_DBU] = getDatabaseUnits(LIBRARY_DBU) / getDatabaseUnits(DESIGN_DBU);
 
+	if (data->clsEnableSnapshots)
+		storeStaticDesignDescriptor(design);
+
 	// Adding design defined vias
 	std::size_t numVias = data->clsPhysicalVias.size() + design.clsVias.size();
 	data->clsPhysicalVias.reserve(numVias);
@@ -115,14 +121,7 @@ void PhysicalDesign::loadDesign(const DefDscp & design) {
 		addPhysicalDesignVia(via);
 
 	// initializing physical cells (DEF Components)
-	for (const DefComponentDscp & component : design.clsComps) {
-		// Adding Physical cell to Physical Layer
-		Rsyn::Cell cell = data->clsDesign.findCellByName(component.clsName);
-		if (!cell) {
-			throw Exception("Cell " + component.clsName + " not found.\n");
-		} // end if
-		addPhysicalCell(cell, component);
-	} // end for
+	loadDesignComponents(design.clsComps);
 
 	// Initializing circuit ports
 	for (const DefPortDscp & pin_port : design.clsPorts) {
@@ -171,6 +170,33 @@ void PhysicalDesign::loadDesign(const DefDscp & design) {
 
 // -----------------------------------------------------------------------------
 
+void PhysicalDesign::storeStaticDesignDescriptor(const DefDscp & design) {
+	DefDscp & dscp = data->clsStaticDesignDscp;
+	dscp.clsVersion = design.clsVersion;
+	dscp.clsDeviderChar = design.clsDeviderChar;
+	dscp.clsBusBitChars = design.clsBusBitChars;
+	dscp.clsDesignName = design.clsDesignName;
+	dscp.clsRegions = design.clsRegions;
+	dscp.clsGroups = design.clsGroups;
+	dscp.clsSpecialNets = design.clsSpecialNets;
+	dscp.clsVias = design.clsVias;
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+void PhysicalDesign::loadDesignComponents(const std::vector<DefComponentDscp> & components) {
+	for (const DefComponentDscp & component : components) {
+		// Adding Physical cell to Physical Layer
+		Rsyn::Cell cell = data->clsDesign.findCellByName(component.clsName);
+		if (!cell) {
+			throw Exception("Cell " + component.clsName + " not found.\n");
+		} // end if
+		addPhysicalCell(cell, component);
+	} // end for
+} // end method 
+
+// -----------------------------------------------------------------------------
+
 void PhysicalDesign::initPhysicalDesign(Rsyn::Design dsg, const Json &params) {
 	if (data) {
 		std::cout << "ERROR: design already set.\nSkipping initialize Physical Design\n";
@@ -182,6 +208,7 @@ void PhysicalDesign::initPhysicalDesign(Rsyn::Design dsg, const Json &params) {
 		data->clsEnablePhysicalPins = params.value("clsEnablePhysicalPins", data->clsEnablePhysicalPins);
 		data->clsEnableMergeRectangles = params.value("clsEnableMergeRectangles", data->clsEnableMergeRectangles);
 		data->clsEnableNetPinBoundaries = params.value("clsEnableNetPinBoundaries", data->clsEnableNetPinBoundaries);
+		data->clsEnableSnapshots = params.value("clsEnableSnapshots", data->clsEnableSnapshots);
 		data->clsMode = getPhysicalDesignModeType(params.value("clsPhysicalDesignMode", "ALL"));
 	} // end if 
 
@@ -29,6 +29,12 @@ inline void PhysicalDesign::setClockNet(Rsyn::Net net) {
 
 // -----------------------------------------------------------------------------
 
+inline Rsyn::Net PhysicalDesign::getClockNet() const {
+	return data->clsClkNet;
+} // end method 
+
+// -----------------------------------------------------------------------------
+
 inline DBU PhysicalDesign::getDatabaseUnits(const DBUType type) const {
 	return data->clsDBUs[type];
 } // end method  
@@ -77,6 +83,24 @@ inline bool PhysicalDesign::isEnableNetPinBoundaries() const {
 
 // -----------------------------------------------------------------------------
 
+inline bool PhysicalDesign::isEnableSnapshots() const {
+	return data->clsEnableSnapshots;
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline const std::vector<LefDscp> &PhysicalDesign::getLibraryDescriptors() const {
+	return data->clsLibraryDscps;
+} // end method 
+
+// -----------------------------------------------------------------------------
+
+inline const DefDscp &PhysicalDesign::getStaticDesignDescriptor() const {
+	return data->clsStaticDesignDscp;
+} // end method 
+
+// -----------------------------------------------------------------------------
+
 inline void PhysicalDesign::addPhysicalPin() {
 	std::cout << "TODO " << __func__ << "\n";
 } // end method 
@@ -54,6 +54,12 @@ inline Rsyn::PhysicalVia PhysicalRoutingPoint::getVia() const {
 
 // -----------------------------------------------------------------------------
 
+inline PhysicalOrientation PhysicalRoutingPoint::getOrientation() const {
+	return data->clsOrientation;
+} // end method 
+
+// -----------------------------------------------------------------------------
+
 inline const Bounds & PhysicalRoutingPoint::getRectangle() const {
 	return data->clsRectangle;
 } // end method 
@@ -41,6 +41,12 @@ inline Rsyn::PhysicalLayer PhysicalWireSegment::getLayer() const {
 
 // -----------------------------------------------------------------------------
 
+inline bool PhysicalWireSegment::isNew() const {
+	return data->clsNew;
+} // end method 
+
+// -----------------------------------------------------------------------------
+
 inline const std::size_t PhysicalWireSegment::getNumRoutingPoints() const {
 	return data->clsRoutingPoints.size();
 } // end method 
@@ -66,6 +66,11 @@ void Session::init() {
 	// Register some commands.
 	registerDefaultCommands();
 
+	// Back the large netlist lists with huge pages if requested. This must be
+	// set before the design is created.
+	Rsyn::ListArena::setHugePagesEnabled(
+			Environment::getBoolean( "ENABLE_HUGE_PAGES", false ));
+
 	// Create design.
 	sessionData->clsDesign.create("__Root_Design__");
 
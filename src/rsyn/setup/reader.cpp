@@ -30,6 +30,7 @@
 #include "rsyn/io/reader/ICCAD17Reader.h"
 #include "rsyn/io/reader/GenericReader.h"
 #include "rsyn/io/reader/ISPD2018Reader.h"
+#include "rsyn/io/reader/SnapshotReader.h"
 
 // Registration
 namespace Rsyn {
@@ -43,5 +44,6 @@ void Session::registerReaders() {
 	registerReader<Rsyn::DesignPositionReader>("loadDesignPosition");
 	registerReader<Rsyn::GenericReader>("generic");
 	registerReader<Rsyn::ISPD2018Reader>("ispd18");
+	registerReader<Rsyn::SnapshotReader>("snapshot");
 } // end method
 } // end namespace
\ No newline at end of file
@@ -0,0 +1,118 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_BINARY_STREAM_H
+#define RSYN_BINARY_STREAM_H
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <type_traits>
+
+#include "rsyn/util/Exception.h"
+
+namespace Rsyn {
+
+// Minimal helpers to write and read binary files (e.g. caches and snapshots).
+// Values are stored in the native byte order, so files are meant to be read
+// back on the same kind of machine. Strings are stored as a 64-bit length
+// followed by their characters.
+
+class BinaryWriter {
+public:
+
+	BinaryWriter(std::ostream &out) : clsOut(out) {}
+
+	template<typename T>
+	void write(const T &value) {
+		static_assert(std::is_trivially_copyable<T>::value,
+				"Only trivially copyable types can be written directly.");
+		clsOut.write((const char *) &value, sizeof(T));
+	} // end method
+
+	void write(const std::string &value) {
+		write((std::uint64_t) value.size());
+		clsOut.write(value.data(), value.size());
+	} // end method
+
+	void writeBytes(const void *data, const std::size_t size) {
+		clsOut.write((const char *) data, size);
+	} // end method
+
+	bool good() const { return clsOut.good(); }
+
+private:
+
+	std::ostream &clsOut;
+}; // end class
+
+// -----------------------------------------------------------------------------
+
+// Reads from a memory region, typically a memory-mapped file (see
+// MappedFile). Reading past the end of the region throws an exception.
+
+class BinaryReader {
+public:
+
+	BinaryReader(const char *begin, const char *end) :
+		clsCurrent(begin), clsEnd(end) {}
+
+	template<typename T>
+	void read(T &value) {
+		static_assert(std::is_trivially_copyable<T>::value,
+				"Only trivially copyable types can be read directly.");
+		std::memcpy(&value, advance(sizeof(T)), sizeof(T));
+	} // end method
+
+	void read(std::string &value) {
+		std::uint64_t size;
+		read(size);
+		const char *data = advance((std::size_t) size);
+		value.assign(data, (std::size_t) size);
+	} // end method
+
+	template<typename T>
+	T read() {
+		T value;
+		read(value);
+		return value;
+	} // end method
+
+	// Returns a pointer to the next size bytes and skips them.
+	const char *readBytes(const std::size_t size) {
+		return advance(size);
+	} // end method
+
+	std::size_t getRemainingSize() const { return clsEnd - clsCurrent; }
+	bool atEnd() const { return clsCurrent == clsEnd; }
+
+private:
+
+	const char *clsCurrent;
+	const char *clsEnd;
+
+	const char *advance(const std::size_t size) {
+		if (size > (std::size_t) (clsEnd - clsCurrent))
+			throw Exception("Unexpected end of binary data.");
+		const char *data = clsCurrent;
+		clsCurrent += size;
+		return data;
+	} // end method
+}; // end class
+
+} // end namespace
+
+#endif
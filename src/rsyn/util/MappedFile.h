@@ -0,0 +1,127 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_MAPPED_FILE_H
+#define RSYN_MAPPED_FILE_H
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Rsyn {
+
+// Read-only view of the contents of a file. On Linux the file is memory
+// mapped, so that its pages are loaded on demand and shared with the page
+// cache. Elsewhere, or if mapping fails, the file is read into memory.
+
+class MappedFile {
+public:
+
+	MappedFile() = default;
+
+	MappedFile(const std::string &filename) {
+		open(filename);
+	} // end constructor
+
+	~MappedFile() {
+		close();
+	} // end destructor
+
+	MappedFile(const MappedFile &) = delete;
+	MappedFile &operator=(const MappedFile &) = delete;
+
+	// Returns false if the file could not be opened.
+	bool open(const std::string &filename) {
+		close();
+
+#ifdef __linux__
+		const int fd = ::open(filename.c_str(), O_RDONLY);
+		if (fd < 0)
+			return false;
+
+		struct stat info;
+		if (fstat(fd, &info) == 0) {
+			clsSize = (std::size_t) info.st_size;
+			if (clsSize == 0) {
+				::close(fd);
+				clsOpen = true;
+				return true;
+			} // end if
+
+			void *address = mmap(nullptr, clsSize, PROT_READ, MAP_PRIVATE, fd, 0);
+			if (address != MAP_FAILED) {
+				madvise(address, clsSize, MADV_SEQUENTIAL);
+				::close(fd);
+				clsData = (const char *) address;
+				clsMapped = true;
+				clsOpen = true;
+				return true;
+			} // end if
+		} // end if
+		::close(fd);
+#endif
+
+		std::ifstream file(filename, std::ios::binary);
+		if (!file)
+			return false;
+		file.seekg(0, std::ios::end);
+		clsBuffer.resize((std::size_t) file.tellg());
+		file.seekg(0, std::ios::beg);
+		file.read(clsBuffer.data(), clsBuffer.size());
+		clsData = clsBuffer.data();
+		clsSize = clsBuffer.size();
+		clsOpen = true;
+		return true;
+	} // end method
+
+	void close() {
+#ifdef __linux__
+		if (clsMapped)
+			munmap((void *) clsData, clsSize);
+#endif
+		std::vector<char>().swap(clsBuffer);
+		clsData = nullptr;
+		clsSize = 0;
+		clsMapped = false;
+		clsOpen = false;
+	} // end method
+
+	bool isOpen() const { return clsOpen; }
+	bool isMapped() const { return clsMapped; }
+
+	const char *begin() const { return clsData; }
+	const char *end() const { return clsData + clsSize; }
+	std::size_t getSize() const { return clsSize; }
+
+private:
+
+	const char *clsData = nullptr;
+	std::size_t clsSize = 0;
+	std::vector<char> clsBuffer;
+	bool clsMapped = false;
+	bool clsOpen = false;
+}; // end class
+
+} // end namespace
+
+#endif
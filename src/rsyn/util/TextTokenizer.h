@@ -0,0 +1,256 @@
+/* Copyright 2014-2017 Rsyn
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RSYN_TEXT_TOKENIZER_H
+#define RSYN_TEXT_TOKENIZER_H
+
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "rsyn/util/MappedFile.h"
+
+namespace Rsyn {
+
+// Non-owning reference to a sequence of characters (e.g. a token inside a
+// memory-mapped file). It is only valid while the referenced memory is.
+
+class StringRef {
+public:
+
+	StringRef() = default;
+	StringRef(const char *data, const std::size_t size) :
+		clsData(data), clsSize(size) {}
+
+	const char *data() const { return clsData; }
+	std::size_t size() const { return clsSize; }
+	bool empty() const { return clsSize == 0; }
+
+	const char *begin() const { return clsData; }
+	const char *end() const { return clsData + clsSize; }
+
+	char operator[](const std::size_t index) const { return clsData[index]; }
+	char front() const { return clsData[0]; }
+
+	std::string str() const { return std::string(clsData, clsSize); }
+
+	bool operator==(const StringRef &other) const {
+		return clsSize == other.clsSize &&
+				std::memcmp(clsData, other.clsData, clsSize) == 0;
+	} // end method
+
+	bool operator==(const char *other) const {
+		return std::strncmp(clsData, other, clsSize) == 0 &&
+				other[clsSize] == '\0';
+	} // end method
+
+	bool operator==(const std::string &other) const {
+		return clsSize == other.size() &&
+				std::memcmp(clsData, other.data(), clsSize) == 0;
+	} // end method
+
+	template<typename T>
+	bool operator!=(const T &other) const { return !(*this == other); }
+
+	friend std::ostream &operator<<(std::ostream &out, const StringRef &ref) {
+		return out.write(ref.clsData, ref.clsSize);
+	} // end method
+
+private:
+
+	const char *clsData = nullptr;
+	std::size_t clsSize = 0;
+}; // end class
+
+// -----------------------------------------------------------------------------
+
+// Line-oriented tokenizer over a memory-mapped text file. Tokens are returned
+// as references into the mapping, so no string is allocated while scanning
+// the file. Tokens are separated by white spaces. Optionally, a set of
+// special characters can also separate tokens and, if requested, be returned
+// as single-character tokens.
+
+class TextTokenizer {
+public:
+
+	TextTokenizer() {
+		setSpecialChars("", false);
+	} // end constructor
+
+	// Returns false if the file could not be opened.
+	bool open(const std::string &filename) {
+		clsLineNumber = 0;
+		if (!clsFile.open(filename)) {
+			clsCurrent = clsEnd = nullptr;
+			return false;
+		} // end if
+		clsCurrent = clsFile.begin();
+		clsEnd = clsFile.end();
+		return true;
+	} // end method
+
+	void close() {
+		clsFile.close();
+		clsCurrent = clsEnd = nullptr;
+	} // end method
+
+	bool isOpen() const { return clsFile.isOpen(); }
+	bool atEnd() const { return clsCurrent == clsEnd; }
+
+	// Number of the last line read, starting at 1.
+	int getLineNumber() const { return clsLineNumber; }
+
+	// Size of the file in bytes.
+	std::size_t getSize() const { return clsFile.getSize(); }
+
+	void setSpecialChars(const char *chars, const bool returnSpecialChars) {
+		for (int c = 0; c < 256; c++) {
+			clsCharTypes[c] = std::isspace(c) ? CHAR_SPACE : CHAR_REGULAR;
+		} // end for
+		for (const char *c = chars; *c; c++) {
+			clsCharTypes[(unsigned char) *c] =
+					returnSpecialChars ? CHAR_SPECIAL : CHAR_SPACE;
+		} // end for
+	} // end method
+
+	// Reads the next line without the line break (and without a trailing
+	// '\r'). Returns false at the end of the file.
+	bool nextLine(StringRef &line) {
+		if (clsCurrent == clsEnd)
+			return false;
+
+		const char *begin = clsCurrent;
+		const char *end = (const char *) std::memchr(begin, '\n', clsEnd - begin);
+		if (end) {
+			clsCurrent = end + 1;
+		} else {
+			end = clsEnd;
+			clsCurrent = clsEnd;
+		} // end else
+		if (end != begin && end[-1] == '\r')
+			end--;
+
+		clsLineNumber++;
+		line = StringRef(begin, end - begin);
+		return true;
+	} // end method
+
+	// Reads the next line and splits it into tokens. Returns false at the end
+	// of the file. The line may have no tokens.
+	bool nextLine(std::vector<StringRef> &tokens) {
+		StringRef line;
+		tokens.clear();
+		if (!nextLine(line))
+			return false;
+		split(line, tokens);
+		return true;
+	} // end method
+
+	// Reads lines until one with at least one token is found. Returns false
+	// if the end of the file is reached before that.
+	bool nextNonEmptyLine(std::vector<StringRef> &tokens) {
+		while (nextLine(tokens)) {
+			if (!tokens.empty())
+				return true;
+		} // end while
+		return false;
+	} // end method
+
+	void split(const StringRef &line, std::vector<StringRef> &tokens) const {
+		const char *p = line.begin();
+		const char *end = line.end();
+		while (p != end) {
+			const int type = clsCharTypes[(unsigned char) *p];
+			if (type == CHAR_SPACE) {
+				p++;
+			} else if (type == CHAR_SPECIAL) {
+				tokens.push_back(StringRef(p, 1));
+				p++;
+			} else {
+				const char *begin = p;
+				while (p != end && clsCharTypes[(unsigned char) *p] == CHAR_REGULAR)
+					p++;
+				tokens.push_back(StringRef(begin, p - begin));
+			} // end else
+		} // end while
+	} // end method
+
+	// Number conversion. As with the stream operators, conversion stops at
+	// the first invalid character and fails only if no character is valid.
+	// Tokens are not null terminated, so they are copied to a local buffer
+	// before calling the C conversion functions.
+
+	static bool toInt(const StringRef &token, int &value) {
+		char buffer[NUMBER_BUFFER_SIZE];
+		if (!copyNumber(token, buffer))
+			return false;
+		char *end;
+		const long result = std::strtol(buffer, &end, 10);
+		if (end == buffer)
+			return false;
+		value = (int) result;
+		return true;
+	} // end method
+
+	static bool toDouble(const StringRef &token, double &value) {
+		char buffer[NUMBER_BUFFER_SIZE];
+		if (!copyNumber(token, buffer))
+			return false;
+		char *end;
+		const double result = std::strtod(buffer, &end);
+		if (end == buffer)
+			return false;
+		value = result;
+		return true;
+	} // end method
+
+	// Same as atof(), returns zero if the token is not a number.
+	static double toDouble(const StringRef &token) {
+		double value = 0;
+		toDouble(token, value);
+		return value;
+	} // end method
+
+private:
+
+	enum CharType {
+		CHAR_REGULAR,
+		CHAR_SPACE,
+		CHAR_SPECIAL
+	}; // end enum
+
+	static const std::size_t NUMBER_BUFFER_SIZE = 64;
+
+	MappedFile clsFile;
+	const char *clsCurrent = nullptr;
+	const char *clsEnd = nullptr;
+	int clsLineNumber = 0;
+	unsigned char clsCharTypes[256];
+
+	static bool copyNumber(const StringRef &token, char *buffer) {
+		if (token.empty() || token.size() >= NUMBER_BUFFER_SIZE)
+			return false;
+		std::memcpy(buffer, token.data(), token.size());
+		buffer[token.size()] = '\0';
+		return true;
+	} // end method
+}; // end class
+
+} // end namespace
+
+#endif
@@ -45,6 +45,7 @@
 //
 ////////////////////////////////////////////////////////////////////////////////
 
+#include <atomic>
 #include <vector>
 #include <queue>
 #include <memory>
@@ -128,12 +129,20 @@ inline void ThreadPool::startWorkers(const std::size_t numThreads) {
 						return;
 					task = std::move(tasks.front());
 					tasks.pop();
+
+					// Must be incremented while holding the lock, otherwise
+					// wait() may see an empty queue and no running tasks
+					// before this task actually starts.
+					running++;
 				} // end block
 
-				running++;
 				task();
-				running--;
-				condition_wait_task.notify_one();
+
+				{ // mutual exclusion block
+					std::unique_lock<std::mutex> lock(queue_mutex);
+					running--;
+				} // end block
+				condition_wait_task.notify_all();
 			} // end while
 		});
 	} // end method	
@@ -177,7 +186,7 @@ void ThreadPool::addTask(F&& f, Args&&... args) {
 
 inline void ThreadPool::wait() {
 	std::unique_lock<std::mutex> lock(queue_mutex);
-	condition_wait_task.wait(lock, [this] {return running == 0;});		
+	condition_wait_task.wait(lock, [this] {return tasks.empty() && running == 0;});		
 } // end method
 
 // -----------------------------------------------------------------------------